@@ -192,12 +192,11 @@ AccessHandleCollection<T, IndexRange, Traits>::_setup_local_uses(
     || !"_setup_local_uses() called on AccessHandleCollection with unmapped Use"
   );
 
-  auto local_idxs = my_use->get_managed_collection()->local_indices_for(mapped_backend_index_);
   auto const& idx_range = get_index_range();
 
   auto map_dense = base_t::index_range_traits_t::mapping_to_dense(idx_range);
 
-  for (auto&& idx : local_idxs) {
+  auto setup_local_use = [&](std::size_t idx) {
 
     auto fe_idx = base_t::mapping_to_dense_traits_t::map_backward(
       map_dense, idx, idx_range
@@ -263,7 +262,14 @@ AccessHandleCollection<T, IndexRange, Traits>::_setup_local_uses(
 
     }
 
-  } // end loop over local idxs
+  }; // end setup_local_use
+
+  my_use->get_managed_collection()->for_each_local_index_interval(
+    mapped_backend_index_,
+    [&](std::size_t begin, std::size_t end) {
+      for(auto idx = begin; idx < end; ++idx) setup_local_use(idx);
+    }
+  );
 
 }
 
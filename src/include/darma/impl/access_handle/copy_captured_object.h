@@ -45,6 +45,8 @@
 #ifndef DARMAFRONTEND_IMPL_ACCESS_HANDLE_COPY_CAPTURED_OBJECT_H
 #define DARMAFRONTEND_IMPL_ACCESS_HANDLE_COPY_CAPTURED_OBJECT_H
 
+#include <darma/impl/feature_testing_macros.h>
+
 #include <darma/impl/access_handle/copy_captured_object_fwd.h>
 #include <darma/impl/task/task_base.h>
 
@@ -66,19 +68,32 @@ class CopyCapturedObject {
     Derived const* prev_copied_from_ = nullptr;
     CaptureManager* capturing_task = nullptr;
 
-    void
-    _handle_lambda_compute_size(Derived const& copied_from) {
+    #if _darma_has_feature(task_migration)
+    static std::size_t
+    _get_captured_packed_size(void const* captured) {
       auto ar = serialization_handler_t::make_sizing_archive();
-      compute_size(copied_from, ar);
-      capturing_task->lambda_serdes_computed_size += serialization_handler_t::get_size(ar);
+      compute_size(*static_cast<Derived const*>(captured), ar);
+      return serialization_handler_t::get_size(ar);
     }
 
+    static void
+    _pack_captured(void const* captured, char*& buffer) {
+      auto ptr_ar = ptr_serialization_handler_t::make_packing_archive(buffer);
+      pack(*static_cast<Derived const*>(captured), ptr_ar);
+    }
+    #endif // _darma_has_feature(task_migration)
+
     void
-    _handle_lambda_pack(Derived const& copied_from) {
-      auto ptr_ar = ptr_serialization_handler_t::make_packing_archive(
-        capturing_task->lambda_serdes_buffer
-      );
-      pack(copied_from, ptr_ar);
+    _record_for_lambda_serdes() {
+      #if _darma_has_feature(task_migration)
+      // Record where this object lives so that the task can size and pack it
+      // directly when it migrates, rather than copying the whole closure
+      capturing_task->captured_objects_for_serdes.push_back({
+        static_cast<Derived const*>(this),
+        &_get_captured_packed_size,
+        &_pack_captured
+      });
+      #endif // _darma_has_feature(task_migration)
     }
 
     void
@@ -88,6 +103,7 @@ class CopyCapturedObject {
       );
       static_cast<Derived*>(this)->template unpack_from_archive(ptr_ar);
       static_cast<Derived*>(this)->template report_dependency(capturing_task);
+      _record_for_lambda_serdes();
     }
 
     void
@@ -98,12 +114,6 @@ class CopyCapturedObject {
         // if we're unpacking, don't even pass the object so we don't make a mistake
         _handle_lambda_unpack();
       }
-      else if(capturing_task->lambda_serdes_mode == CaptureManager::SerializerMode::Sizing) {
-        _handle_lambda_compute_size(copied_from);
-      }
-      else if(capturing_task->lambda_serdes_mode == CaptureManager::SerializerMode::Packing) {
-        _handle_lambda_pack(copied_from);
-      }
     }
 
   protected:
@@ -193,6 +203,8 @@ class CopyCapturedObject {
         source_ptr, capturing_task
       );
 
+      _record_for_lambda_serdes();
+
       return {
         /* did_capture = */ true,
         /* argument_is_garbage = */ false,
@@ -101,6 +101,9 @@ struct _publish_impl {
     dets.token_ = this_.other_private_members_.task_collection_token();
     #endif // _darma_has_feature(task_collection_token)
 
+    TraceSpan trace_span(abstract::frontend::TraceEventKind::Publish);
+    trace_span.set_name(this_.var_handle_base_->get_key());
+
     auto publish_use_holder = make_captured_use_holder(
       this_.var_handle_base_,
       frontend::Permissions::None,
@@ -48,6 +48,10 @@
 #include <darma/interface/frontend/array_concept_manager.h>
 #include <darma/impl/util/smart_pointers.h>
 
+#include <type_traits>
+
+#include <darma/impl/meta/is_iterable.h>
+
 #include "indexable.h"
 
 namespace darma {
@@ -61,6 +65,63 @@ class ArrayConceptManagerForType
 
     using _idx_traits = IndexingTraits<T>;
 
+    // Contiguous slices of types that decompose into views of bytewise
+    // copyable elements are handed out as (non-owning) ViewElementRanges
+    using _use_view_range_t = std::integral_constant<bool,
+      _idx_traits::has_view_subsets
+      and _idx_traits::has_contiguous_trivially_copyable_elements
+    >;
+
+    types::unique_ptr_template<abstract::frontend::ElementRange>
+    _make_element_range(
+      std::true_type /* view */, T const& obj, size_t offset, size_t n_elem
+    ) const;
+
+    types::unique_ptr_template<abstract::frontend::ElementRange>
+    _make_element_range(
+      std::false_type /* view */, T const& obj, size_t offset, size_t n_elem
+    ) const;
+
+    bool
+    _set_from_view(
+      std::true_type /* view */, T& obj,
+      abstract::frontend::ElementRange const& range,
+      size_t offset, size_t size
+    ) const;
+
+    bool
+    _set_from_view(
+      std::false_type /* view */, T&,
+      abstract::frontend::ElementRange const&,
+      size_t, size_t
+    ) const {
+      return false;
+    }
+
+    // Non-contiguous selections are gathered into a new T, which must then be
+    // constructible from an iterator range
+    using _can_gather_t = std::integral_constant<bool,
+      meta::iterable_traits<T>::has_iterator_constructor
+    >;
+
+    types::unique_ptr_template<abstract::frontend::ElementRange>
+    _make_gathered_range(
+      std::true_type, T const& obj,
+      abstract::frontend::ElementIndexRange const& idx_range
+    ) const;
+
+    types::unique_ptr_template<abstract::frontend::ElementRange>
+    _make_gathered_range(
+      std::false_type, T const&,
+      abstract::frontend::ElementIndexRange const&
+    ) const {
+      DARMA_ASSERT_NOT_IMPLEMENTED(
+        "non-contiguous element ranges of types that can't be constructed"
+        " from an iterator range"
+      );
+      return nullptr; // unreachable
+    }
+
   public:
 
     size_t
@@ -74,23 +135,25 @@ class ArrayConceptManagerForType
       size_t offset, size_t n_elem
     ) const override;
 
+    types::unique_ptr_template<abstract::frontend::ElementRange>
+    get_element_range(
+      void const* obj,
+      abstract::frontend::IndexRange const* idx_range
+    ) const override;
+
+    void
+    set_element_range(
+      void* obj,
+      abstract::frontend::ElementRange const& range,
+      abstract::frontend::IndexRange const* idx_range
+    ) const override;
+
     void
     set_element_range(
       void* obj,
       abstract::frontend::ElementRange const& range,
       size_t offset, size_t size
-    ) const override {
-      void const* sub_object =
-        static_cast<ElementRangeT const&>(range).get_buffer();
-
-      _idx_traits::set_element_range(
-        *static_cast<T*>(obj),
-        *static_cast<typename _idx_traits::subset_object_type const*>(
-          sub_object
-        ),
-        offset, size
-      );
-    }
+    ) const override;
 
 
 };
@@ -45,6 +45,8 @@
 #ifndef DARMA_IMPL_ARRAY_CONCEPT_IMPL_H
 #define DARMA_IMPL_ARRAY_CONCEPT_IMPL_H
 
+#include <cstring>
+
 #include "concept.h"
 #include "element_range.h"
 
@@ -56,14 +58,149 @@ types::unique_ptr_template<abstract::frontend::ElementRange>
 ArrayConceptManagerForType<T, ElementRangeT>::get_element_range(
   void const* obj,
   size_t offset, size_t n_elem
+) const {
+  return _make_element_range(_use_view_range_t{},
+    *static_cast<T const*>(obj), offset, n_elem
+  );
+}
+
+template <typename T, typename ElementRangeT>
+types::unique_ptr_template<abstract::frontend::ElementRange>
+ArrayConceptManagerForType<T, ElementRangeT>::_make_element_range(
+  std::true_type /* view */, T const& obj, size_t offset, size_t n_elem
+) const {
+  types::unique_ptr_template<abstract::frontend::ElementRange> rv =
+    detail::make_unique<ViewElementRange<T>>(obj, offset, n_elem);
+  return rv;
+}
+
+template <typename T, typename ElementRangeT>
+types::unique_ptr_template<abstract::frontend::ElementRange>
+ArrayConceptManagerForType<T, ElementRangeT>::_make_element_range(
+  std::false_type /* view */, T const& obj, size_t offset, size_t n_elem
+) const {
+  types::unique_ptr_template<abstract::frontend::ElementRange> rv =
+    detail::make_unique<ElementRangeT>(obj, offset, n_elem);
+  return rv;
+}
+
+template <typename T, typename ElementRangeT>
+void
+ArrayConceptManagerForType<T, ElementRangeT>::set_element_range(
+  void* obj,
+  abstract::frontend::ElementRange const& range,
+  size_t offset, size_t size
+) const {
+  auto& dest = *static_cast<T*>(obj);
+  if(_set_from_view(_use_view_range_t{}, dest, range, offset, size)) return;
+
+  // Otherwise, range holds a T (e.g., one that was unpacked)
+  void const* sub_object =
+    static_cast<ElementRangeT const&>(range).get_buffer();
+
+  typename _idx_traits::decomposition{}.set_element_range(
+    dest, *static_cast<T const*>(sub_object), offset, size
+  );
+}
+
+template <typename T, typename ElementRangeT>
+bool
+ArrayConceptManagerForType<T, ElementRangeT>::_set_from_view(
+  std::true_type /* view */, T& obj,
+  abstract::frontend::ElementRange const& range,
+  size_t offset, size_t size
+) const {
+  using element_t = std::remove_cv_t<typename _idx_traits::element_type>;
+  auto const* view_range = dynamic_cast<ViewElementRange<T> const*>(&range);
+  if(view_range == nullptr) return false;
+
+  DARMA_ASSERT_EQUAL(
+    view_range->get_contiguous_data_size(), size * sizeof(element_t)
+  );
+  DARMA_ASSERT_RELATED_VERBOSE(
+    offset + size, <=, _idx_traits::n_elements(obj)
+  );
+  auto const* src = static_cast<element_t const*>(
+    view_range->get_contiguous_data()
+  );
+  auto* dest = obj.data() + offset;
+  // nothing to do if the view is of the destination itself
+  if(src != dest) {
+    std::memmove(dest, src, size * sizeof(element_t));
+  }
+  return true;
+}
+
+template <typename T, typename ElementRangeT>
+types::unique_ptr_template<abstract::frontend::ElementRange>
+ArrayConceptManagerForType<T, ElementRangeT>::get_element_range(
+  void const* obj,
+  abstract::frontend::IndexRange const* idx_range
+) const {
+  auto const& elem_idx_range = as_element_index_range(idx_range);
+  size_t offset = 0, n_elem = 0;
+  if(is_contiguous_element_selection(elem_idx_range, offset, n_elem)) {
+    return get_element_range(obj, offset, n_elem);
+  }
+  return _make_gathered_range(_can_gather_t{},
+    *static_cast<T const*>(obj), elem_idx_range
+  );
+}
+
+template <typename T, typename ElementRangeT>
+types::unique_ptr_template<abstract::frontend::ElementRange>
+ArrayConceptManagerForType<T, ElementRangeT>::_make_gathered_range(
+  std::true_type, T const& obj,
+  abstract::frontend::ElementIndexRange const& idx_range
 ) const {
   types::unique_ptr_template<abstract::frontend::ElementRange> rv =
-    detail::make_unique<ElementRangeT>(
-      *static_cast<T const*>(obj), offset, n_elem
-    );
+    detail::make_unique<GatheredElementRange<T>>(obj, idx_range);
   return rv;
 }
 
+template <typename T, typename ElementRangeT>
+void
+ArrayConceptManagerForType<T, ElementRangeT>::set_element_range(
+  void* obj,
+  abstract::frontend::ElementRange const& range,
+  abstract::frontend::IndexRange const* idx_range
+) const {
+  auto const& elem_idx_range = as_element_index_range(idx_range);
+  size_t offset = 0, n_elem = 0;
+  if(is_contiguous_element_selection(elem_idx_range, offset, n_elem)) {
+    set_element_range(obj, range, offset, n_elem);
+    return;
+  }
+  // Otherwise, range is either one we made in get_element_range() above or
+  // (e.g., on the receiving side) an ElementRangeT holding an unpacked T; both
+  // hold the selected elements in packing order
+  void const* gathered_buffer = nullptr;
+  if(auto* gathered_range = dynamic_cast<GatheredElementRange<T> const*>(&range)) {
+    gathered_buffer = gathered_range->get_buffer();
+  }
+  else if(auto* simple_range = dynamic_cast<ElementRangeT const*>(&range)) {
+    gathered_buffer = simple_range->get_buffer();
+  }
+  DARMA_ASSERT_MESSAGE(gathered_buffer != nullptr,
+    "set_element_range() with a non-contiguous index range was given an"
+    " element range that doesn't hold an object of the same type"
+  );
+  auto const& gathered = *static_cast<T const*>(gathered_buffer);
+  DARMA_ASSERT_EQUAL(
+    _idx_traits::n_elements(gathered), elem_idx_range.size()
+  );
+  auto& dest = *static_cast<T*>(obj);
+  size_t i_gathered = 0;
+  _idx_traits::for_each_element_run(dest, elem_idx_range,
+    [&](size_t offset, size_t n) {
+      for(size_t i = offset; i < offset + n; ++i, ++i_gathered) {
+        _idx_traits::get_element(dest, i) = _idx_traits::const_decomposition()
+          .get_element(gathered, i_gathered);
+      }
+    }
+  );
+}
+
 } // end namespace detail
 } // end namespace darma
 
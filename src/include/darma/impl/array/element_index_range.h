@@ -0,0 +1,245 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                      element_index_range.h
+//                         DARMA
+//              Copyright (C) 2017 NTESS, LLC
+//
+// Under the terms of Contract DE-NA-0003525 with NTESS, LLC,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact darma@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef DARMA_IMPL_ARRAY_ELEMENT_INDEX_RANGE_H
+#define DARMA_IMPL_ARRAY_ELEMENT_INDEX_RANGE_H
+
+#include <cstdlib>
+#include <initializer_list>
+#include <vector>
+
+#include <darma/utility/darma_assert.h>
+#include <darma/serialization/polymorphic/polymorphic_serialization_adapter.h>
+#include <darma/serialization/serializers/standard_library/vector.h>
+
+#include <darma/interface/frontend/element_index_range.h>
+
+namespace darma {
+
+/** @brief Selects `n_blocks` blocks of `block_length` contiguous elements of a
+ *  flat array, starting at `offset`, with the start of each block `stride`
+ *  elements after the start of the previous one.
+ *
+ *  With the default block length of 1, this is every `stride`-th element.  A
+ *  face of a row-major 3D field is always one of these (or contiguous).
+ */
+class StridedElementRange
+  : public serialization::PolymorphicSerializationAdapter<
+      StridedElementRange,
+      abstract::frontend::ElementIndexRange
+    >
+{
+  private:
+
+    size_t offset_ = 0;
+    size_t n_blocks_ = 0;
+    size_t stride_ = 1;
+    size_t block_length_ = 1;
+
+  public:
+
+    StridedElementRange() = default;
+
+    StridedElementRange(
+      size_t offset, size_t n_blocks, size_t stride, size_t block_length = 1
+    ) : offset_(offset), n_blocks_(n_blocks),
+        stride_(stride), block_length_(block_length)
+    { }
+
+    size_t size() const override { return n_blocks_ * block_length_; }
+
+    size_t
+    element_offset(size_t i) const override {
+      return offset_ + (i / block_length_) * stride_ + i % block_length_;
+    }
+
+    bool
+    get_block_pattern(
+      size_t& offset, size_t& n_blocks,
+      size_t& block_length, size_t& block_stride
+    ) const override {
+      offset = offset_;
+      n_blocks = n_blocks_;
+      block_length = block_length_;
+      block_stride = stride_;
+      return true;
+    }
+
+    template <typename ArchiveT>
+    void serialize(ArchiveT& ar) {
+      ar | offset_ | n_blocks_ | stride_ | block_length_;
+    }
+
+};
+
+/** @brief Selects the `n_rows` by `n_cols` sub-block starting at
+ *  (`row_begin`, `col_begin`) of a row-major 2D array with `row_length`
+ *  elements per row
+ */
+class ElementBlock2D
+  : public serialization::PolymorphicSerializationAdapter<
+      ElementBlock2D,
+      abstract::frontend::ElementIndexRange
+    >
+{
+  private:
+
+    size_t row_length_ = 0;
+    size_t row_begin_ = 0;
+    size_t col_begin_ = 0;
+    size_t n_rows_ = 0;
+    size_t n_cols_ = 0;
+
+  public:
+
+    ElementBlock2D() = default;
+
+    ElementBlock2D(
+      size_t row_length,
+      size_t row_begin, size_t col_begin,
+      size_t n_rows, size_t n_cols
+    ) : row_length_(row_length), row_begin_(row_begin), col_begin_(col_begin),
+        n_rows_(n_rows), n_cols_(n_cols)
+    { }
+
+    size_t size() const override { return n_rows_ * n_cols_; }
+
+    size_t
+    element_offset(size_t i) const override {
+      return (row_begin_ + i / n_cols_) * row_length_ + col_begin_ + i % n_cols_;
+    }
+
+    bool
+    get_block_pattern(
+      size_t& offset, size_t& n_blocks,
+      size_t& block_length, size_t& block_stride
+    ) const override {
+      offset = row_begin_ * row_length_ + col_begin_;
+      n_blocks = n_rows_;
+      block_length = n_cols_;
+      block_stride = row_length_;
+      return true;
+    }
+
+    template <typename ArchiveT>
+    void serialize(ArchiveT& ar) {
+      ar | row_length_ | row_begin_ | col_begin_ | n_rows_ | n_cols_;
+    }
+
+};
+
+/** @brief Selects an arbitrary list of elements of a flat array, by offset,
+ *  in the order given
+ */
+class ElementIndexList
+  : public serialization::PolymorphicSerializationAdapter<
+      ElementIndexList,
+      abstract::frontend::ElementIndexRange
+    >
+{
+  private:
+
+    std::vector<size_t> offsets_;
+
+  public:
+
+    ElementIndexList() = default;
+
+    explicit
+    ElementIndexList(std::vector<size_t> offsets)
+      : offsets_(std::move(offsets))
+    { }
+
+    ElementIndexList(std::initializer_list<size_t> offsets)
+      : offsets_(offsets)
+    { }
+
+    size_t size() const override { return offsets_.size(); }
+
+    size_t
+    element_offset(size_t i) const override { return offsets_[i]; }
+
+    template <typename ArchiveT>
+    void serialize(ArchiveT& ar) {
+      ar | offsets_;
+    }
+
+};
+
+namespace detail {
+
+inline abstract::frontend::ElementIndexRange const&
+as_element_index_range(abstract::frontend::IndexRange const* idx_range) {
+  auto const* rv =
+    dynamic_cast<abstract::frontend::ElementIndexRange const*>(idx_range);
+  DARMA_ASSERT_MESSAGE(rv != nullptr,
+    "Element ranges of data can only be selected with an ElementIndexRange"
+    " (e.g., StridedElementRange, ElementBlock2D, or ElementIndexList)"
+  );
+  return *rv;
+}
+
+// Returns true and sets offset and n_elem if range selects a single
+// contiguous run of elements
+inline bool
+is_contiguous_element_selection(
+  abstract::frontend::ElementIndexRange const& range,
+  size_t& offset, size_t& n_elem
+) {
+  size_t n_blocks = 0, block_length = 0, block_stride = 0;
+  if(
+    range.get_block_pattern(offset, n_blocks, block_length, block_stride)
+    and (n_blocks <= 1 or block_stride == block_length)
+  ) {
+    n_elem = n_blocks * block_length;
+    return true;
+  }
+  return false;
+}
+
+} // end namespace detail
+
+} // end namespace darma
+
+#endif //DARMA_IMPL_ARRAY_ELEMENT_INDEX_RANGE_H
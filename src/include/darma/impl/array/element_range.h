@@ -51,14 +51,24 @@
 #include <darma/interface/frontend/array_movement_manager.h>
 #include <darma/impl/serialization/manager.h>
 
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
 #include "index_decomposition.h"
 #include "indexable.h"
 #include "concept.h"
+#include "element_index_range.h"
 
 namespace darma {
 namespace detail {
 
-// Simple implies subset object is always the same type as parent
+// Simple implies subset object is always the same type as parent.  If the
+// decomposition of T yields views (see IndexingTraits::has_view_subsets), the
+// elements are copied into a new T instead.
 template <typename T>
 class SimpleElementRange
   : public abstract::frontend::ElementRange,
@@ -70,6 +80,41 @@ class SimpleElementRange
 
     using _idx_traits = IndexingTraits<T>;
 
+    using _copies_elements_t = std::integral_constant<bool,
+      _idx_traits::has_view_subsets
+    >;
+
+    void
+    _make_subobject(std::false_type /* copy */, void* md_buffer) {
+      _idx_traits::make_subobject(md_buffer, parent_, offset_, n_elem_);
+    }
+
+    void
+    _make_subobject(std::true_type /* copy */, void* md_buffer) {
+      _make_copy(
+        std::integral_constant<bool,
+          meta::iterable_traits<T>::has_iterator_constructor
+        >{},
+        md_buffer
+      );
+    }
+
+    void
+    _make_copy(std::true_type /* has iterator constructor */, void* md_buffer) {
+      using std::begin;
+      new (md_buffer) T(
+        begin(parent_) + offset_, begin(parent_) + offset_ + n_elem_
+      );
+    }
+
+    void
+    _make_copy(std::false_type /* has iterator constructor */, void*) {
+      DARMA_ASSERT_NOT_IMPLEMENTED(
+        "copied element ranges of types that can't be constructed from an"
+        " iterator range"
+      );
+    }
+
   public:
 
     SimpleElementRange(T const& parent, size_t offset, size_t n_elem)
@@ -83,12 +128,12 @@ class SimpleElementRange
     void
     setup(void* md_buffer) override {
       md_buffer_ = md_buffer;
-      _idx_traits::make_subobject(md_buffer, parent_, offset_, n_elem_);
+      _make_subobject(_copies_elements_t{}, md_buffer);
     }
 
     bool
     is_deep_copy() const override {
-      return _idx_traits::is_deep_copy(
+      return _copies_elements_t::value or _idx_traits::is_deep_copy(
         *static_cast<T const*>(md_buffer_)
       );
     }
@@ -127,6 +172,309 @@ class SimpleElementRange
 
 };
 
+template <typename T>
+class ViewElementRange;
+
+// The array concept manager of a ViewElementRange.  The objects it is handed
+// are views of the parent (i.e., the object set up in the range's metadata
+// buffer), not Ts, so further slices are taken relative to the view.  Views
+// are read-only, so they can't have element ranges set into them.
+template <typename T>
+class ViewArrayConceptManager
+  : public abstract::frontend::ArrayConceptManager
+{
+  private:
+
+    using _idx_traits = IndexingTraits<T>;
+    using _view_t = std::remove_cv_t<
+      typename _idx_traits::const_subset_object_type
+    >;
+
+    _view_t const&
+    _get_view(void const* obj) const {
+      auto const& view = *static_cast<_view_t const*>(obj);
+      DARMA_ASSERT_MESSAGE(
+        view.data() >= parent_.data()
+          and view.data() + view.size()
+            <= parent_.data() + _idx_traits::n_elements(parent_),
+        "ViewArrayConceptManager given a view that isn't a view of its parent"
+      );
+      return view;
+    }
+
+  public:
+
+    explicit
+    ViewArrayConceptManager(T const& parent)
+      : parent_(parent)
+    { }
+
+    size_t
+    n_elements(void const* obj) const override {
+      return _get_view(obj).size();
+    }
+
+    types::unique_ptr_template<abstract::frontend::ElementRange>
+    get_element_range(
+      void const* obj,
+      size_t offset, size_t n_elem
+    ) const override {
+      auto const& view = _get_view(obj);
+      DARMA_ASSERT_RELATED_VERBOSE(offset + n_elem, <=, view.size());
+      types::unique_ptr_template<abstract::frontend::ElementRange> rv =
+        detail::make_unique<ViewElementRange<T>>(
+          parent_, (view.data() - parent_.data()) + offset, n_elem
+        );
+      return std::move(rv);
+    }
+
+    void
+    set_element_range(
+      void*,
+      abstract::frontend::ElementRange const&,
+      size_t, size_t
+    ) const override {
+      DARMA_ASSERT_NOT_IMPLEMENTED(
+        "setting an element range into a (read-only) element range view"
+      );
+    }
+
+  private:
+
+    T const& parent_;
+
+};
+
+// A non-owning view of a contiguous slice of the parent's storage, for types
+// whose decomposition yields views of contiguous, trivially copyable elements
+// (e.g., std::vector<double>).  The metadata buffer given to setup() holds the
+// view, which refers directly to the parent, so it must not outlive either
+// the parent or this range.  The view packs in the same format as a T with
+// the same elements, so the receiving side unpacks a (deep copy) T.
+template <typename T>
+class ViewElementRange
+  : public abstract::frontend::ElementRange,
+    public serialization::detail::SerializationManagerForType<T>
+{
+  private:
+
+    using _idx_traits = IndexingTraits<T>;
+    using _view_t = std::remove_cv_t<
+      typename _idx_traits::const_subset_object_type
+    >;
+    using _element_t = std::remove_cv_t<typename _idx_traits::element_type>;
+    using _ser_man_t = serialization::detail::SerializationManagerForType<T>;
+    using typename _ser_man_t::serialization_handler_t;
+    using typename _ser_man_t::_can_pack_as_blob_t;
+
+    static_assert(std::is_trivially_destructible<_view_t>::value,
+      "element range views must be trivially destructible"
+    );
+
+  public:
+
+    ViewElementRange(T const& parent, size_t offset, size_t n_elem)
+      : parent_(parent), offset_(offset), n_elem_(n_elem),
+        concept_manager_(parent)
+    {
+      DARMA_ASSERT_RELATED_VERBOSE(
+        offset + n_elem, <=, _idx_traits::n_elements(parent)
+      );
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // <editor-fold desc="abstract::frontend::ElementRange implementation">
+
+    void
+    setup(void* md_buffer) override {
+      md_buffer_ = md_buffer;
+      _idx_traits::make_subobject(md_buffer, parent_, offset_, n_elem_);
+    }
+
+    bool
+    is_deep_copy() const override {
+      return false;
+    }
+
+    void const*
+    get_contiguous_data() const override {
+      return parent_.data() + offset_;
+    }
+
+    size_t
+    get_contiguous_data_size() const override {
+      return n_elem_ * sizeof(_element_t);
+    }
+
+    abstract::frontend::SerializationManager const*
+    get_serialization_manager() const override {
+      return this;
+    }
+
+    abstract::frontend::ArrayConceptManager const*
+    get_array_concept_manager() const override {
+      return &concept_manager_;
+    }
+
+    // end abstract::frontend::ElementRange implementation </editor-fold>
+    ////////////////////////////////////////////////////////////////////////////
+
+    ////////////////////////////////////////////////////////////////////////////
+    // <editor-fold desc="abstract::frontend::SerializationManager overrides">
+
+    // Sizing and packing always read a view (i.e., the object set up in the
+    // metadata buffer); unpacking and destruction are inherited and always
+    // act on a T, so the buffer must be able to hold either.  The view itself
+    // is trivially destructible and never needs to be destroyed.
+
+    size_t
+    get_metadata_size() const override {
+      return std::max(sizeof(T), sizeof(_view_t));
+    }
+
+    size_t
+    get_packed_data_size(
+      void const* const object_data,
+      abstract::backend::SerializationPolicy* ser_pol
+    ) const override {
+      auto const& view = *static_cast<_view_t const*>(object_data);
+      // must match the unpacking side (see SerializationManagerForType)
+      ser_pol = this->_effective_policy(ser_pol);
+      if(ser_pol != nullptr and _can_pack_as_blob_t::value) {
+        return sizeof(size_t) + ser_pol->packed_size_contribution_for_blob(
+          view.data(), view.size() * sizeof(_element_t)
+        );
+      }
+      auto ar = serialization_handler_t::make_sizing_archive();
+      ar % view;
+      return serialization_handler_t::get_size(ar);
+    }
+
+    void
+    pack_data(
+      void const* const object_data,
+      void* const serialization_buffer,
+      abstract::backend::SerializationPolicy* ser_pol
+    ) const override {
+      auto const& view = *static_cast<_view_t const*>(object_data);
+      // must match the unpacking side (see SerializationManagerForType)
+      ser_pol = this->_effective_policy(ser_pol);
+      if(ser_pol != nullptr and _can_pack_as_blob_t::value) {
+        size_t const n_elem = view.size();
+        std::memcpy(serialization_buffer, &n_elem, sizeof(size_t));
+        void* blob_buffer =
+          static_cast<char*>(serialization_buffer) + sizeof(size_t);
+        ser_pol->pack_blob(
+          blob_buffer, view.data(), n_elem * sizeof(_element_t)
+        );
+        return;
+      }
+      auto ar = serialization_handler_t::make_packing_archive(
+        // Capacity unknown, but it doesn't matter
+        serialization::NonOwningSerializationBuffer(
+          serialization_buffer, std::numeric_limits<size_t>::max()
+        )
+      );
+      ar << view;
+    }
+
+    // end abstract::frontend::SerializationManager overrides </editor-fold>
+    ////////////////////////////////////////////////////////////////////////////
+
+    void* get_buffer() { return md_buffer_; }
+
+    void const* get_buffer() const { return md_buffer_; }
+
+  private:
+
+    void* md_buffer_ = nullptr;
+
+    T const& parent_;
+
+    size_t offset_;
+    size_t n_elem_;
+
+    ViewArrayConceptManager<T> concept_manager_;
+
+};
+
+// A deep copy of an arbitrary (e.g., strided) selection of elements of the
+// parent, gathered in packing order into an object of the same type.  The
+// elements are gathered on construction, so neither the parent nor the index
+// range needs to outlive this.
+template <typename T>
+class GatheredElementRange
+  : public abstract::frontend::ElementRange,
+    public serialization::detail::SerializationManagerForType<T>,
+    public ArrayConceptManagerForType<T, SimpleElementRange<T>>
+{
+  private:
+
+    using _idx_traits = IndexingTraits<T>;
+    using _element_t = std::remove_cv_t<typename _idx_traits::element_type>;
+
+  public:
+
+    GatheredElementRange(
+      T const& parent,
+      abstract::frontend::ElementIndexRange const& idx_range
+    ) {
+      gathered_.reserve(idx_range.size());
+      _idx_traits::for_each_element_run(parent, idx_range,
+        [&](size_t offset, size_t n) {
+          for(size_t i = offset; i < offset + n; ++i) {
+            gathered_.push_back(
+              _idx_traits::const_decomposition().get_element(parent, i)
+            );
+          }
+        }
+      );
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // <editor-fold desc="abstract::frontend::ElementRange implementation">
+
+    void
+    setup(void* md_buffer) override {
+      md_buffer_ = md_buffer;
+      new (md_buffer) T(
+        std::make_move_iterator(gathered_.begin()),
+        std::make_move_iterator(gathered_.end())
+      );
+      // the T in md_buffer holds the elements from here on
+      std::vector<_element_t>().swap(gathered_);
+    }
+
+    bool
+    is_deep_copy() const override {
+      return true;
+    }
+
+    abstract::frontend::SerializationManager const*
+    get_serialization_manager() const override {
+      return this;
+    }
+
+    abstract::frontend::ArrayConceptManager const*
+    get_array_concept_manager() const override {
+      return this;
+    }
+
+    // end abstract::frontend::ElementRange implementation </editor-fold>
+    ////////////////////////////////////////////////////////////////////////////
+
+    void* get_buffer() { return md_buffer_; }
+
+    void const* get_buffer() const { return md_buffer_; }
+
+  private:
+
+    void* md_buffer_ = nullptr;
+
+    std::vector<_element_t> gathered_;
+
+};
+
 } // end namespace detail
 } // end namespace darma
 
@@ -151,6 +151,8 @@ class ContiguousIndexRange
 
     size_t size() const override { return size_; }
 
+    Integer offset() const { return offset_; }
+
 };
 
 template <typename Integer = int>
@@ -45,6 +45,16 @@
 #ifndef DARMA_IMPL_ARRAY_INDEXABLE_H
 #define DARMA_IMPL_ARRAY_INDEXABLE_H
 
+#include <cstdlib>
+#include <cstring>
+#include <type_traits>
+
+#include <tinympl/detection.hpp>
+
+#include <darma/utility/darma_assert.h>
+
+#include <darma/interface/frontend/element_index_range.h>
+
 #include "array_fwd.h"
 #include "index_decomposition.h"
 
@@ -63,6 +73,14 @@ struct IndexingTraits {
     using element_type = typename decomposition::element_type;
 
     using subset_object_type = typename decomposition::subset_object_type;
+    using const_subset_object_type =
+      typename const_decomposition::subset_object_type;
+
+    /// True if element ranges of T are views into the parent (e.g.,
+    /// `vector_view` for `std::vector`) rather than objects of type T
+    static constexpr auto has_view_subsets = not std::is_same<
+      std::remove_cv_t<const_subset_object_type>, std::remove_cv_t<T>
+    >::value;
 
   private:
 
@@ -72,6 +90,248 @@ struct IndexingTraits {
       )
     );
 
+    template <typename U>
+    using _data_pointer_archetype = decltype( std::declval<U&>().data() );
+
+    using _const_data_pointer_t = tinympl::detected_t<
+      _data_pointer_archetype, std::add_const_t<T>
+    >;
+
+  public:
+
+    /**
+     *  True if the elements of T are stored contiguously (i.e., `obj.data()`
+     *  points to element 0 of a random access range of `n_elements(obj)`
+     *  elements) and can be copied bytewise.  Element ranges of such types
+     *  are packed and unpacked with a single raw copy of the slice, rather
+     *  than by constructing a sub-object.
+     */
+    static constexpr auto has_contiguous_trivially_copyable_elements =
+      std::is_pointer<_const_data_pointer_t>::value
+      and std::is_same<
+        std::remove_cv_t<std::remove_pointer_t<_const_data_pointer_t>>,
+        std::remove_cv_t<element_type>
+      >::value
+      and std::is_trivially_copyable<std::remove_cv_t<element_type>>::value;
+
+  private:
+
+    using _direct_packing_t = std::integral_constant<bool,
+      has_contiguous_trivially_copyable_elements
+    >;
+
+    // The packed format is the same as that of a sub-object of these types
+    // (a size_t count followed by the raw elements), so the direct and
+    // sub-object versions are interchangeable
+
+    template <typename ArchiveT>
+    static inline void
+    _get_packed_size(
+      std::true_type /* direct */,
+      T const&, ArchiveT& ar,
+      size_t, size_t n_elem
+    ) {
+      ar % n_elem;
+      ar.add_to_size_raw(n_elem * sizeof(element_type));
+    }
+
+    template <typename ArchiveT>
+    static inline void
+    _get_packed_size(
+      std::false_type /* direct */,
+      T const& obj, ArchiveT& ar,
+      size_t offset, size_t n_elem
+    ) {
+      // Simplest default: make an object with an element range and pack it
+      ar % const_decomposition().get_element_range(obj, offset, n_elem);
+    }
+
+    template <typename ArchiveT>
+    static inline void
+    _pack_elements(
+      std::true_type /* direct */,
+      T const& obj, ArchiveT& ar,
+      size_t offset, size_t n_elem
+    ) {
+      DARMA_ASSERT_RELATED_VERBOSE(offset + n_elem, <=, n_elements(obj));
+      ar << n_elem;
+      ar.pack_data_raw(obj.data() + offset, obj.data() + offset + n_elem);
+    }
+
+    template <typename ArchiveT>
+    static inline void
+    _pack_elements(
+      std::false_type /* direct */,
+      T const& obj, ArchiveT& ar,
+      size_t offset, size_t n_elem
+    ) {
+      // Simplest default: make an object with an element range and pack it
+      ar << const_decomposition().get_element_range(obj, offset, n_elem);
+    }
+
+    template <typename ArchiveT>
+    static inline void
+    _unpack_elements(
+      std::true_type /* direct */,
+      T& obj, ArchiveT& ar,
+      size_t offset, size_t n_elem
+    ) {
+      size_t n_packed = 0;
+      ar >> n_packed;
+      DARMA_ASSERT_EQUAL(n_packed, n_elem);
+      DARMA_ASSERT_RELATED_VERBOSE(offset + n_elem, <=, n_elements(obj));
+      ar.template unpack_data_raw<std::remove_cv_t<element_type>>(
+        obj.data() + offset, n_elem
+      );
+    }
+
+    template <typename ArchiveT>
+    static inline void
+    _unpack_elements(
+      std::false_type /* direct */,
+      T& obj, ArchiveT& ar,
+      size_t offset, size_t n_elem
+    ) {
+      // Simplest default: reconstruct the object, then
+      T subobj;
+      ar >> subobj;
+      decomposition().set_element_range(obj, subobj, offset, n_elem);
+    }
+
+    //--------------------------------------------------------------------------
+    // <editor-fold desc="ElementIndexRange helpers"> {{{2
+
+    using _element_index_range_t = abstract::frontend::ElementIndexRange;
+
+    // Calls f(offset, n_contiguous) for each run of contiguous elements of
+    // range, in packing order
+    template <typename Callable>
+    static inline void
+    _for_each_run(
+      T const& obj, _element_index_range_t const& range, Callable&& f
+    ) {
+      size_t offset = 0, n_blocks = 0, block_length = 0, block_stride = 0;
+      if(range.get_block_pattern(offset, n_blocks, block_length, block_stride)) {
+        if(n_blocks == 0 or block_length == 0) return;
+        DARMA_ASSERT_RELATED_VERBOSE(
+          offset + (n_blocks - 1) * block_stride + block_length, <=,
+          n_elements(obj)
+        );
+        for(size_t iblock = 0; iblock < n_blocks; ++iblock) {
+          f(offset + iblock * block_stride, block_length);
+        }
+      }
+      else {
+        size_t const n_elem = range.size();
+        size_t const n_obj = n_elements(obj);
+        for(size_t i = 0; i < n_elem; ++i) {
+          auto const elem_offset = range.element_offset(i);
+          DARMA_ASSERT_RELATED_VERBOSE(elem_offset, <, n_obj);
+          f(elem_offset, size_t(1));
+        }
+      }
+    }
+
+    template <typename ArchiveT>
+    static inline void
+    _get_packed_size(
+      std::true_type /* direct */,
+      T const&, ArchiveT& ar,
+      _element_index_range_t const& range
+    ) {
+      size_t const n_elem = range.size();
+      ar % n_elem;
+      ar.add_to_size_raw(n_elem * sizeof(element_type));
+    }
+
+    template <typename ArchiveT>
+    static inline void
+    _get_packed_size(
+      std::false_type /* direct */,
+      T const& obj, ArchiveT& ar,
+      _element_index_range_t const& range
+    ) {
+      ar % range.size();
+      _for_each_run(obj, range, [&](size_t offset, size_t n) {
+        for(size_t i = offset; i < offset + n; ++i) {
+          ar % const_decomposition().get_element(obj, i);
+        }
+      });
+    }
+
+    template <typename ArchiveT>
+    static inline void
+    _pack_elements(
+      std::true_type /* direct */,
+      T const& obj, ArchiveT& ar,
+      _element_index_range_t const& range
+    ) {
+      ar << range.size();
+      auto const* src = obj.data();
+      auto*& dest = *reinterpret_cast<char**>(&ar.data_pointer_reference());
+      // Each run is a single memcpy, so contiguous blocks (e.g., the rows of a
+      // 2D sub-block) get copied with vector loads and stores
+      _for_each_run(obj, range, [&](size_t offset, size_t n) {
+        std::memcpy(dest, src + offset, n * sizeof(element_type));
+        dest += n * sizeof(element_type);
+      });
+    }
+
+    template <typename ArchiveT>
+    static inline void
+    _pack_elements(
+      std::false_type /* direct */,
+      T const& obj, ArchiveT& ar,
+      _element_index_range_t const& range
+    ) {
+      ar << range.size();
+      _for_each_run(obj, range, [&](size_t offset, size_t n) {
+        for(size_t i = offset; i < offset + n; ++i) {
+          ar << const_decomposition().get_element(obj, i);
+        }
+      });
+    }
+
+    template <typename ArchiveT>
+    static inline void
+    _unpack_elements(
+      std::true_type /* direct */,
+      T& obj, ArchiveT& ar,
+      _element_index_range_t const& range
+    ) {
+      size_t n_packed = 0;
+      ar >> n_packed;
+      DARMA_ASSERT_EQUAL(n_packed, range.size());
+      auto* dest = obj.data();
+      auto*& src = *reinterpret_cast<char const**>(&ar.data_pointer_reference());
+      _for_each_run(obj, range, [&](size_t offset, size_t n) {
+        std::memcpy(dest + offset, src, n * sizeof(element_type));
+        src += n * sizeof(element_type);
+      });
+    }
+
+    template <typename ArchiveT>
+    static inline void
+    _unpack_elements(
+      std::false_type /* direct */,
+      T& obj, ArchiveT& ar,
+      _element_index_range_t const& range
+    ) {
+      size_t n_packed = 0;
+      ar >> n_packed;
+      DARMA_ASSERT_EQUAL(n_packed, range.size());
+      _for_each_run(obj, range, [&](size_t offset, size_t n) {
+        for(size_t i = offset; i < offset + n; ++i) {
+          std::remove_cv_t<element_type> elem;
+          ar >> elem;
+          decomposition().get_element(obj, i) = std::move(elem);
+        }
+      });
+    }
+
+    // </editor-fold> end ElementIndexRange helpers }}}2
+    //--------------------------------------------------------------------------
+
   public:
 
     template <typename SubobjectType = T>
@@ -116,7 +376,8 @@ struct IndexingTraits {
       return const_decomposition().subset_is_deep_copy(object);
     }
 
-    // TODO these shouldn't reconstruct the sub-object except as a last resort
+    // Sub-objects are only reconstructed as a last resort, when the elements
+    // can't be copied directly (see has_contiguous_trivially_copyable_elements)
 
     template <typename ArchiveT>
     static inline void
@@ -124,8 +385,7 @@ struct IndexingTraits {
       T const& obj, ArchiveT& ar,
       size_t offset, size_t n_elem
     ) {
-      // Simplest default: make an object with an element range and pack it
-      ar % const_decomposition().get_element_range(obj, offset, n_elem);
+      _get_packed_size(_direct_packing_t{}, obj, ar, offset, n_elem);
     }
 
     template <typename ArchiveT>
@@ -134,8 +394,7 @@ struct IndexingTraits {
       T const& obj, ArchiveT& ar,
       size_t offset, size_t n_elem
     ) {
-      // Simplest default: make an object with an element range and pack it
-      ar << const_decomposition().get_element_range(obj, offset, n_elem);
+      _pack_elements(_direct_packing_t{}, obj, ar, offset, n_elem);
     }
 
     template <typename ArchiveT>
@@ -144,10 +403,50 @@ struct IndexingTraits {
       T& obj, ArchiveT& ar,
       size_t offset, size_t n_elem
     ) {
-      // Simplest default: reconstruct the object, then
-      T subobj;
-      ar >> subobj;
-      decomposition().set_element_range(obj, subobj, offset, n_elem);
+      _unpack_elements(_direct_packing_t{}, obj, ar, offset, n_elem);
+    }
+
+    // Arbitrary (strided, multi-dimensional, or listed) element selections.
+    // These never reconstruct a sub-object; types that can't be copied
+    // directly are packed element by element
+
+    template <typename ArchiveT>
+    static inline void
+    get_packed_size(
+      T const& obj, ArchiveT& ar,
+      abstract::frontend::ElementIndexRange const& range
+    ) {
+      _get_packed_size(_direct_packing_t{}, obj, ar, range);
+    }
+
+    template <typename ArchiveT>
+    static inline void
+    pack_elements(
+      T const& obj, ArchiveT& ar,
+      abstract::frontend::ElementIndexRange const& range
+    ) {
+      _pack_elements(_direct_packing_t{}, obj, ar, range);
+    }
+
+    template <typename ArchiveT>
+    static inline void
+    unpack_elements(
+      T& obj, ArchiveT& ar,
+      abstract::frontend::ElementIndexRange const& range
+    ) {
+      _unpack_elements(_direct_packing_t{}, obj, ar, range);
+    }
+
+    /// Calls `f(offset, n)` for each run of `n` contiguous elements starting
+    /// at `offset` selected by `range`, in packing order
+    template <typename Callable>
+    static inline void
+    for_each_element_run(
+      T const& obj,
+      abstract::frontend::ElementIndexRange const& range,
+      Callable&& f
+    ) {
+      _for_each_run(obj, range, std::forward<Callable>(f));
     }
 
 };
@@ -54,6 +54,7 @@
 #include <darma/impl/async_accessible/async_access_traits.h>
 #include "darma/impl/task/task.h"
 #include "darma/impl/handle.h"
+#include <darma/impl/serialization/lazy_unpacked.h>
 
 namespace darma {
 
@@ -448,6 +449,11 @@ struct functor_call_traits {
           "internal error deducing type conversion for functor-style task call"
         );
 
+        static constexpr bool _formal_arg_is_same_value_type =
+          (not is_access_handle) and std::is_same<
+            std::decay_t<typename formal_traits::param_t>, std::decay_t<CallArg>
+          >::value;
+
         using args_tuple_entry = tinympl::select_first_t<
           //------------------------------------------------------------
           // For the AccessHandle<T> => T or T const& cases:
@@ -478,6 +484,11 @@ struct functor_call_traits {
           std::is_same<std::decay_t<CallArg>, char const*>,
             /* => */ std::string,
           //------------------------------------------------------------
+          // Values that the functor takes as exactly their own type can be
+          // left packed after migration until the task reads them
+          std::integral_constant<bool, _formal_arg_is_same_value_type>,
+            /* => */ serialization::detail::lazy_unpacked_arg_t<std::decay_t<CallArg>>,
+          //------------------------------------------------------------
           // For other cases, require non-reference
           std::true_type,
             /* => */ //std::remove_reference_t<CallArg>
@@ -487,7 +498,10 @@ struct functor_call_traits {
         // Normal case, just pass through
         template <typename T>
         static std::enable_if_t<
-          not _functor_traits_impl::decayed_is_access_handle<T>::value
+          (
+            not _functor_traits_impl::decayed_is_access_handle<T>::value
+            and not serialization::detail::is_lazy_unpacked<std::decay_t<T>>::value
+          )
           or (
             // Some AccessHandle cases need to be handled here
             _functor_traits_impl::decayed_is_access_handle<T>::value
@@ -535,6 +549,16 @@ struct functor_call_traits {
           return val; //std::move(val);
         }
 
+        // Unpacks the argument if this is its first access since migration
+        template <typename T>
+        static std::enable_if_t<
+          serialization::detail::is_lazy_unpacked<std::decay_t<T>>::value,
+          typename std::decay_t<T>::value_type&
+        >
+        get_converted_arg(T&& val) {
+          return val.get();
+        }
+
         template <typename T>
         static std::enable_if_t<
           _functor_traits_impl::decayed_is_access_handle<T>::value
@@ -0,0 +1,164 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                      mapped_file.h
+//                         DARMA
+//              Copyright (C) 2017 NTESS, LLC
+//
+// Under the terms of Contract DE-NA-0003525 with NTESS, LLC,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact darma@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef DARMA_IMPL_CHECKPOINT_MAPPED_FILE_H
+#define DARMA_IMPL_CHECKPOINT_MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <darma/utility/darma_assert.h>
+
+namespace darma {
+
+namespace detail {
+
+/** @internal
+ *  @brief A (POSIX) memory-mapped file, either created read-write with a
+ *  fixed size or opened read-only in its entirety.
+ *
+ *  Pages of a read-only mapping are only brought in when they are touched,
+ *  which is what lets checkpoint restart cost scale with the data actually
+ *  restored rather than with the size of the file.
+ */
+class MappedFile {
+  public:
+
+    MappedFile() = default;
+
+    /// Create (or truncate) the file at `path` with size `size` and map it
+    /// read-write
+    MappedFile(std::string const& path, std::size_t size)
+      : size_(size)
+    {
+      DARMA_ASSERT_MESSAGE(size > 0, "Can't map an empty file");
+      int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+      DARMA_ASSERT_MESSAGE(fd >= 0, "Couldn't create file to be mapped");
+      int rv = ::ftruncate(fd, static_cast<off_t>(size));
+      DARMA_ASSERT_MESSAGE(rv == 0, "Couldn't resize file to be mapped");
+      _map(fd, PROT_READ | PROT_WRITE, MAP_SHARED);
+    }
+
+    /// Open the existing file at `path` and map all of it read-only
+    explicit
+    MappedFile(std::string const& path) {
+      int fd = ::open(path.c_str(), O_RDONLY);
+      DARMA_ASSERT_MESSAGE(fd >= 0, "Couldn't open file to be mapped");
+      struct stat file_stat;
+      int rv = ::fstat(fd, &file_stat);
+      DARMA_ASSERT_MESSAGE(rv == 0, "Couldn't stat file to be mapped");
+      size_ = static_cast<std::size_t>(file_stat.st_size);
+      DARMA_ASSERT_MESSAGE(size_ > 0, "Can't map an empty file");
+      _map(fd, PROT_READ, MAP_PRIVATE);
+    }
+
+    MappedFile(MappedFile const&) = delete;
+    MappedFile& operator=(MappedFile const&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept
+      : data_(std::exchange(other.data_, nullptr)),
+        size_(std::exchange(other.size_, 0))
+    { }
+
+    MappedFile&
+    operator=(MappedFile&& other) noexcept {
+      unmap();
+      data_ = std::exchange(other.data_, nullptr);
+      size_ = std::exchange(other.size_, 0);
+      return *this;
+    }
+
+    ~MappedFile() { unmap(); }
+
+    void* data() { return data_; }
+    void const* data() const { return data_; }
+
+    std::size_t size() const { return size_; }
+
+    bool is_mapped() const { return data_ != nullptr; }
+
+    /// Flush a read-write mapping back to the file (blocking)
+    void
+    sync() {
+      DARMA_ASSERT_MESSAGE(data_ != nullptr, "sync() called on unmapped file");
+      int rv = ::msync(data_, size_, MS_SYNC);
+      DARMA_ASSERT_MESSAGE(rv == 0, "Couldn't sync mapped file");
+    }
+
+    void
+    unmap() {
+      if(data_ != nullptr) {
+        ::munmap(data_, size_);
+        data_ = nullptr;
+        size_ = 0;
+      }
+    }
+
+  private:
+
+    void
+    _map(int fd, int prot, int flags) {
+      void* rv = ::mmap(nullptr, size_, prot, flags, fd, 0);
+      // the mapping keeps its own reference to the file
+      ::close(fd);
+      DARMA_ASSERT_MESSAGE(rv != MAP_FAILED, "Couldn't map file");
+      data_ = rv;
+    }
+
+    void* data_ = nullptr;
+    std::size_t size_ = 0;
+
+};
+
+} // end namespace detail
+
+} // end namespace darma
+
+#endif //DARMA_IMPL_CHECKPOINT_MAPPED_FILE_H
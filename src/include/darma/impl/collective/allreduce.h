@@ -66,9 +66,11 @@
 #include <darma/impl/use.h> // HandleUse
 #include <darma/impl/capture.h> // make_captured_use_holder
 #include <darma/impl/task/task.h> // TaskBase
+#include <darma/impl/util/frontend_trace.h>
 
 
 #include "details.h"
+#include "local_combiner.h"
 
 
 
@@ -92,6 +94,47 @@ using _get_collective_details_t = SimpleCollectiveDetails<
 >;
 
 
+// An in-out contribution held by a LocalAllreduceCombiner until the last
+// local contribution to its allreduce arrives
+template <typename DetailsT>
+struct _deferred_in_out_contribution
+  : LocalAllreduceCombiner::DeferredContribution
+{
+  std::unique_ptr<abstract::frontend::DestructibleUse> use_;
+  types::key_t tag_;
+  size_t piece_;
+  size_t n_pieces_;
+  #if _darma_has_feature(task_collection_token)
+  types::task_collection_token_t token_;
+  #endif // _darma_has_feature(task_collection_token)
+
+  _deferred_in_out_contribution(
+    std::unique_ptr<abstract::frontend::DestructibleUse>&& use,
+    types::key_t const& tag, size_t piece, size_t n_pieces
+    #if _darma_has_feature(task_collection_token)
+    , types::task_collection_token_t const& token
+    #endif // _darma_has_feature(task_collection_token)
+  ) : use_(std::move(use)), tag_(tag), piece_(piece), n_pieces_(n_pieces)
+      #if _darma_has_feature(task_collection_token)
+      , token_(token)
+      #endif // _darma_has_feature(task_collection_token)
+  { }
+
+  void submit(size_t n_combined) override {
+    DetailsT details(piece_, n_pieces_
+      #if _darma_has_feature(task_collection_token)
+      , token_
+      #endif // _darma_has_feature(task_collection_token)
+    );
+    details.set_n_combined_contributions(n_combined);
+    TraceSpan trace_span(abstract::frontend::TraceEventKind::Allreduce);
+    trace_span.set_name(tag_).set_index(piece_);
+    abstract::backend::get_backend_runtime()->allreduce_use(
+      std::move(use_), &details, tag_
+    );
+  }
+};
+
 template<typename Op>
 struct all_reduce_impl {
 
@@ -100,6 +143,9 @@ struct all_reduce_impl {
   #if _darma_has_feature(task_collection_token)
   types::task_collection_token_t token_;
   #endif // _darma_has_feature(task_collection_token)
+  // Non-null only for contributions from the tasks of a task collection whose
+  // backend has enabled node-local combining
+  LocalAllreduceCombiner* local_combiner_ = nullptr;
 
   all_reduce_impl()
   {
@@ -119,12 +165,106 @@ struct all_reduce_impl {
     #if _darma_has_feature(task_collection_token)
     , types::task_collection_token_t token
     #endif // _darma_has_feature(task_collection_token)
+    , LocalAllreduceCombiner* local_combiner = nullptr
   ) : piece_(piece), n_pieces_(n_pieces)
       #if _darma_has_feature(task_collection_token)
       , token_(token)
       #endif // _darma_has_feature(task_collection_token)
+      , local_combiner_(local_combiner)
   { }
 
+  //============================================================================
+
+  template <typename InOutHandle>
+  void
+  _do_locally_combined(
+    InOutHandle&& in_out, types::key_t const& tag,
+    size_t piece, size_t n_pieces
+  ) const {
+
+    using handle_t = std::decay_t<InOutHandle>;
+    using value_t = typename handle_t::value_type;
+    using details_t = _get_collective_details_t<Op, handle_t, handle_t>;
+
+    details_t details(piece, n_pieces
+      #if _darma_has_feature(task_collection_token)
+      , token_
+      #endif // _darma_has_feature(task_collection_token)
+    );
+
+    auto const* reduce_op = details.reduce_operation();
+    auto n_elements = [&](void const* obj) -> size_t {
+      return details.is_indexed() ?
+        reduce_op->get_array_concept_manager_for_values()->n_elements(obj) : 1;
+    };
+
+    // We can only fold data we're allowed to read (and, if we turn out to be
+    // the last local contribution, write) right now
+    auto* source_use = in_out.get_current_use()->use();
+    void* data = source_use->data_;
+    bool can_fold = std::is_copy_constructible<value_t>::value
+      and source_use->immediate_permissions_ == frontend::Permissions::Modify
+      and data != nullptr;
+
+    auto capture_in_out = [&] {
+      return detail::make_captured_use_holder(
+        in_out.var_handle_base_,
+        /* requested_scheduling_permissions */
+        frontend::Permissions::None,
+        /* requested_immediate_permissions */
+        frontend::Permissions::Modify,
+        in_out.get_current_use()
+      )->relinquish_into_destructible_use();
+    };
+
+    auto arrival = local_combiner_->arrive(tag, piece, can_fold,
+      // Reduce our data into the partial result for this process
+      [&](std::shared_ptr<void> partial) -> std::shared_ptr<void> {
+        if(not partial) {
+          return _make_local_partial<value_t>(data,
+            typename std::is_copy_constructible<value_t>::type{}
+          );
+        }
+        reduce_op->reduce_unpacked_into_unpacked(
+          data, partial.get(), 0, n_elements(data)
+        );
+        return partial;
+      },
+      // ...and hold our use until the last local contribution arrives
+      [&] {
+        return std::make_unique<_deferred_in_out_contribution<details_t>>(
+          capture_in_out(), tag, piece, n_pieces
+          #if _darma_has_feature(task_collection_token)
+          , token_
+          #endif // _darma_has_feature(task_collection_token)
+        );
+      }
+    );
+
+    if(arrival.fold and not arrival.is_last) {
+      // Owned by the combiner now
+      return;
+    }
+
+    if(arrival.fold) {
+      // We're last, so our data carries the result for the whole process
+      if(arrival.partial) {
+        reduce_op->reduce_unpacked_into_unpacked(
+          arrival.partial.get(), data, 0, n_elements(arrival.partial.get())
+        );
+      }
+      details.set_n_combined_contributions(arrival.n_folded);
+    }
+
+    abstract::backend::get_backend_runtime()->allreduce_use(
+      capture_in_out(), &details, tag
+    );
+
+    // The data of everything held until now has been folded into ours; they
+    // only need the result
+    for(auto&& contrib : arrival.to_submit) contrib->submit(0);
+  }
+
 
 
   template <
@@ -162,8 +302,20 @@ struct all_reduce_impl {
       n_pieces = n_pieces_;
     }
 
+    TraceSpan trace_span(abstract::frontend::TraceEventKind::Allreduce);
+    trace_span.set_name(tag).set_index(piece);
+
     auto* backend_runtime = abstract::backend::get_backend_runtime();
 
+    if(local_combiner_ != nullptr) {
+      // We can't fold separate input and output handles, but we still have to
+      // be counted so that the other local contributions aren't held forever
+      local_combiner_->arrive(tag, piece, false,
+        [](std::shared_ptr<void> partial) { return partial; },
+        [] { return LocalAllreduceCombiner::deferred_ptr_t{}; }
+      );
+    }
+
     // This is a read capture of the InputHandle and a write capture of the
     // output handle
 
@@ -235,6 +387,16 @@ struct all_reduce_impl {
       n_pieces = n_pieces_;
     }
 
+    TraceSpan trace_span(abstract::frontend::TraceEventKind::Allreduce);
+    trace_span.set_name(tag).set_index(piece);
+
+    if(local_combiner_ != nullptr) {
+      _do_locally_combined(
+        std::forward<InOutHandle>(in_out), tag, piece, n_pieces
+      );
+      return;
+    }
+
     auto* backend_runtime = abstract::backend::get_backend_runtime();
 
     _get_collective_details_t<
@@ -76,6 +76,7 @@ class SimpleCollectiveDetails
 
     size_t piece_;
     size_t n_pieces_;
+    size_t n_combined_ = 1;
 
     using wrapper_t = detail::ReduceOperationWrapper<ReduceOp, T>;
 
@@ -113,6 +114,12 @@ class SimpleCollectiveDetails
       return _impl::_get_static_reduce_op_instance<wrapper_t>();
     }
 
+    size_t
+    n_combined_contributions() const override { return n_combined_; }
+
+    void
+    set_n_combined_contributions(size_t n_combined) { n_combined_ = n_combined; }
+
 #if _darma_has_feature(task_collection_token)
     types::task_collection_token_t const&
     get_task_collection_token() const override {
@@ -0,0 +1,283 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                      local_combiner.h
+//                         DARMA
+//              Copyright (C) 2017 NTESS, LLC
+//
+// Under the terms of Contract DE-NA-0003525 with NTESS, LLC,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact darma@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef DARMA_IMPL_COLLECTIVE_LOCAL_COMBINER_H
+#define DARMA_IMPL_COLLECTIVE_LOCAL_COMBINER_H
+
+#include <darma/impl/feature_testing_macros.h>
+
+#if _darma_has_feature(simple_collectives)
+
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <darma_types.h>
+
+#include <darma/key/key_concept.h>
+
+namespace darma {
+namespace detail {
+
+/** @internal
+ *  @brief Combines the allreduce contributions of the tasks of one task
+ *  collection that run in the same process, so that only one contribution
+ *  per process carries data to the backend's distributed collective.
+ *
+ *  Only created when the backend tells the task collection how many of its
+ *  tasks it will run locally (see
+ *  abstract::frontend::TaskCollection::set_local_task_count()).  The
+ *  contributions to a given allreduce are folded through the reduction
+ *  operation into a partial result owned by this object.  None of them are
+ *  handed to the backend until the last local task has arrived; that task
+ *  reduces the partial into its own data (on which it has immediate
+ *  permissions) and submits it as a contribution standing for all of the
+ *  folded pieces.  The rest are then submitted as result-only contributions
+ *  (see abstract::frontend::CollectiveDetails::n_combined_contributions()).
+ *
+ *  A task can contribute more than once with the same tag (e.g., with the
+ *  default tag) before the other local tasks have caught up, so a
+ *  contribution belongs to the allreduce given by its tag and by how many
+ *  earlier contributions its task made with that tag: the n-th contribution
+ *  of each local task with a given tag is combined with the n-th contribution
+ *  of every other local task.
+ *
+ *  If any local contribution to an allreduce can't be folded (e.g., because
+ *  the calling task doesn't have immediate permissions on the data), the
+ *  whole group falls back to submitting every piece with its own data.  This
+ *  is always correct, since folding never modifies the buffers of the pieces
+ *  that weren't the last to arrive.
+ */
+class LocalAllreduceCombiner {
+
+  public:
+
+    /** @internal
+     *  @brief A captured collective use that hasn't been given to the backend
+     *  yet
+     */
+    struct DeferredContribution {
+      virtual void submit(std::size_t n_combined) =0;
+      virtual ~DeferredContribution() = default;
+    };
+
+    using deferred_ptr_t = std::unique_ptr<DeferredContribution>;
+    using deferred_list_t = std::vector<deferred_ptr_t>;
+
+    /** @internal
+     *  @brief What the caller of arrive() should do with its own contribution
+     */
+    struct Arrival {
+      /// True if this is the last local contribution to the allreduce
+      bool is_last = false;
+      /// True if the caller's data should be folded (into the partial if not
+      /// last, or the partial reduced into the caller's data if last)
+      bool fold = false;
+      /// The partial result (type-erased; nullptr until the first fold)
+      std::shared_ptr<void> partial = nullptr;
+      /// Total number of pieces folded, including the caller if fold is true
+      std::size_t n_folded = 0;
+      /// Contributions to submit after the caller's own (only non-empty for
+      /// the last arrival)
+      deferred_list_t to_submit;
+    };
+
+  private:
+
+    // The local contributions to one allreduce
+    struct _group {
+      // indices of the tasks that have contributed so far
+      std::unordered_set<std::size_t> arrived;
+      std::size_t n_folded = 0;
+      bool fallback = false;
+      // set once the last local contribution has taken `deferred`
+      bool complete = false;
+      std::shared_ptr<void> partial = nullptr;
+      deferred_list_t deferred;
+    };
+
+    using group_ptr_t = std::shared_ptr<_group>;
+    using key_traits_t = key_traits<types::key_t>;
+
+    std::size_t n_local_;
+    std::mutex mutex_;
+    // The incomplete allreduces for each tag, oldest first
+    std::unordered_map<
+      types::key_t, std::deque<group_ptr_t>,
+      typename key_traits_t::hasher, typename key_traits_t::key_equal
+    > groups_;
+
+  public:
+
+    explicit
+    LocalAllreduceCombiner(std::size_t n_local) : n_local_(n_local) { }
+
+    std::size_t n_local_tasks() const { return n_local_; }
+
+    /** @internal
+     *  @brief Register the arrival of one local contribution for `tag` from
+     *  the task with index `piece`.
+     *
+     *  If the caller's data is to be folded and it isn't the last arrival,
+     *  `fold_into_partial` is called while the lock is held.  It is given the
+     *  (possibly null) current partial and must return the new one; it is
+     *  called before the caller's use is captured, while the caller still has
+     *  immediate access to its data.  After the lock is released,
+     *  `make_deferred` is called to capture the caller's contribution, which
+     *  it must return as a DeferredContribution.  That is then either held
+     *  for the last arrival to submit or, if the allreduce has completed or
+     *  fallen back in the meantime, submitted right away.
+     *
+     *  @param can_fold whether the caller has immediate access to its data
+     *  @return an Arrival describing what the caller should submit itself
+     */
+    template <typename FoldIntoPartial, typename MakeDeferred>
+    Arrival
+    arrive(
+      types::key_t const& tag,
+      std::size_t piece,
+      bool can_fold,
+      FoldIntoPartial&& fold_into_partial,
+      MakeDeferred&& make_deferred
+    ) {
+      Arrival rv;
+      deferred_list_t fallback_submissions;
+      group_ptr_t group = nullptr;
+      {
+        std::lock_guard<std::mutex> lg(mutex_);
+        auto& groups = groups_[tag];
+        // The oldest allreduce with this tag that the caller hasn't
+        // contributed to yet
+        auto found = std::find_if(groups.begin(), groups.end(),
+          [&](group_ptr_t const& g) { return g->arrived.count(piece) == 0; }
+        );
+        if(found == groups.end()) {
+          found = groups.insert(groups.end(), std::make_shared<_group>());
+        }
+        group = *found;
+        group->arrived.insert(piece);
+        rv.is_last = group->arrived.size() == n_local_;
+
+        if(not can_fold and not group->fallback) {
+          // Everything held so far must be submitted with its own data
+          group->fallback = true;
+          fallback_submissions = std::move(group->deferred);
+          group->deferred.clear();
+          group->partial = nullptr;
+          group->n_folded = 0;
+        }
+
+        if(not group->fallback) {
+          rv.fold = true;
+          ++group->n_folded;
+          if(rv.is_last) {
+            rv.partial = std::move(group->partial);
+            rv.to_submit = std::move(group->deferred);
+            group->deferred.clear();
+          }
+          else {
+            group->partial = fold_into_partial(std::move(group->partial));
+          }
+        }
+        rv.n_folded = group->n_folded;
+
+        if(rv.is_last) {
+          group->complete = true;
+          groups.erase(found);
+          if(groups.empty()) groups_.erase(tag);
+        }
+      }
+
+      // Don't hand anything to the backend while holding the lock
+      for(auto&& contrib : fallback_submissions) contrib->submit(1);
+
+      if(rv.fold and not rv.is_last) {
+        auto contrib = make_deferred();
+        bool fallback = false;
+        {
+          std::lock_guard<std::mutex> lg(mutex_);
+          if(not group->complete and not group->fallback) {
+            group->deferred.emplace_back(std::move(contrib));
+            return rv;
+          }
+          fallback = group->fallback;
+        }
+        // Too late to be held: either our data has already been folded into
+        // the last arrival's, or the group fell back while we were capturing
+        contrib->submit(fallback ? 1 : 0);
+      }
+
+      return rv;
+    }
+
+};
+
+template <typename T>
+std::shared_ptr<void>
+_make_local_partial(void const* data, std::true_type /* copyable */) {
+  return std::make_shared<T>(*static_cast<T const*>(data));
+}
+
+template <typename T>
+std::shared_ptr<void>
+_make_local_partial(void const*, std::false_type /* copyable */) {
+  // Contributions of non-copyable types are never folded
+  assert(false);
+  return nullptr;
+}
+
+} // end namespace detail
+} // end namespace darma
+
+#endif // _darma_has_feature(simple_collectives)
+
+#endif //DARMA_IMPL_COLLECTIVE_LOCAL_COMBINER_H
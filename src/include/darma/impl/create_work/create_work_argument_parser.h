@@ -55,6 +55,11 @@
 #include <darma/interface/app/keyword_arguments/name.h>
 #include <darma/interface/app/keyword_arguments/allow_aliasing.h>
 #include <darma/interface/app/keyword_arguments/is_parallel.h>
+#include <darma/interface/app/keyword_arguments/affinity.h>
+#include <darma/interface/app/keyword_arguments/priority.h>
+#include <darma/interface/app/keyword_arguments/cost.h>
+#include <darma/interface/app/task_priority.h>
+#include <darma/interface/frontend/task_affinity.h>
 
 #include <darma/interface/backend/types.h>
 
@@ -72,6 +77,15 @@ using create_work_argument_parser = darma::detail::kwarg_parser<
     >,
     _optional_keyword<
       bool, keyword_tags_for_task_creation::is_parallel
+    >,
+    _optional_keyword<
+      abstract::frontend::TaskAffinity, keyword_tags_for_task_creation::affinity
+    >,
+    _optional_keyword<
+      TaskPriorityDescription, keyword_tags_for_task_creation::priority
+    >,
+    _optional_keyword<
+      double, keyword_tags_for_task_creation::cost
     >
   >
 >;
@@ -100,7 +114,14 @@ inline auto setup_create_work_argument_parser() {
           false
         );
       },
-      keyword_arguments_for_task_creation::is_parallel = [] { return false; }
+      keyword_arguments_for_task_creation::is_parallel = [] { return false; },
+      keyword_arguments_for_task_creation::affinity = [] {
+        return abstract::frontend::TaskAffinity{};
+      },
+      keyword_arguments_for_task_creation::priority = [] {
+        return TaskPriorityDescription{};
+      },
+      keyword_arguments_for_task_creation::cost = [] { return 0.0; }
     );
 }
 
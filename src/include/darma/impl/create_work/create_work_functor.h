@@ -75,6 +75,9 @@ struct _create_work_impl<Functor, tinympl::vector<Args...>, LastArg> {
 
     auto* parent_task = darma::detail::get_running_task_impl();
 
+    // covers capture as well as registration
+    TraceSpan trace_span(abstract::frontend::TraceEventKind::CreateWork);
+
     auto task = std::make_unique<functor_task_with_args_t<Functor, DeducedArgs...>>(
       parent_task,
       std::forward_as_tuple(std::forward<DeducedArgs>(in_args)...)
@@ -84,7 +87,9 @@ struct _create_work_impl<Functor, tinympl::vector<Args...>, LastArg> {
     task->set_context_information(
       ctxt->file, ctxt->line, ctxt->func
     );
+    trace_span.set_source_location(ctxt->file, ctxt->line, ctxt->func);
 #endif
+    trace_span.set_task(*task);
 
     return abstract::backend::get_backend_runtime()->register_task(
       std::move(task)
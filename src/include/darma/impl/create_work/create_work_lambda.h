@@ -74,6 +74,9 @@ struct _create_work_impl<detail::_create_work_uses_lambda_tag, tinympl::vector<A
 
     auto* parent_task = darma::detail::get_running_task_impl();
 
+    // covers capture as well as registration
+    TraceSpan trace_span(abstract::frontend::TraceEventKind::CreateWork);
+
     auto task = std::make_unique<
       darma::detail::LambdaTask<std::decay_t<Lambda>>
     >(
@@ -89,7 +92,9 @@ struct _create_work_impl<detail::_create_work_uses_lambda_tag, tinympl::vector<A
     task->set_context_information(
       ctxt->file, ctxt->line, ctxt->func
     );
+    trace_span.set_source_location(ctxt->file, ctxt->line, ctxt->func);
 #endif
+    trace_span.set_task(*task);
 
     return darma::abstract::backend::get_backend_runtime()->register_task(
       std::move(task)
@@ -110,6 +110,7 @@ struct WhileFunctorTask
       ),
       capture_manager_(capture_manager)
   {
+    this->copy_scheduling_hints_from(to_recapture);
 #if DARMA_CREATE_WORK_RECORD_LINE_NUMBERS
     this->copy_context_information_from(to_recapture);
 #endif
@@ -224,6 +225,7 @@ struct DoFunctorTask
       ),
       capture_manager_(capture_manager)
   {
+    this->copy_scheduling_hints_from(to_recapture);
 #if DARMA_CREATE_WORK_RECORD_LINE_NUMBERS
     this->copy_context_information_from(to_recapture);
 #endif
@@ -107,6 +107,7 @@ struct WhileLambdaTask
         ),
         capture_manager_(capture_manager)
     {
+      this->copy_scheduling_hints_from(to_recapture);
 #if DARMA_CREATE_WORK_RECORD_LINE_NUMBERS
       this->copy_context_information_from(to_recapture);
 #endif
@@ -227,6 +228,7 @@ struct DoLambdaTask
         ),
         capture_manager_(capture_manager)
     {
+      this->copy_scheduling_hints_from(to_recapture);
 #if DARMA_CREATE_WORK_RECORD_LINE_NUMBERS
       this->copy_context_information_from(to_recapture);
 #endif
@@ -60,6 +60,8 @@
 
 #include "array/index_range.h"
 #include "index_range/mapping.h"
+#include "index_range/partition_mappings.h"
+#include "index_range/sparse_range.h"
 #include "task_collection/task_collection.h"
 #include "task_collection/create_concurrent_work.h"
 #include "commutative_access.h"
@@ -47,6 +47,7 @@
 
 #include <atomic>
 #include <cassert>
+#include <cstring>
 #include <tuple>
 
 #include <tinympl/variadic/find_if.hpp>
@@ -76,6 +77,7 @@
 #include <darma/impl/array/indexable.h>
 #include <darma/impl/array/concept.h>
 #include <darma/impl/array/element_range.h>
+#include <darma/impl/array/element_index_range.h>
 
 #include <darma/impl/access_handle/access_handle_traits.h>
 
@@ -232,15 +234,171 @@ class VariableHandle
     using serialization_handler_t =
       darma::serialization::SimpleSerializationHandler<std::allocator<T>>;
 
+  private:
+
+    // Slices of elements that can be copied bytewise are handed to the
+    // SerializationPolicy (if any) as a single blob, preceded by the element
+    // count, like SerializationManagerForType does for whole objects
+    using _elements_as_blob_t = std::integral_constant<bool,
+      IndexingTraits<T>::has_contiguous_trivially_copyable_elements
+    >;
+    using _blob_element_t = std::remove_cv_t<
+      typename IndexingTraits<T>::element_type
+    >;
+
+    size_t
+    _get_packed_size_impl(
+      std::true_type, T const& obj, size_t offset, size_t n_elem,
+      abstract::backend::SerializationPolicy* ser_pol
+    ) const {
+      DARMA_ASSERT_RELATED_VERBOSE(
+        offset + n_elem, <=, IndexingTraits<T>::n_elements(obj)
+      );
+      return sizeof(size_t) + ser_pol->packed_size_contribution_for_blob(
+        obj.data() + offset, n_elem * sizeof(_blob_element_t)
+      );
+    }
+
+    void
+    _pack_elements_impl(
+      std::true_type, T const& obj, void* buffer, size_t offset, size_t n_elem,
+      abstract::backend::SerializationPolicy* ser_pol
+    ) const {
+      std::memcpy(buffer, &n_elem, sizeof(size_t));
+      void* blob_buffer = static_cast<char*>(buffer) + sizeof(size_t);
+      ser_pol->pack_blob(
+        blob_buffer, obj.data() + offset, n_elem * sizeof(_blob_element_t)
+      );
+    }
+
+    void
+    _unpack_elements_impl(
+      std::true_type, T& obj, void const* buffer, size_t offset, size_t n_elem,
+      abstract::backend::SerializationPolicy* ser_pol
+    ) const {
+      size_t n_packed = 0;
+      std::memcpy(&n_packed, buffer, sizeof(size_t));
+      DARMA_ASSERT_EQUAL(n_packed, n_elem);
+      DARMA_ASSERT_RELATED_VERBOSE(
+        offset + n_elem, <=, IndexingTraits<T>::n_elements(obj)
+      );
+      void* blob_buffer = const_cast<char*>(
+        static_cast<char const*>(buffer)
+      ) + sizeof(size_t);
+      ser_pol->unpack_blob(
+        blob_buffer, obj.data() + offset, n_elem * sizeof(_blob_element_t)
+      );
+    }
+
+    size_t
+    _get_packed_size_impl(
+      std::false_type, T const& obj, size_t offset, size_t n_elem,
+      abstract::backend::SerializationPolicy*
+    ) const {
+      auto ar = serialization_handler_t::make_sizing_archive();
+      IndexingTraits<T>::get_packed_size(obj, ar, offset, n_elem);
+      return serialization_handler_t::get_size(ar);
+    }
+
+    void
+    _pack_elements_impl(
+      std::false_type, T const& obj, void* buffer, size_t offset, size_t n_elem,
+      abstract::backend::SerializationPolicy*
+    ) const {
+      auto ar = serialization_handler_t::make_packing_archive(
+        // Capacity unknown, but it doesn't matter
+        darma::serialization::NonOwningSerializationBuffer(
+          buffer, std::numeric_limits<size_t>::max()
+        )
+      );
+      IndexingTraits<T>::pack_elements(obj, ar, offset, n_elem);
+    }
+
+    void
+    _unpack_elements_impl(
+      std::false_type, T& obj, void const* buffer, size_t offset, size_t n_elem,
+      abstract::backend::SerializationPolicy*
+    ) const {
+      auto ar = serialization_handler_t::make_unpacking_archive(
+        // Capacity unknown, but it doesn't matter
+        darma::serialization::ConstNonOwningSerializationBuffer(
+          buffer, std::numeric_limits<size_t>::max()
+        )
+      );
+      // call the customization point, allow ADL
+      IndexingTraits<T>::unpack_elements(obj, ar, offset, n_elem);
+    }
+
+  public:
+
     size_t
     get_packed_size(
       void const* obj,
       size_t offset, size_t n_elem,
+      abstract::backend::SerializationPolicy* ser_pol
+    ) const override {
+      ser_pol = this->_effective_policy(ser_pol);
+      auto const& object = *static_cast<T const*>(obj);
+      if(ser_pol != nullptr) {
+        return _get_packed_size_impl(
+          _elements_as_blob_t{}, object, offset, n_elem, ser_pol
+        );
+      }
+      return _get_packed_size_impl(
+        std::false_type{}, object, offset, n_elem, ser_pol
+      );
+    }
+
+    void
+    pack_elements(
+      void const* obj, void* buffer,
+      size_t offset, size_t n_elem,
+      abstract::backend::SerializationPolicy* ser_pol
+    ) const override {
+      ser_pol = this->_effective_policy(ser_pol);
+      auto const& object = *static_cast<T const*>(obj);
+      if(ser_pol != nullptr) {
+        _pack_elements_impl(
+          _elements_as_blob_t{}, object, buffer, offset, n_elem, ser_pol
+        );
+      }
+      else {
+        _pack_elements_impl(
+          std::false_type{}, object, buffer, offset, n_elem, ser_pol
+        );
+      }
+    }
+
+    void
+    unpack_elements(
+      void* obj, void const* buffer,
+      size_t offset, size_t n_elem,
+      abstract::backend::SerializationPolicy* ser_pol
+    ) const override
+    {
+      ser_pol = this->_effective_policy(ser_pol);
+      auto& object = *static_cast<T*>(obj);
+      if(ser_pol != nullptr) {
+        _unpack_elements_impl(
+          _elements_as_blob_t{}, object, buffer, offset, n_elem, ser_pol
+        );
+      }
+      else {
+        _unpack_elements_impl(
+          std::false_type{}, object, buffer, offset, n_elem, ser_pol
+        );
+      }
+    }
+
+    size_t
+    get_packed_size(
+      void const* obj,
+      abstract::frontend::IndexRange const* idx_range,
       abstract::backend::SerializationPolicy*
     ) const override {
       auto ar = serialization_handler_t::make_sizing_archive();
       IndexingTraits<T>::get_packed_size(
-        *static_cast<T const*>(obj), ar, offset, n_elem
+        *static_cast<T const*>(obj), ar, as_element_index_range(idx_range)
       );
       return serialization_handler_t::get_size(ar);
     }
@@ -248,7 +406,7 @@ class VariableHandle
     void
     pack_elements(
       void const* obj, void* buffer,
-      size_t offset, size_t n_elem,
+      abstract::frontend::IndexRange const* idx_range,
       abstract::backend::SerializationPolicy*
     ) const override {
       auto ar = serialization_handler_t::make_packing_archive(
@@ -258,28 +416,24 @@ class VariableHandle
         )
       );
       IndexingTraits<T>::pack_elements(
-        *static_cast<T const*>(obj), ar,
-        offset, n_elem
+        *static_cast<T const*>(obj), ar, as_element_index_range(idx_range)
       );
     }
 
     void
     unpack_elements(
       void* obj, void const* buffer,
-      size_t offset, size_t n_elem,
-      abstract::backend::SerializationPolicy* ser_pol
-    ) const override
-    {
+      abstract::frontend::IndexRange const* idx_range,
+      abstract::backend::SerializationPolicy*
+    ) const override {
       auto ar = serialization_handler_t::make_unpacking_archive(
         // Capacity unknown, but it doesn't matter
         darma::serialization::ConstNonOwningSerializationBuffer(
           buffer, std::numeric_limits<size_t>::max()
         )
       );
-      // call the customization point, allow ADL
       IndexingTraits<T>::unpack_elements(
-        *static_cast<T*>(obj), ar,
-        offset, n_elem
+        *static_cast<T*>(obj), ar, as_element_index_range(idx_range)
       );
     }
 
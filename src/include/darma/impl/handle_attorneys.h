@@ -73,6 +73,12 @@ struct for_AccessHandle {
              scheduling_permissions, immediate_permissions };
   }
 
+  template <typename AccessHandleT>
+  static abstract::frontend::SerializationManager const*
+  get_serialization_manager(AccessHandleT const& ah) {
+    return ah.var_handle_base_->get_serialization_manager();
+  }
+
 };
 
 }
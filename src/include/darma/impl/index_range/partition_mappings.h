@@ -0,0 +1,509 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                      partition_mappings.h
+//                         DARMA
+//              Copyright (C) 2017 NTESS, LLC
+//
+// Under the terms of Contract DE-NA-0003525 with NTESS, LLC,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact darma@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef DARMA_IMPL_INDEX_RANGE_PARTITION_MAPPINGS_H
+#define DARMA_IMPL_INDEX_RANGE_PARTITION_MAPPINGS_H
+
+#include <algorithm> // std::min, std::max, std::lower_bound, std::upper_bound
+#include <cstdlib> // std::size_t
+#include <type_traits>
+#include <vector>
+
+#include <darma/utility/darma_assert.h>
+#include <darma/utility/optional_boolean.h>
+
+#include <darma/serialization/serializers/standard_library/vector.h>
+
+#include <darma/impl/array/index_range.h>
+
+#include "polymorphic_mapping.h"
+
+namespace darma {
+
+namespace detail {
+
+/** @internal
+ *  @brief Common base for the many-to-one mappings from a `Range1D` handle
+ *  collection onto a `Range1D` task collection.
+ *
+ *  Stores the extents of both ranges so that the indices it hands back carry
+ *  the correct bounds for `ContiguousIndexMapping`.
+ */
+template <typename Integer>
+class BasicRange1DPartitionMapping
+  : public PolymorphicManyToOneMapping<ContiguousIndex<Integer>>
+{
+  protected:
+
+    using polymorphic_mapping_t = PolymorphicMapping<
+      ContiguousIndex<Integer>, ContiguousIndex<Integer>,
+      std::vector<ContiguousIndex<Integer>>, ContiguousIndex<Integer>
+    >;
+
+    Integer from_offset_ = 0;
+    Integer from_size_ = 0;
+    Integer to_offset_ = 0;
+    Integer to_size_ = 0;
+
+    BasicRange1DPartitionMapping() = default;
+
+    BasicRange1DPartitionMapping(
+      ContiguousIndexRange<Integer> const& from_range,
+      ContiguousIndexRange<Integer> const& to_range
+    ) : from_offset_(from_range.offset()),
+        from_size_(static_cast<Integer>(from_range.size())),
+        to_offset_(to_range.offset()),
+        to_size_(static_cast<Integer>(to_range.size()))
+    {
+      DARMA_ASSERT_MESSAGE(to_size_ > 0,
+        "Can't map a handle collection onto an empty task collection"
+      );
+    }
+
+    ContiguousIndex<Integer>
+    _from_index(Integer dense) const {
+      return { from_offset_ + dense, from_offset_, from_offset_ + from_size_ - 1 };
+    }
+
+    ContiguousIndex<Integer>
+    _to_index(Integer dense) const {
+      return { to_offset_ + dense, to_offset_, to_offset_ + to_size_ - 1 };
+    }
+
+    bool
+    _same_extents(BasicRange1DPartitionMapping const& other) const {
+      return from_offset_ == other.from_offset_
+        and from_size_ == other.from_size_
+        and to_offset_ == other.to_offset_
+        and to_size_ == other.to_size_;
+    }
+
+    template <typename ArchiveT>
+    void _serialize_extents(ArchiveT& ar) {
+      ar | from_offset_ | from_size_ | to_offset_ | to_size_;
+    }
+
+  public:
+
+    using is_index_mapping = std::true_type;
+    using from_index_type = ContiguousIndex<Integer>;
+    using from_multi_index_type = std::vector<ContiguousIndex<Integer>>;
+    using to_index_type = ContiguousIndex<Integer>;
+    using to_multi_index_type = ContiguousIndex<Integer>;
+
+    virtual ~BasicRange1DPartitionMapping() = default;
+
+};
+
+} // end namespace detail
+
+//==============================================================================
+// <editor-fold desc="BlockCyclicMapping, BlockMapping, and CyclicMapping"> {{{1
+
+/**
+ *  @brief Deals consecutive blocks of `block_size` handle collection indices
+ *  out to the task collection indices in round-robin order.
+ *
+ *  With `block_size == 1` this is a cyclic distribution (see `CyclicMapping`).
+ *  For one contiguous chunk per task collection index, use `BlockMapping`,
+ *  which spreads the remainder evenly instead of leaving trailing tasks short.
+ */
+template <typename Integer=int>
+class BlockCyclicMapping
+  : public detail::BasicRange1DPartitionMapping<Integer>
+{
+  private:
+
+    using base_t = detail::BasicRange1DPartitionMapping<Integer>;
+
+  protected:
+
+    Integer block_size_ = 1;
+
+  public:
+
+    using typename base_t::from_index_type;
+    using typename base_t::from_multi_index_type;
+    using typename base_t::to_index_type;
+    using typename base_t::to_multi_index_type;
+
+    BlockCyclicMapping() = default;
+
+    BlockCyclicMapping(
+      ContiguousIndexRange<Integer> const& from_range,
+      ContiguousIndexRange<Integer> const& to_range,
+      Integer block_size
+    ) : base_t(from_range, to_range),
+        block_size_(block_size)
+    {
+      DARMA_ASSERT_MESSAGE(block_size_ > 0,
+        "BlockCyclicMapping requires a positive block size"
+      );
+    }
+
+    Integer block_size() const { return block_size_; }
+
+    to_index_type
+    map_forward(from_index_type const& from) const override {
+      auto const dense_from = from.value - this->from_offset_;
+      return this->_to_index((dense_from / block_size_) % this->to_size_);
+    }
+
+    from_multi_index_type
+    map_backward(to_index_type const& to) const override {
+      auto const dense_to = to.value - this->to_offset_;
+      auto const stride = block_size_ * this->to_size_;
+      from_multi_index_type rv;
+      rv.reserve(
+        block_size_ * ((this->from_size_ + stride - 1) / stride)
+      );
+      for(
+        Integer block_begin = dense_to * block_size_;
+        block_begin < this->from_size_;
+        block_begin += stride
+      ) {
+        auto const block_end = std::min(block_begin + block_size_, this->from_size_);
+        for(Integer i = block_begin; i < block_end; ++i) {
+          rv.push_back(this->_from_index(i));
+        }
+      }
+      return rv;
+    }
+
+    bool
+    is_same(BlockCyclicMapping const& other) const {
+      return this->_same_extents(other) and block_size_ == other.block_size_;
+    }
+
+    optional_boolean_t
+    is_same(typename base_t::polymorphic_mapping_t const& other) const override {
+      auto* other_cast = dynamic_cast<BlockCyclicMapping const*>(&other);
+      if(other_cast) {
+        return is_same(*other_cast) ?
+          OptionalBoolean::KnownTrue : OptionalBoolean::KnownFalse;
+      }
+      return this->base_t::is_same(other);
+    }
+
+    template <typename ArchiveT>
+    void serialize(ArchiveT& ar) {
+      this->base_t::_serialize_extents(ar);
+      ar | block_size_;
+    }
+
+};
+
+/**
+ *  @brief Assigns one contiguous chunk of the handle collection to each task
+ *  collection index, with chunk sizes differing by at most one.
+ *
+ *  With `q = handle size / task size` and `r = handle size % task size`, the
+ *  first `r` task indices get `q + 1` handle indices and the rest get `q`
+ *  (e.g., 10 over 4 is split 3, 3, 2, 2).  Only when the handle collection is
+ *  smaller than the task collection do the trailing task indices get nothing.
+ */
+template <typename Integer=int>
+class BlockMapping
+  : public detail::BasicRange1DPartitionMapping<Integer>
+{
+  private:
+
+    using base_t = detail::BasicRange1DPartitionMapping<Integer>;
+
+    Integer _chunk_size() const { return this->from_size_ / this->to_size_; }
+    Integer _n_larger_chunks() const { return this->from_size_ % this->to_size_; }
+
+  public:
+
+    using typename base_t::from_index_type;
+    using typename base_t::from_multi_index_type;
+    using typename base_t::to_index_type;
+    using typename base_t::to_multi_index_type;
+
+    BlockMapping() = default;
+
+    BlockMapping(
+      ContiguousIndexRange<Integer> const& from_range,
+      ContiguousIndexRange<Integer> const& to_range
+    ) : base_t(from_range, to_range)
+    { }
+
+    to_index_type
+    map_forward(from_index_type const& from) const override {
+      auto const dense_from = from.value - this->from_offset_;
+      auto const q = _chunk_size();
+      auto const r = _n_larger_chunks();
+      // (if q is 0, every handle index is in one of the larger chunks)
+      auto const n_in_larger_chunks = r * (q + 1);
+      if(dense_from < n_in_larger_chunks) {
+        return this->_to_index(dense_from / (q + 1));
+      }
+      return this->_to_index(r + (dense_from - n_in_larger_chunks) / q);
+    }
+
+    from_multi_index_type
+    map_backward(to_index_type const& to) const override {
+      auto const dense_to = to.value - this->to_offset_;
+      auto const q = _chunk_size();
+      auto const r = _n_larger_chunks();
+      auto const chunk_begin = dense_to * q + std::min(dense_to, r);
+      auto const chunk_end = chunk_begin + q + (dense_to < r ? 1 : 0);
+      from_multi_index_type rv;
+      rv.reserve(chunk_end - chunk_begin);
+      for(Integer i = chunk_begin; i < chunk_end; ++i) {
+        rv.push_back(this->_from_index(i));
+      }
+      return rv;
+    }
+
+    bool
+    is_same(BlockMapping const& other) const {
+      return this->_same_extents(other);
+    }
+
+    optional_boolean_t
+    is_same(typename base_t::polymorphic_mapping_t const& other) const override {
+      auto* other_cast = dynamic_cast<BlockMapping const*>(&other);
+      if(other_cast) {
+        return is_same(*other_cast) ?
+          OptionalBoolean::KnownTrue : OptionalBoolean::KnownFalse;
+      }
+      return this->base_t::is_same(other);
+    }
+
+    template <typename ArchiveT>
+    void serialize(ArchiveT& ar) {
+      this->base_t::_serialize_extents(ar);
+    }
+
+};
+
+/**
+ *  @brief Assigns handle collection index `i` to task collection index
+ *  `i % task size` (both relative to the beginning of their ranges)
+ */
+template <typename Integer=int>
+class CyclicMapping
+  : public BlockCyclicMapping<Integer>
+{
+  public:
+
+    CyclicMapping() = default;
+
+    CyclicMapping(
+      ContiguousIndexRange<Integer> const& from_range,
+      ContiguousIndexRange<Integer> const& to_range
+    ) : BlockCyclicMapping<Integer>(from_range, to_range, Integer(1))
+    { }
+
+};
+
+// </editor-fold> end BlockCyclicMapping, BlockMapping, and CyclicMapping }}}1
+//==============================================================================
+
+
+//==============================================================================
+// <editor-fold desc="WeightedPartitionMapping"> {{{1
+
+/**
+ *  @brief Splits the handle collection into contiguous chunks of roughly equal
+ *  total cost, one per task collection index.
+ *
+ *  The cost vector gives one (non-negative) weight per handle collection
+ *  index.  Each task collection index is assigned at least one handle index
+ *  as long as the handle collection is at least as large as the task
+ *  collection.  `map_forward()` is a binary search over the chunk boundaries.
+ */
+template <typename Integer=int>
+class WeightedPartitionMapping
+  : public detail::BasicRange1DPartitionMapping<Integer>
+{
+  private:
+
+    using base_t = detail::BasicRange1DPartitionMapping<Integer>;
+
+    // task_begin_[t] is the (dense) handle index of the first handle collection
+    // entry assigned to task t; task_begin_.back() == from_size_
+    std::vector<Integer> task_begin_;
+
+  public:
+
+    using typename base_t::from_index_type;
+    using typename base_t::from_multi_index_type;
+    using typename base_t::to_index_type;
+    using typename base_t::to_multi_index_type;
+
+    WeightedPartitionMapping() = default;
+
+    WeightedPartitionMapping(
+      ContiguousIndexRange<Integer> const& from_range,
+      ContiguousIndexRange<Integer> const& to_range,
+      std::vector<double> const& costs
+    ) : base_t(from_range, to_range),
+        task_begin_(this->to_size_ + 1, Integer(0))
+    {
+      DARMA_ASSERT_MESSAGE(
+        costs.size() == static_cast<std::size_t>(this->from_size_),
+        "WeightedPartitionMapping requires exactly one cost per index in the "
+        "handle collection's index range"
+      );
+
+      std::vector<double> prefix(costs.size() + 1, 0.0);
+      for(std::size_t i = 0; i < costs.size(); ++i) {
+        prefix[i+1] = prefix[i] + costs[i];
+      }
+      auto const total = prefix.back();
+      auto const leave_none_empty = this->from_size_ >= this->to_size_;
+
+      task_begin_.back() = this->from_size_;
+      for(Integer t = 1; t < this->to_size_; ++t) {
+        auto const target = total * double(t) / double(this->to_size_);
+        // Pick whichever boundary puts the prefix sum closest to the target
+        Integer split = static_cast<Integer>(
+          std::lower_bound(prefix.begin(), prefix.end(), target) - prefix.begin()
+        );
+        if(split > 0 and target - prefix[split-1] <= prefix[split] - target) {
+          --split;
+        }
+        if(leave_none_empty) {
+          split = std::max(split, task_begin_[t-1] + 1);
+          split = std::min(split, this->from_size_ - (this->to_size_ - t));
+        }
+        else {
+          split = std::max(split, task_begin_[t-1]);
+        }
+        task_begin_[t] = split;
+      }
+    }
+
+    to_index_type
+    map_forward(from_index_type const& from) const override {
+      auto const dense_from = from.value - this->from_offset_;
+      auto const found = std::upper_bound(
+        task_begin_.begin() + 1, task_begin_.end(), dense_from
+      );
+      return this->_to_index(
+        static_cast<Integer>(found - (task_begin_.begin() + 1))
+      );
+    }
+
+    from_multi_index_type
+    map_backward(to_index_type const& to) const override {
+      auto const dense_to = to.value - this->to_offset_;
+      from_multi_index_type rv;
+      rv.reserve(task_begin_[dense_to+1] - task_begin_[dense_to]);
+      for(Integer i = task_begin_[dense_to]; i < task_begin_[dense_to+1]; ++i) {
+        rv.push_back(this->_from_index(i));
+      }
+      return rv;
+    }
+
+    bool
+    is_same(WeightedPartitionMapping const& other) const {
+      return this->_same_extents(other) and task_begin_ == other.task_begin_;
+    }
+
+    optional_boolean_t
+    is_same(typename base_t::polymorphic_mapping_t const& other) const override {
+      auto* other_cast = dynamic_cast<WeightedPartitionMapping const*>(&other);
+      if(other_cast) {
+        return is_same(*other_cast) ?
+          OptionalBoolean::KnownTrue : OptionalBoolean::KnownFalse;
+      }
+      return this->base_t::is_same(other);
+    }
+
+    template <typename ArchiveT>
+    void serialize(ArchiveT& ar) {
+      this->base_t::_serialize_extents(ar);
+      ar | task_begin_;
+    }
+
+};
+
+// </editor-fold> end WeightedPartitionMapping }}}1
+//==============================================================================
+
+
+template <typename Integer>
+BlockMapping<Integer>
+make_block_mapping(
+  ContiguousIndexRange<Integer> const& handle_range,
+  ContiguousIndexRange<Integer> const& task_range
+) {
+  return BlockMapping<Integer>(handle_range, task_range);
+}
+
+template <typename Integer>
+CyclicMapping<Integer>
+make_cyclic_mapping(
+  ContiguousIndexRange<Integer> const& handle_range,
+  ContiguousIndexRange<Integer> const& task_range
+) {
+  return CyclicMapping<Integer>(handle_range, task_range);
+}
+
+template <typename Integer>
+BlockCyclicMapping<Integer>
+make_block_cyclic_mapping(
+  ContiguousIndexRange<Integer> const& handle_range,
+  ContiguousIndexRange<Integer> const& task_range,
+  Integer block_size
+) {
+  return BlockCyclicMapping<Integer>(handle_range, task_range, block_size);
+}
+
+template <typename Integer>
+WeightedPartitionMapping<Integer>
+make_weighted_partition_mapping(
+  ContiguousIndexRange<Integer> const& handle_range,
+  ContiguousIndexRange<Integer> const& task_range,
+  std::vector<double> const& costs
+) {
+  return WeightedPartitionMapping<Integer>(handle_range, task_range, costs);
+}
+
+} // end namespace darma
+
+#endif //DARMA_IMPL_INDEX_RANGE_PARTITION_MAPPINGS_H
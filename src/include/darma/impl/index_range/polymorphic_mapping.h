@@ -134,6 +134,36 @@ class PolymorphicOneToOneMapping
     virtual ~PolymorphicOneToOneMapping() = default;
 };
 
+template <
+  typename FromIndexT, typename ToIndexT=FromIndexT
+>
+class PolymorphicManyToOneMapping
+  : public PolymorphicMapping<FromIndexT, ToIndexT, std::vector<FromIndexT>, ToIndexT>
+{
+
+  public:
+
+    using is_index_mapping_t = std::true_type;
+    using from_index_type = FromIndexT;
+    using from_multi_index_type = std::vector<FromIndexT>;
+    using to_index_type = ToIndexT;
+    using to_multi_index_type = ToIndexT;
+
+    bool is_one_to_one() const override { return false; }
+    static constexpr auto is_always_one_to_one = false;
+
+    bool is_one_to_many() const override { return false; }
+    static constexpr auto is_always_one_to_many = false;
+
+    bool is_many_to_one() const override { return true; }
+    static constexpr auto is_always_many_to_one = true;
+
+    bool is_many_to_many() const override { return false; }
+    static constexpr auto is_always_many_to_many = false;
+
+    virtual ~PolymorphicManyToOneMapping() = default;
+};
+
 // TODO fill in other possible types
 
 
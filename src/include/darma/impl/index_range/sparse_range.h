@@ -0,0 +1,213 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                      sparse_range.h
+//                         DARMA
+//              Copyright (C) 2017 NTESS, LLC
+//
+// Under the terms of Contract DE-NA-0003525 with NTESS, LLC,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact darma@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef DARMA_IMPL_INDEX_RANGE_SPARSE_RANGE_H
+#define DARMA_IMPL_INDEX_RANGE_SPARSE_RANGE_H
+
+#include <algorithm> // std::sort, std::unique, std::lower_bound
+#include <cassert>
+#include <cstdlib> // std::size_t
+#include <initializer_list>
+#include <memory> // std::shared_ptr
+#include <type_traits>
+#include <vector>
+
+#include <darma/utility/darma_assert.h>
+
+#include <darma/serialization/polymorphic/polymorphic_serialization_adapter.h>
+#include <darma/serialization/serializers/standard_library/vector.h>
+
+#include <darma/interface/frontend/index_range.h>
+
+namespace darma {
+
+namespace detail {
+
+template <typename Integer, typename DenseIndex=std::size_t>
+struct SparseIndexMapping;
+
+} // end namespace detail
+
+/** @brief An index range containing an arbitrary (sorted, unique) subset of
+ *  the integers, e.g., only the occupied blocks of a large index space.
+ *
+ *  The indices are stored once in an immutable, sorted array that is shared
+ *  (not copied) between copies of the range and its mapping to dense, so
+ *  passing the range around by value is cheap.  Mapping to dense is a binary
+ *  search (O(log n)) and mapping from dense is an array lookup (O(1)).
+ */
+template <typename Integer>
+class SparseIndexRange
+  : public serialization::PolymorphicSerializationAdapter<
+      SparseIndexRange<Integer>,
+      abstract::frontend::IndexRange
+    >
+{
+  private:
+
+    using storage_t = std::vector<Integer>;
+
+    std::shared_ptr<storage_t const> indices_;
+
+  public:
+
+    using mapping_to_dense = detail::SparseIndexMapping<Integer>;
+    using index_type = Integer;
+    using is_index_range = std::true_type;
+    using const_iterator = typename storage_t::const_iterator;
+
+    SparseIndexRange()
+      : indices_(std::make_shared<storage_t const>())
+    { }
+
+    /** @brief Construct from the occupied indices, given in any order;
+     *  duplicates are ignored
+     */
+    explicit
+    SparseIndexRange(storage_t indices) {
+      std::sort(indices.begin(), indices.end());
+      indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+      indices_ = std::make_shared<storage_t const>(std::move(indices));
+    }
+
+    SparseIndexRange(std::initializer_list<Integer> indices)
+      : SparseIndexRange(storage_t(indices))
+    { }
+
+    size_t size() const override { return indices_->size(); }
+
+    const_iterator begin() const { return indices_->begin(); }
+    const_iterator end() const { return indices_->end(); }
+
+    bool contains(Integer idx) const {
+      return std::binary_search(indices_->begin(), indices_->end(), idx);
+    }
+
+    /// The index at position `dense_idx` in sorted order (O(1))
+    Integer index_at(std::size_t dense_idx) const {
+      assert(dense_idx < indices_->size());
+      return (*indices_)[dense_idx];
+    }
+
+    /// The position of `idx` in sorted order (O(log n)); `idx` must be in the range
+    std::size_t dense_index_of(Integer idx) const {
+      auto found = std::lower_bound(indices_->begin(), indices_->end(), idx);
+      DARMA_ASSERT_MESSAGE(found != indices_->end() and *found == idx,
+        "Index not found in SparseIndexRange"
+      );
+      return static_cast<std::size_t>(found - indices_->begin());
+    }
+
+    bool is_same(SparseIndexRange const& other) const {
+      return indices_ == other.indices_ or *indices_ == *other.indices_;
+    }
+
+    template <typename ArchiveT>
+    void serialize(ArchiveT& ar) {
+      if(ar.is_unpacking()) {
+        // Packed indices are already sorted and unique
+        auto indices = std::make_shared<storage_t>();
+        ar | *indices;
+        indices_ = std::move(indices);
+      }
+      else {
+        ar | const_cast<storage_t&>(*indices_);
+      }
+    }
+
+};
+
+template <typename Integer = int>
+using SparseRange1D = SparseIndexRange<Integer>;
+
+namespace detail {
+
+template <typename Integer, typename DenseIndex>
+struct SparseIndexMapping {
+  private:
+
+    // Shares the index array with the range it was created from
+    SparseIndexRange<Integer> range_;
+
+  public:
+
+    SparseIndexMapping() = default;
+
+    explicit SparseIndexMapping(SparseIndexRange<Integer> const& rng)
+      : range_(rng)
+    { }
+
+    using is_index_mapping = std::true_type;
+    using from_index_type = Integer;
+    using to_index_type = DenseIndex;
+
+    to_index_type map_forward(from_index_type const& from) const {
+      return static_cast<to_index_type>(range_.dense_index_of(from));
+    }
+
+    from_index_type map_backward(to_index_type const& to) const {
+      return range_.index_at(static_cast<std::size_t>(to));
+    }
+
+    bool
+    is_same(SparseIndexMapping const& other) const {
+      return range_.is_same(other.range_);
+    }
+
+    template <typename ArchiveT> void serialize(ArchiveT& ar) { ar | range_; }
+};
+
+} // end namespace detail
+
+template <typename Integer>
+detail::SparseIndexMapping<Integer>
+get_mapping_to_dense(
+  SparseIndexRange<Integer> const& range
+) {
+  return detail::SparseIndexMapping<Integer>{ range };
+}
+
+} // end namespace darma
+
+#endif //DARMA_IMPL_INDEX_RANGE_SPARSE_RANGE_H
@@ -49,8 +49,15 @@
 
 #if _darma_has_feature(mpi_interop)
 
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
 #include <tinympl/is_instantiation_of.hpp>
 
+#include <darma/utility/darma_assert.h>
+
 #include <darma/interface/backend/mpi_interop.h>
 #include <darma/interface/app/keyword_arguments/index.h>
 #include <darma/interface/app/keyword_arguments/indices.h>
@@ -59,6 +66,8 @@
 #include <darma/interface/app/keyword_arguments/index_range.h>
 #include <darma/interface/app/keyword_arguments/copy_callback.h>
 #include <darma/interface/app/keyword_arguments/copy_back_callback.h>
+#include <darma/interface/app/keyword_arguments/pieces.h>
+#include <darma/interface/app/keyword_arguments/zero_copy.h>
 
 #include <darma/keyword_arguments/parse.h>
 #include <darma/keyword_arguments/macros.h>
@@ -71,6 +80,45 @@ namespace darma {
 
 namespace detail {
 
+// A contiguous range (with data() and size()) of (index, pointer) pairs,
+// e.g., std::vector<std::pair<size_t, ValueType*>>
+template <typename ValueType, typename PiecesT, typename Enable=void>
+struct _is_piecewise_piece_span : std::false_type { };
+
+template <typename ValueType, typename PiecesT>
+struct _is_piecewise_piece_span<ValueType, PiecesT,
+  std::enable_if_t<
+    std::is_integral<
+      std::decay_t<decltype(std::declval<PiecesT&>().data()->first)>
+    >::value
+    and std::is_convertible<
+      decltype(std::declval<PiecesT&>().data()->second), ValueType*
+    >::value
+    and std::is_integral<decltype(std::declval<PiecesT&>().size())>::value
+  >
+> : std::true_type { };
+
+template <typename PiecesT>
+std::vector<darma::backend::piecewise_collection_piece_t>
+_make_backend_piece_span(PiecesT const& pieces, size_t collection_size) {
+  std::vector<darma::backend::piecewise_collection_piece_t> rv;
+  rv.reserve(pieces.size());
+  auto const* piece_data = pieces.data();
+  for(size_t i = 0; i < static_cast<size_t>(pieces.size()); ++i) {
+    // (negative indices wrap around, so they fail this too)
+    DARMA_ASSERT_MESSAGE(
+      static_cast<size_t>(piece_data[i].first) < collection_size,
+      "Piece index " << piece_data[i].first << " is out of range for a"
+        " collection of size " << collection_size
+    );
+    rv.push_back({
+      static_cast<size_t>(piece_data[i].first),
+      static_cast<void*>(piece_data[i].second)
+    });
+  }
+  return rv;
+}
+
 template <typename ValueType>
 struct
 _persistent_collection_creation_impl {
@@ -175,6 +223,93 @@ _persistent_collection_creation_impl {
       return persistent_collection;
     }
 
+    /* index_range keyword version, aliasing the MPI-owned pieces */
+    template <typename IndexRangeT,
+      typename PiecesDeducedT,
+      typename = std::enable_if_t<
+        std::is_base_of<abstract::frontend::IndexRange, std::decay_t<IndexRangeT>>::value
+        and _is_piecewise_piece_span<ValueType, std::decay_t<PiecesDeducedT>>::value
+      >,
+      typename... Args
+    >
+    auto
+    operator()(
+      IndexRangeT&& index_range,
+      PiecesDeducedT&& pieces,
+      variadic_arguments_begin_tag,
+      Args&&... args
+    ) {
+      auto size = index_range.size();
+      return _make_aliased_collection(
+        std::forward<IndexRangeT>(index_range), size, pieces,
+        std::forward<Args>(args)...
+      );
+    }
+
+    /* size keyword version, aliasing the MPI-owned pieces */
+    template <typename PiecesDeducedT,
+      typename = std::enable_if_t<
+        _is_piecewise_piece_span<ValueType, std::decay_t<PiecesDeducedT>>::value
+      >,
+      typename... Args
+    >
+    auto
+    operator()(
+      size_t size,
+      PiecesDeducedT&& pieces,
+      variadic_arguments_begin_tag,
+      Args&&... args
+    ) {
+      return _make_aliased_collection(
+        Range1D<int>(size), size, pieces, std::forward<Args>(args)...
+      );
+    }
+
+  private:
+
+    template <typename IndexRangeDeducedT,
+      typename PiecesT,
+      typename... Args
+    >
+    auto
+    _make_aliased_collection(
+      IndexRangeDeducedT&& index_range,
+      size_t size,
+      PiecesT const& pieces,
+      Args&&... args
+    ) {
+
+      // Create key and handle
+      auto key = _make_key_impl(std::forward<Args>(args)...);
+      auto var_handle = std::make_shared<VariableHandle<ValueType>>(key);
+
+      // Register the MPI buffers as the collection's storage, so that
+      // distributed regions don't need to copy the data in or out
+      auto backend_pieces = _make_backend_piece_span(pieces, size);
+      auto persistent_collection_token =
+        darma::backend::register_aliased_persistent_collection(
+          context_token_,
+          var_handle,
+          size,
+          backend_pieces.data(),
+          backend_pieces.size()
+        );
+
+      // Create a PersistentCollectionHandle object...
+      auto persistent_collection = PersistentCollectionHandle<
+        ValueType, std::decay_t<IndexRangeDeducedT>
+      >(
+        var_handle,
+        std::forward<IndexRangeDeducedT>(index_range),
+        context_token_,
+        persistent_collection_token,
+        /* aliases_mpi_data = */ true
+      );
+
+      // ... and return it
+      return persistent_collection;
+    }
+
   private:
 
     types::runtime_context_token_t context_token_;
@@ -188,6 +323,46 @@ _piecewise_acquired_collection_creation_impl {
 
   private:
 
+    template <typename PiecesDeducedT,
+      typename CopyCallbackT,
+      typename CopyBackCallbackT
+    >
+    void _register_piecewise_collection_piece_span_impl(
+      types::piecewise_collection_token_t collection_token,
+      size_t collection_size,
+      PiecesDeducedT&& pieces,
+      bool zero_copy,
+      CopyCallbackT&& copy_callback,
+      CopyBackCallbackT&& copy_back_callback
+    ) {
+
+      auto copy_fn = std::function<void(void const*, void*)>(
+        std::forward<CopyCallbackT>(copy_callback)
+      );
+      auto copy_back_fn = std::function<void(void const*, void*)>(
+        std::forward<CopyBackCallbackT>(copy_back_callback)
+      );
+
+      DARMA_ASSERT_MESSAGE(not zero_copy or (not copy_fn and not copy_back_fn),
+        "copy_callback and copy_back_callback can't be given along with"
+        " zero_copy=true, since the collection uses the pieces' memory directly"
+      );
+
+      auto backend_pieces = _make_backend_piece_span(pieces, collection_size);
+
+      // Register all of the pieces in one call
+      darma::backend::register_piecewise_collection_pieces(
+        context_token_,
+        collection_token,
+        backend_pieces.data(),
+        backend_pieces.size(),
+        zero_copy,
+        std::move(copy_fn),
+        std::move(copy_back_fn)
+      );
+
+    }
+
     template<typename IndexTupleDeducedT,
       typename DataTupleDeducedT,
       typename CopyCallbackT,
@@ -547,6 +722,125 @@ _piecewise_acquired_collection_creation_impl {
       return piecewise_collection;
     }  
 
+  public:
+
+    /* index_range keyword version */
+    template <typename IndexRangeT,
+      typename PiecesDeducedT,
+      typename CopyCallbackT,
+      typename CopyBackCallbackT,
+      typename = std::enable_if_t<
+        std::is_base_of<abstract::frontend::IndexRange, std::decay_t<IndexRangeT>>::value
+        and _is_piecewise_piece_span<ValueType, std::decay_t<PiecesDeducedT>>::value
+      >,
+      typename FirstArg,
+      typename... LastArgs
+    >
+    auto
+    operator()(
+      IndexRangeT&& index_range,
+      PiecesDeducedT&& pieces,
+      bool zero_copy,
+      CopyCallbackT&& copy_callback,
+      CopyBackCallbackT&& copy_back_callback,
+      variadic_arguments_begin_tag,
+      FirstArg&& arg,
+      LastArgs&&... args
+    ) {
+
+      // Create key and handle
+      auto key = make_key(std::forward<FirstArg>(arg), std::forward<LastArgs>(args)...);
+      auto var_handle = std::make_shared<VariableHandle<ValueType>>(key);
+
+      // Register handle with the backend as part of a piecewise collection
+      auto const size = index_range.size();
+      auto collection_token = darma::backend::register_piecewise_collection(
+        context_token_,
+        var_handle,
+        size
+      );
+
+      // Create a PiecewiseCollectionHandle object
+      auto piecewise_collection = PiecewiseCollectionHandle<ValueType, std::decay_t<IndexRangeT>>(
+        var_handle,
+        std::forward<IndexRangeT>(index_range),
+        context_token_,
+        collection_token
+      );
+
+      // Call private helper method to register the piecewise collection pieces
+      _register_piecewise_collection_piece_span_impl(
+        collection_token,
+        size,
+        std::forward<PiecesDeducedT>(pieces),
+        zero_copy,
+        std::forward<CopyCallbackT>(copy_callback),
+        std::forward<CopyBackCallbackT>(copy_back_callback)
+      );
+
+      // Return the PiecewiseCollectionHandle created above
+      return piecewise_collection;
+    }
+
+
+    /* size keyword version */
+    template <typename PiecesDeducedT,
+      typename CopyCallbackT,
+      typename CopyBackCallbackT,
+      typename = std::enable_if_t<
+        _is_piecewise_piece_span<ValueType, std::decay_t<PiecesDeducedT>>::value
+      >,
+      typename FirstArg,
+      typename... LastArgs
+    >
+    auto
+    operator()(
+      size_t size,
+      PiecesDeducedT&& pieces,
+      bool zero_copy,
+      CopyCallbackT&& copy_callback,
+      CopyBackCallbackT&& copy_back_callback,
+      variadic_arguments_begin_tag,
+      FirstArg&& arg,
+      LastArgs&&... args
+    ) {
+
+      // Create key and handle
+      auto key = make_key(std::forward<FirstArg>(arg), std::forward<LastArgs>(args)...);
+      auto var_handle = std::make_shared<VariableHandle<ValueType>>(key);
+
+      // Register handle with the backend as part of a piecewise collection
+      auto collection_token = darma::backend::register_piecewise_collection(
+        context_token_,
+        var_handle,
+        size
+      );
+
+      // Create a one-dimension index range
+      auto index_range = Range1D<int>(size);
+
+      // Create a PiecewiseCollectionHandle object
+      auto piecewise_collection = PiecewiseCollectionHandle<ValueType, Range1D<int>>(
+        var_handle,
+        index_range,
+        context_token_,
+        collection_token
+      );
+
+      // Call private helper method to register the piecewise collection pieces
+      _register_piecewise_collection_piece_span_impl(
+        collection_token,
+        size,
+        std::forward<PiecesDeducedT>(pieces),
+        zero_copy,
+        std::forward<CopyCallbackT>(copy_callback),
+        std::forward<CopyBackCallbackT>(copy_back_callback)
+      );
+
+      // Return the PiecewiseCollectionHandle created above
+      return piecewise_collection;
+    }
+
   private:
  
     types::runtime_context_token_t context_token_;
@@ -583,6 +877,8 @@ class mpi_context {
       using darma::keyword_tags_for_create_concurrent_work::index_range;
       using darma::keyword_tags_for_mpi_context::copy_callback;
       using darma::keyword_tags_for_mpi_context::copy_back_callback;
+      using darma::keyword_tags_for_mpi_context::pieces;
+      using darma::keyword_tags_for_mpi_context::zero_copy;
 
       using parser = kwarg_parser<
         variadic_positional_overload_description<
@@ -618,6 +914,21 @@ class mpi_context {
           _keyword<converted_parameter, indices>,
           _optional_keyword<deduced_parameter, copy_callback>,
           _optional_keyword<deduced_parameter, copy_back_callback>
+        >,
+        // Runtime-sized (index, pointer) pieces, registered in one call
+        variadic_positional_overload_description<
+          _keyword<deduced_parameter, index_range>,
+          _keyword<deduced_parameter, pieces>,
+          _optional_keyword<bool, zero_copy>,
+          _optional_keyword<deduced_parameter, copy_callback>,
+          _optional_keyword<deduced_parameter, copy_back_callback>
+        >,
+        variadic_positional_overload_description<
+          _keyword<size_t, size>,
+          _keyword<deduced_parameter, pieces>,
+          _optional_keyword<bool, zero_copy>,
+          _optional_keyword<deduced_parameter, copy_callback>,
+          _optional_keyword<deduced_parameter, copy_back_callback>
         >
       >;
       using _______________see_calling_context_on_next_line________________ = typename parser::template static_assert_valid_invocation<Args...>;
@@ -626,7 +937,8 @@ class mpi_context {
       return parser()
         .with_default_generators(
           keyword_arguments_for_mpi_context::copy_callback=_default_callback{},
-          keyword_arguments_for_mpi_context::copy_back_callback=_default_callback{}
+          keyword_arguments_for_mpi_context::copy_back_callback=_default_callback{},
+          keyword_arguments_for_mpi_context::zero_copy=[]{ return false; }
         )
         .with_converters(
           [](auto&&... data_parts) {
@@ -648,6 +960,7 @@ class mpi_context {
 
       using namespace darma::detail;
       using darma::keyword_tags_for_mpi_context::size;
+      using darma::keyword_tags_for_mpi_context::pieces;
       using darma::keyword_tags_for_create_concurrent_work::index_range;
 
       using parser = kwarg_parser<
@@ -656,6 +969,16 @@ class mpi_context {
         >,
         variadic_positional_overload_description<
           _keyword<size_t, size>
+        >,
+        // Zero-copy versions, using the (index, pointer) pieces owned by this
+        // rank as the collection's data
+        variadic_positional_overload_description<
+          _keyword<deduced_parameter, index_range>,
+          _keyword<deduced_parameter, pieces>
+        >,
+        variadic_positional_overload_description<
+          _keyword<size_t, size>,
+          _keyword<deduced_parameter, pieces>
         >
       >;
       using _______________see_calling_context_on_next_line________________ = typename parser::template static_assert_valid_invocation<Args...>;
@@ -98,11 +98,13 @@ class PersistentCollectionHandle {
       std::shared_ptr<detail::VariableHandle<ValueType>> const& var_handle,
       IndexRangeDeducedT range,
       types::runtime_context_token_t context_token,
-      types::persistent_collection_token_t collection_token
+      types::persistent_collection_token_t collection_token,
+      bool aliases_mpi_data = false
     ) : var_handle_(var_handle),
         range_(std::forward<IndexRangeDeducedT>(range)), 
         context_token_(context_token),
-        collection_token_(collection_token) 
+        collection_token_(collection_token),
+        aliases_mpi_data_(aliases_mpi_data)
     {
 
       // TODO: change flow relationships
@@ -140,6 +142,14 @@ class PersistentCollectionHandle {
        );
     }
     
+  public:
+
+    /** @brief Whether the collection's data is the MPI-owned memory of this
+     *  rank's pieces (i.e., it was created with `pieces=`), so that
+     *  distributed regions don't copy it in or out
+     */
+    bool aliases_mpi_data() const { return aliases_mpi_data_; }
+
   public:
 
     access_handle_collection_t collection() {
@@ -160,6 +170,8 @@ class PersistentCollectionHandle {
     mutable types::runtime_context_token_t context_token_;
     mutable types::persistent_collection_token_t collection_token_;
 
+    bool aliases_mpi_data_ = false;
+
 };
 
 } // end namespace darma
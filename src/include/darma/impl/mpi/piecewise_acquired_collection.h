@@ -49,9 +49,15 @@
 
 #if _darma_has_feature(mpi_interop)
 
+#include <functional>
+#include <memory>
+
+#include <darma/utility/darma_assert.h>
+
 #include <darma/interface/app/keyword_arguments/index.h>
 #include <darma/interface/app/keyword_arguments/copy_callback.h>
 #include <darma/interface/app/keyword_arguments/copy_back_callback.h>
+#include <darma/interface/app/keyword_arguments/zero_copy.h>
 
 #include <darma/keyword_arguments/parse.h>
 #include <darma/keyword_arguments/macros.h>
@@ -74,9 +80,11 @@ _piecewise_collection_handle_impl {
  
     _piecewise_collection_handle_impl(
       types::runtime_context_token_t context_token,
-      types::piecewise_collection_token_t collection_token
+      types::piecewise_collection_token_t collection_token,
+      size_t collection_size
     ) : context_token_(context_token),
-        collection_token_(collection_token)
+        collection_token_(collection_token),
+        collection_size_(collection_size)
     { }
 
   public:
@@ -92,6 +100,7 @@ _piecewise_collection_handle_impl {
       variadic_arguments_begin_tag, 
       ValueType& data
     ) { 
+      _assert_index_in_range(index);
       darma::backend::register_piecewise_collection_piece(
         context_token_,
         collection_token_,
@@ -102,10 +111,64 @@ _piecewise_collection_handle_impl {
       );
     }
 
+    template<
+      typename CopyCallbackT,
+      typename CopyBackCallbackT
+    >
+    void operator()(
+      size_t index,
+      CopyCallbackT&& copy_callback,
+      CopyBackCallbackT&& copy_back_callback,
+      bool zero_copy,
+      variadic_arguments_begin_tag,
+      ValueType& data
+    ) {
+      if(not zero_copy) {
+        (*this)(index,
+          std::forward<CopyCallbackT>(copy_callback),
+          std::forward<CopyBackCallbackT>(copy_back_callback),
+          variadic_arguments_begin_tag{},
+          data
+        );
+        return;
+      }
+
+      DARMA_ASSERT_MESSAGE(
+        not std::function<void(void const*, void*)>(
+          std::forward<CopyCallbackT>(copy_callback)
+        ) and not std::function<void(void const*, void*)>(
+          std::forward<CopyBackCallbackT>(copy_back_callback)
+        ),
+        "copy_callback and copy_back_callback can't be given along with"
+        " zero_copy=true, since the collection uses the piece's memory directly"
+      );
+
+      _assert_index_in_range(index);
+
+      // Alias the MPI-owned memory rather than copying into and out of it
+      darma::backend::piecewise_collection_piece_t piece = {
+        index, static_cast<void*>(std::addressof(data))
+      };
+      darma::backend::register_piecewise_collection_pieces(
+        context_token_,
+        collection_token_,
+        &piece, 1,
+        /* zero_copy = */ true
+      );
+    }
+
   private:
+
+    void _assert_index_in_range(size_t index) const {
+      DARMA_ASSERT_MESSAGE(index < collection_size_,
+        "Piece index " << index << " is out of range for a collection of size "
+          << collection_size_
+      );
+    }
  
     mutable types::runtime_context_token_t context_token_;
     mutable types::piecewise_collection_token_t collection_token_;
+    size_t collection_size_;
 
 };
 
@@ -194,12 +257,14 @@ class PiecewiseCollectionHandle {
       using darma::keyword_tags_for_mpi_context::index;
       using darma::keyword_tags_for_mpi_context::copy_callback;
       using darma::keyword_tags_for_mpi_context::copy_back_callback;
+      using darma::keyword_tags_for_mpi_context::zero_copy;
 
       using parser = kwarg_parser<
         variadic_positional_overload_description<
           _keyword<size_t, index>,
           _optional_keyword<deduced_parameter, copy_callback>,
-          _optional_keyword<deduced_parameter, copy_back_callback>
+          _optional_keyword<deduced_parameter, copy_back_callback>,
+          _optional_keyword<bool, zero_copy>
         >
       >;
       using _______________see_calling_context_on_next_line________________ = typename parser::template static_assert_valid_invocation<Args...>;
@@ -207,10 +272,13 @@ class PiecewiseCollectionHandle {
       parser()
         .with_default_generators(
           keyword_arguments_for_piecewise_handle::copy_callback=_default_callback{},
-          keyword_arguments_for_piecewise_handle::copy_back_callback=_default_callback{}
+          keyword_arguments_for_piecewise_handle::copy_back_callback=_default_callback{},
+          keyword_arguments_for_piecewise_handle::zero_copy=[]{ return false; }
         )
         .parse_args(std::forward<Args>(args)...)
-        .invoke(detail::_piecewise_collection_handle_impl<ValueType>(context_token_, collection_token_));
+        .invoke(detail::_piecewise_collection_handle_impl<ValueType>(
+          context_token_, collection_token_, range_.size()
+        ));
     }
 
   public:
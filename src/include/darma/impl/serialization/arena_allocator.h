@@ -0,0 +1,247 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                      arena_allocator.h
+//                         DARMA
+//              Copyright (C) 2017 NTESS, LLC
+//
+// Under the terms of Contract DE-NA-0003525 with NTESS, LLC,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact darma@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef DARMA_IMPL_SERIALIZATION_ARENA_ALLOCATOR_H
+#define DARMA_IMPL_SERIALIZATION_ARENA_ALLOCATOR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+#include <darma/interface/backend/serialization_policy.h>
+
+namespace darma {
+namespace serialization {
+
+namespace detail {
+
+// The arena that default-constructed ArenaAllocators on this thread bind to
+inline abstract::backend::UnpackArena*&
+current_unpack_arena() {
+  static thread_local abstract::backend::UnpackArena* arena = nullptr;
+  return arena;
+}
+
+/** @internal
+ *  @brief Makes `arena` the current unpack arena for the calling thread for
+ *  the lifetime of the guard
+ */
+class ScopedUnpackArena {
+  public:
+
+    explicit
+    ScopedUnpackArena(abstract::backend::UnpackArena* arena)
+      : previous_(current_unpack_arena())
+    {
+      current_unpack_arena() = arena;
+    }
+
+    ScopedUnpackArena(ScopedUnpackArena const&) = delete;
+    ScopedUnpackArena& operator=(ScopedUnpackArena const&) = delete;
+
+    ~ScopedUnpackArena() { current_unpack_arena() = previous_; }
+
+  private:
+
+    abstract::backend::UnpackArena* previous_;
+};
+
+} // end namespace detail
+
+/** @brief A standard-library-compatible allocator that takes its storage from
+ *  the backend's unpack arena, if there is one.
+ *
+ *  Use it as the allocator of the containers inside a type (e.g.,
+ *  `std::vector<double, ArenaAllocator<double>>`) so that, when the backend
+ *  unpacks objects of that type with
+ *  SerializationManager::unpack_data_into_arena(), the containers'
+ *  elements all come from a single backend-provided arena.  This works
+ *  because a *default-constructed* ArenaAllocator binds to the calling
+ *  thread's current unpack arena (see the default constructor); one
+ *  default-constructed anywhere else (i.e., outside of an unpack into an
+ *  arena) just uses the heap.
+ *
+ *  The binding is kept by move construction of a container, but not by copy
+ *  construction (a copy always uses the heap, so that, e.g., copying the
+ *  value out of an unpacked object doesn't tie the copy to the arena), nor
+ *  is it propagated by assignment or swap, so assigning an unpacked
+ *  container to a long-lived one copies or moves the elements into the
+ *  long-lived container's storage.  As with any allocator that doesn't
+ *  propagate on swap, containers bound to different arenas must not be
+ *  swapped.
+ */
+template <typename T>
+class ArenaAllocator {
+  public:
+
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::false_type;
+    using propagate_on_container_swap = std::false_type;
+
+    /** @brief Binds to the calling thread's current unpack arena, which is
+     *  the backend's arena during SerializationManager::unpack_data_into_arena()
+     *  and null (i.e., the heap) everywhere else.
+     *
+     *  Use ArenaAllocator(nullptr) for an allocator that always uses the heap.
+     */
+    ArenaAllocator() noexcept
+      : arena_(detail::current_unpack_arena())
+    { }
+
+    /** @brief Binds to `arena`, or to the heap if `arena` is null */
+    explicit
+    ArenaAllocator(abstract::backend::UnpackArena* arena) noexcept
+      : arena_(arena)
+    { }
+
+    template <typename U>
+    ArenaAllocator(ArenaAllocator<U> const& other) noexcept
+      : arena_(other.arena())
+    { }
+
+    // So that serializers that rebind the archive's allocator still get the
+    // current arena
+    template <typename U>
+    ArenaAllocator(std::allocator<U> const&) noexcept
+      : ArenaAllocator()
+    { }
+
+    T*
+    allocate(std::size_t n) {
+      if(arena_ != nullptr) {
+        return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T)));
+      }
+      return std::allocator<T>{}.allocate(n);
+    }
+
+    void
+    deallocate(T* ptr, std::size_t n) {
+      if(arena_ != nullptr) {
+        arena_->deallocate(ptr, n * sizeof(T));
+      }
+      else {
+        std::allocator<T>{}.deallocate(ptr, n);
+      }
+    }
+
+    // Copies of a container must be able to outlive the arena
+    ArenaAllocator
+    select_on_container_copy_construction() const {
+      return ArenaAllocator(nullptr);
+    }
+
+    abstract::backend::UnpackArena* arena() const { return arena_; }
+
+  private:
+
+    abstract::backend::UnpackArena* arena_;
+};
+
+template <typename T, typename U>
+bool operator==(ArenaAllocator<T> const& a, ArenaAllocator<U> const& b) {
+  return a.arena() == b.arena();
+}
+
+template <typename T, typename U>
+bool operator!=(ArenaAllocator<T> const& a, ArenaAllocator<U> const& b) {
+  return a.arena() != b.arena();
+}
+
+/** @brief A simple UnpackArena that hands out memory from large chunks and
+ *  frees it all at once when it is destroyed
+ *
+ *  Backends can use one of these per received message (or per handle) to
+ *  turn the many small allocations of unpacking into a single one.
+ */
+class MonotonicUnpackArena
+  : public abstract::backend::UnpackArena
+{
+  public:
+
+    explicit
+    MonotonicUnpackArena(std::size_t chunk_size = 64 * 1024)
+      : chunk_size_(chunk_size)
+    { }
+
+    MonotonicUnpackArena(MonotonicUnpackArena const&) = delete;
+    MonotonicUnpackArena& operator=(MonotonicUnpackArena const&) = delete;
+
+    void*
+    allocate(std::size_t n_bytes, std::size_t alignment) override {
+      auto const align_up = [alignment](std::uintptr_t ptr) {
+        return (ptr + alignment - 1) & ~(std::uintptr_t(alignment) - 1);
+      };
+      auto base = chunks_.empty() ? std::uintptr_t(0)
+        : reinterpret_cast<std::uintptr_t>(chunks_.back().get());
+      auto rv = align_up(base + used_);
+      if(chunks_.empty() or rv + n_bytes > base + current_size_) {
+        current_size_ = std::max(chunk_size_, n_bytes + alignment);
+        chunks_.emplace_back(new char[current_size_]);
+        base = reinterpret_cast<std::uintptr_t>(chunks_.back().get());
+        rv = align_up(base);
+      }
+      used_ = rv + n_bytes - base;
+      return reinterpret_cast<void*>(rv);
+    }
+
+    /// The number of times the arena itself had to allocate
+    std::size_t n_chunks() const { return chunks_.size(); }
+
+  private:
+
+    std::size_t chunk_size_;
+    std::size_t current_size_ = 0;
+    std::size_t used_ = 0;
+    std::vector<std::unique_ptr<char[]>> chunks_;
+};
+
+} // end namespace serialization
+} // end namespace darma
+
+#endif //DARMA_IMPL_SERIALIZATION_ARENA_ALLOCATOR_H
@@ -0,0 +1,515 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                      compression.h
+//                         DARMA
+//              Copyright (C) 2017 NTESS, LLC
+//
+// Under the terms of Contract DE-NA-0003525 with NTESS, LLC,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact darma@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef DARMA_IMPL_SERIALIZATION_COMPRESSION_H
+#define DARMA_IMPL_SERIALIZATION_COMPRESSION_H
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <darma/interface/app/serialization_traits.h>
+#include <darma/interface/backend/serialization_policy.h>
+#include <darma/utility/darma_assert.h>
+
+namespace darma {
+namespace serialization {
+
+namespace detail {
+
+//==============================================================================
+// <editor-fold desc="LZ codec"> {{{1
+
+// A small LZ77-family byte codec in the style of LZ4: a sequence of tokens,
+// each giving a run of literals followed by a back-reference (2-byte offset,
+// minimum length 4) into the already-decoded output.  Favors speed over
+// ratio; the decoder needs to know the decoded size.
+
+namespace _lz {
+
+static constexpr size_t min_match = 4;
+// The last few bytes are always emitted as literals, so that match
+// extension never has to check for the end of the input
+static constexpr size_t last_literals = 5;
+static constexpr size_t max_offset = 65535;
+static constexpr int hash_log = 12;
+
+inline uint32_t
+read32(uint8_t const* p) {
+  uint32_t rv;
+  std::memcpy(&rv, p, sizeof(uint32_t));
+  return rv;
+}
+
+inline uint32_t
+hash(uint32_t seq) {
+  return (seq * 2654435761u) >> (32 - hash_log);
+}
+
+inline void
+write_length(std::vector<char>& out, size_t len) {
+  while(len >= 255) {
+    out.push_back(char(255));
+    len -= 255;
+  }
+  out.push_back(char(len));
+}
+
+inline void
+write_sequence(
+  std::vector<char>& out,
+  uint8_t const* literals, size_t n_literals,
+  size_t offset, size_t match_length /* 0 for the last sequence */
+) {
+  auto const lit_nibble = n_literals < 15 ? n_literals : 15;
+  auto const match_extra = match_length == 0 ? 0 : match_length - min_match;
+  auto const match_nibble = match_extra < 15 ? match_extra : 15;
+  out.push_back(char((lit_nibble << 4) | match_nibble));
+  if(lit_nibble == 15) write_length(out, n_literals - 15);
+  out.insert(out.end(), literals, literals + n_literals);
+  if(match_length != 0) {
+    out.push_back(char(offset & 0xFF));
+    out.push_back(char((offset >> 8) & 0xFF));
+    if(match_nibble == 15) write_length(out, match_extra - 15);
+  }
+}
+
+inline size_t
+read_length(uint8_t const*& ip, uint8_t const* end) {
+  size_t len = 0;
+  uint8_t b;
+  do {
+    DARMA_ASSERT_MESSAGE(ip < end, "corrupt compressed data");
+    b = *ip++;
+    len += b;
+  } while(b == 255);
+  return len;
+}
+
+} // end namespace _lz
+
+/** Appends the compressed form of `n_bytes` bytes at `src` to `out` */
+inline void
+lz_compress(void const* src, size_t n_bytes, std::vector<char>& out) {
+  using namespace _lz;
+  auto const* const begin = static_cast<uint8_t const*>(src);
+  auto const* const end = begin + n_bytes;
+  auto const* anchor = begin;
+  auto const* ip = begin;
+
+  if(n_bytes > min_match + last_literals) {
+    auto const* const match_limit = end - last_literals;
+    std::vector<int64_t> table(size_t(1) << hash_log, -1);
+    while(ip + min_match <= match_limit) {
+      auto const seq = read32(ip);
+      auto& slot = table[hash(seq)];
+      auto const ref = slot;
+      slot = ip - begin;
+      if(ref >= 0 and size_t(ip - (begin + ref)) <= max_offset
+        and read32(begin + ref) == seq
+      ) {
+        auto const* match = begin + ref;
+        size_t len = min_match;
+        while(ip + len < match_limit and match[len] == ip[len]) ++len;
+        write_sequence(out, anchor, ip - anchor, ip - match, len);
+        ip += len;
+        anchor = ip;
+      }
+      else {
+        ++ip;
+      }
+    }
+  }
+  if(end != anchor) {
+    write_sequence(out, anchor, end - anchor, 0, 0);
+  }
+}
+
+/** Decompresses `n_src` bytes at `src` into exactly `n_dest` bytes at `dest` */
+inline void
+lz_decompress(
+  void const* src, size_t n_src,
+  void* dest, size_t n_dest
+) {
+  using namespace _lz;
+  auto const* ip = static_cast<uint8_t const*>(src);
+  auto const* const ip_end = ip + n_src;
+  auto* op = static_cast<uint8_t*>(dest);
+  auto* const op_begin = op;
+  auto* const op_end = op + n_dest;
+
+  while(op < op_end) {
+    DARMA_ASSERT_MESSAGE(ip < ip_end, "corrupt compressed data");
+    uint8_t const token = *ip++;
+    size_t n_literals = token >> 4;
+    if(n_literals == 15) n_literals += read_length(ip, ip_end);
+    DARMA_ASSERT_MESSAGE(
+      n_literals <= size_t(ip_end - ip) and n_literals <= size_t(op_end - op),
+      "corrupt compressed data"
+    );
+    std::memcpy(op, ip, n_literals);
+    ip += n_literals;
+    op += n_literals;
+    if(op == op_end) break;
+
+    DARMA_ASSERT_MESSAGE(ip + 2 <= ip_end, "corrupt compressed data");
+    size_t const offset = size_t(ip[0]) | (size_t(ip[1]) << 8);
+    ip += 2;
+    size_t match_length = token & 0xF;
+    if(match_length == 15) match_length += read_length(ip, ip_end);
+    match_length += min_match;
+    DARMA_ASSERT_MESSAGE(
+      offset != 0 and offset <= size_t(op - op_begin)
+        and match_length <= size_t(op_end - op),
+      "corrupt compressed data"
+    );
+    // byte by byte, since the match may overlap the output
+    auto const* match = op - offset;
+    for(size_t i = 0; i < match_length; ++i) op[i] = match[i];
+    op += match_length;
+  }
+}
+
+// </editor-fold> end LZ codec }}}1
+//==============================================================================
+
+//==============================================================================
+// <editor-fold desc="float delta encoding"> {{{1
+
+// A lossless transform for arrays of smoothly varying floating point values:
+// each word is XORed with its predecessor (so that sign, exponent, and
+// leading mantissa bits mostly become zero), and then the bytes are
+// transposed so that bytes of equal significance are adjacent.  Any trailing
+// partial word is left as is.
+
+template <size_t WordSize>
+inline void
+float_delta_encode(void const* src, size_t n_bytes, void* dest) {
+  auto const* in = static_cast<uint8_t const*>(src);
+  auto* out = static_cast<uint8_t*>(dest);
+  size_t const n_words = n_bytes / WordSize;
+  uint8_t prev[WordSize] = { };
+  for(size_t i = 0; i < n_words; ++i) {
+    for(size_t b = 0; b < WordSize; ++b) {
+      uint8_t const cur = in[i * WordSize + b];
+      out[b * n_words + i] = cur ^ prev[b];
+      prev[b] = cur;
+    }
+  }
+  std::memcpy(out + n_words * WordSize, in + n_words * WordSize,
+    n_bytes - n_words * WordSize
+  );
+}
+
+template <size_t WordSize>
+inline void
+float_delta_decode(void const* src, size_t n_bytes, void* dest) {
+  auto const* in = static_cast<uint8_t const*>(src);
+  auto* out = static_cast<uint8_t*>(dest);
+  size_t const n_words = n_bytes / WordSize;
+  uint8_t prev[WordSize] = { };
+  for(size_t i = 0; i < n_words; ++i) {
+    for(size_t b = 0; b < WordSize; ++b) {
+      prev[b] ^= in[b * n_words + i];
+      out[i * WordSize + b] = prev[b];
+    }
+  }
+  std::memcpy(out + n_words * WordSize, in + n_words * WordSize,
+    n_bytes - n_words * WordSize
+  );
+}
+
+// </editor-fold> end float delta encoding }}}1
+//==============================================================================
+
+} // end namespace detail
+
+/** @brief Statistics gathered by a CompressingSerializationPolicy, for
+ *  deciding whether compression pays off for a given kind of payload
+ */
+struct CompressionStats {
+  size_t n_blobs_packed = 0;
+  size_t n_blobs_unpacked = 0;
+  /// Uncompressed bytes handed to the policy for packing
+  size_t bytes_in = 0;
+  /// Bytes actually placed in pack buffers (including per-blob headers)
+  size_t bytes_out = 0;
+  /// Uncompressed bytes produced when unpacking
+  size_t bytes_unpacked = 0;
+  double compress_seconds = 0.0;
+  double decompress_seconds = 0.0;
+
+  /// Uncompressed size over packed size (> 1 means compression helped)
+  double
+  ratio() const {
+    return bytes_out == 0 ? 1.0 : double(bytes_in) / double(bytes_out);
+  }
+
+  /// Uncompressed bytes processed per second when packing
+  double
+  compress_throughput() const {
+    return compress_seconds == 0.0 ? 0.0 : double(bytes_in) / compress_seconds;
+  }
+
+  /// Uncompressed bytes produced per second when unpacking
+  double
+  decompress_throughput() const {
+    return decompress_seconds == 0.0 ?
+      0.0 : double(bytes_unpacked) / decompress_seconds;
+  }
+};
+
+/** @brief A SerializationPolicy that compresses the contiguous payloads (see
+ *  SerializationManagerForType) that it is asked to pack.
+ *
+ *  Each blob is written as a one byte codec tag, the size of the compressed
+ *  payload, and the payload.  Blobs that don't shrink are stored as is.  The
+ *  same (kind of) policy must be used to unpack.
+ *
+ *  The policy keeps no state between the sizing and packing of a blob, so
+ *  going through packed_size_contribution_for_blob() and pack_blob()
+ *  compresses it twice.  Callers that can hold on to the compressed bytes
+ *  in between should use compress_blob() and pack_compressed_blob() instead.
+ */
+class CompressingSerializationPolicy
+  : public abstract::backend::SerializationPolicy
+{
+  private:
+
+    enum class _codec : uint8_t {
+      Stored = 0, LZ = 1, Delta32LZ = 2, Delta64LZ = 3
+    };
+
+    using _clock_t = std::chrono::steady_clock;
+
+    static constexpr size_t _header_size = 1 + sizeof(uint64_t);
+
+    CompressionMode mode_;
+
+    mutable std::mutex mutex_;
+    mutable CompressionStats stats_;
+
+    _codec
+    _codec_for_mode() const {
+      switch(mode_) {
+        case CompressionMode::LZ: return _codec::LZ;
+        case CompressionMode::FloatDeltaLZ: return _codec::Delta32LZ;
+        case CompressionMode::DoubleDeltaLZ: return _codec::Delta64LZ;
+        default: return _codec::Stored;
+      }
+    }
+
+    // Untimed, so that sizing a blob doesn't count toward compress_seconds
+    std::vector<char>
+    _compress(void const* data_begin, size_t n_bytes) const {
+      auto codec = _codec_for_mode();
+      std::vector<char> rv(_header_size);
+      if(codec == _codec::LZ) {
+        detail::lz_compress(data_begin, n_bytes, rv);
+      }
+      else if(codec != _codec::Stored) {
+        std::vector<char> transformed(n_bytes);
+        if(codec == _codec::Delta32LZ) {
+          detail::float_delta_encode<4>(data_begin, n_bytes, transformed.data());
+        }
+        else {
+          detail::float_delta_encode<8>(data_begin, n_bytes, transformed.data());
+        }
+        detail::lz_compress(transformed.data(), n_bytes, rv);
+      }
+      if(codec == _codec::Stored or rv.size() - _header_size >= n_bytes) {
+        codec = _codec::Stored;
+        rv.resize(_header_size);
+        auto const* src = static_cast<char const*>(data_begin);
+        rv.insert(rv.end(), src, src + n_bytes);
+      }
+      rv[0] = char(codec);
+      uint64_t const payload_size = rv.size() - _header_size;
+      std::memcpy(rv.data() + 1, &payload_size, sizeof(uint64_t));
+      return rv;
+    }
+
+  public:
+
+    explicit
+    CompressingSerializationPolicy(
+      CompressionMode mode = CompressionMode::LZ
+    ) : mode_(mode)
+    { }
+
+    // Copies start out with empty statistics
+    CompressingSerializationPolicy(CompressingSerializationPolicy const& other)
+      : mode_(other.mode_)
+    { }
+
+    CompressingSerializationPolicy&
+    operator=(CompressingSerializationPolicy const& other) {
+      mode_ = other.mode_;
+      reset_stats();
+      return *this;
+    }
+
+    CompressionMode mode() const { return mode_; }
+
+    CompressionStats
+    stats() const {
+      std::lock_guard<std::mutex> lg(mutex_);
+      return stats_;
+    }
+
+    void
+    reset_stats() {
+      std::lock_guard<std::mutex> lg(mutex_);
+      stats_ = CompressionStats{};
+    }
+
+    /** @brief Returns the packed form (header and payload) of `n_bytes`
+     *  bytes at `data_begin`; its size is the blob's packed size contribution
+     */
+    std::vector<char>
+    compress_blob(void const* data_begin, size_t n_bytes) const {
+      auto const start = _clock_t::now();
+      auto rv = _compress(data_begin, n_bytes);
+      std::chrono::duration<double> elapsed = _clock_t::now() - start;
+      {
+        std::lock_guard<std::mutex> lg(mutex_);
+        stats_.compress_seconds += elapsed.count();
+      }
+      return rv;
+    }
+
+    /** @brief Packs the result of compress_blob() for `n_bytes` uncompressed
+     *  bytes, as pack_blob() would
+     */
+    void
+    pack_compressed_blob(
+      void*& indirect_pack_buffer,
+      std::vector<char> const& compressed,
+      std::size_t n_bytes
+    ) const {
+      std::memcpy(indirect_pack_buffer, compressed.data(), compressed.size());
+      reinterpret_cast<char*&>(indirect_pack_buffer) += compressed.size();
+
+      std::lock_guard<std::mutex> lg(mutex_);
+      ++stats_.n_blobs_packed;
+      stats_.bytes_in += n_bytes;
+      stats_.bytes_out += compressed.size();
+    }
+
+    std::size_t
+    packed_size_contribution_for_blob(
+      void const* data_begin, std::size_t n_bytes
+    ) const override {
+      return _compress(data_begin, n_bytes).size();
+    }
+
+    void
+    pack_blob(
+      void*& indirect_pack_buffer,
+      void const* data_begin,
+      std::size_t n_bytes
+    ) const override {
+      pack_compressed_blob(
+        indirect_pack_buffer, compress_blob(data_begin, n_bytes), n_bytes
+      );
+    }
+
+    void
+    unpack_blob(
+      void*& indirect_packed_buffer,
+      void* dest,
+      std::size_t n_bytes
+    ) const override {
+      auto const start = _clock_t::now();
+      auto const* buffer = static_cast<char const*>(indirect_packed_buffer);
+      auto const codec = _codec(buffer[0]);
+      uint64_t payload_size = 0;
+      std::memcpy(&payload_size, buffer + 1, sizeof(uint64_t));
+      auto const* payload = buffer + _header_size;
+      switch(codec) {
+        case _codec::Stored: {
+          DARMA_ASSERT_EQUAL(payload_size, n_bytes);
+          std::memcpy(dest, payload, n_bytes);
+          break;
+        }
+        case _codec::LZ: {
+          detail::lz_decompress(payload, payload_size, dest, n_bytes);
+          break;
+        }
+        case _codec::Delta32LZ:
+        case _codec::Delta64LZ: {
+          std::vector<char> transformed(n_bytes);
+          detail::lz_decompress(
+            payload, payload_size, transformed.data(), n_bytes
+          );
+          if(codec == _codec::Delta32LZ) {
+            detail::float_delta_decode<4>(transformed.data(), n_bytes, dest);
+          }
+          else {
+            detail::float_delta_decode<8>(transformed.data(), n_bytes, dest);
+          }
+          break;
+        }
+        default: {
+          DARMA_ASSERT_MESSAGE(false, "unknown codec in compressed blob");
+        }
+      }
+      reinterpret_cast<char*&>(indirect_packed_buffer) +=
+        _header_size + payload_size;
+      std::chrono::duration<double> elapsed = _clock_t::now() - start;
+      std::lock_guard<std::mutex> lg(mutex_);
+      ++stats_.n_blobs_unpacked;
+      stats_.bytes_unpacked += n_bytes;
+      stats_.decompress_seconds += elapsed.count();
+    }
+
+};
+
+} // end namespace serialization
+} // end namespace darma
+
+#endif //DARMA_IMPL_SERIALIZATION_COMPRESSION_H
@@ -0,0 +1,227 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                      lazy_unpacked.h
+//                         DARMA
+//              Copyright (C) 2017 NTESS, LLC
+//
+// Under the terms of Contract DE-NA-0003525 with NTESS, LLC,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact darma@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef DARMA_IMPL_SERIALIZATION_LAZY_UNPACKED_H
+#define DARMA_IMPL_SERIALIZATION_LAZY_UNPACKED_H
+
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <darma/interface/app/serialization_traits.h>
+#include <darma/impl/serialization/manager.h>
+
+namespace darma {
+
+namespace serialization {
+
+namespace detail {
+
+/** @internal
+ *  @brief Storage for a migrated (functor) task argument that is only
+ *  deserialized when the task first reads it.
+ *
+ *  Until get() is called, the argument is held as its packed bytes.  If the
+ *  task migrates again before that, the bytes are forwarded as-is, without
+ *  being unpacked and re-packed.  Packing and unpacking of the value itself
+ *  goes through a SerializationManagerForType<T>, exactly as for handle data.
+ */
+template <typename T>
+class LazyUnpacked {
+  private:
+
+    static constexpr auto _unknown_size = std::numeric_limits<std::size_t>::max();
+
+    static SerializationManagerForType<T> const&
+    _manager() {
+      static const SerializationManagerForType<T> manager;
+      return manager;
+    }
+
+  public:
+
+    using value_type = T;
+
+    template <
+      typename U,
+      typename=std::enable_if_t<
+        std::is_constructible<T, U&&>::value
+        and not std::is_same<std::decay_t<U>, LazyUnpacked>::value
+      >
+    >
+    LazyUnpacked(U&& val)
+      : has_value_(true)
+    {
+      ::new (&value_storage_) T(std::forward<U>(val));
+    }
+
+    LazyUnpacked(LazyUnpacked const& other)
+      : has_value_(other.has_value_),
+        packed_(other.packed_)
+    {
+      if(has_value_) ::new (&value_storage_) T(other._value());
+    }
+
+    LazyUnpacked(LazyUnpacked&& other)
+      : has_value_(other.has_value_),
+        packed_(std::move(other.packed_))
+    {
+      if(has_value_) ::new (&value_storage_) T(std::move(other._value()));
+    }
+
+    LazyUnpacked& operator=(LazyUnpacked const&) = delete;
+    LazyUnpacked& operator=(LazyUnpacked&&) = delete;
+
+    ~LazyUnpacked() {
+      if(has_value_) _manager().destroy(&value_storage_);
+    }
+
+    /// Get the value, unpacking it first if this is its first access since
+    /// migration
+    T&
+    get() {
+      if(not has_value_) {
+        _manager().unpack_data(&value_storage_, packed_.data(), nullptr);
+        has_value_ = true;
+        std::vector<char>().swap(packed_);
+      }
+      // The caller could modify the value through the reference
+      packed_size_ = _unknown_size;
+      return _value();
+    }
+
+    T const&
+    get() const { return const_cast<LazyUnpacked*>(this)->get(); }
+
+    bool is_unpacked() const { return has_value_; }
+
+    //--------------------------------------------------------------------------
+    // <editor-fold desc="serialization"> {{{2
+
+    template <typename ArchiveT>
+    void compute_size(ArchiveT& ar) const {
+      ar % std::size_t{};
+      ar.add_to_size_raw(_packed_size());
+    }
+
+    template <typename ArchiveT>
+    void pack(ArchiveT& ar) const {
+      auto const size = _packed_size();
+      ar << size;
+      if(has_value_) {
+        auto*& buffer = *reinterpret_cast<char**>(&ar.data_pointer_reference());
+        _manager().pack_data(&value_storage_, buffer, nullptr);
+        buffer += size;
+      }
+      else {
+        // never touched on this side; forward the bytes we were given
+        ar.pack_data_raw(packed_.data(), packed_.data() + packed_.size());
+      }
+    }
+
+    template <typename ArchiveT>
+    static void unpack(void* allocated, ArchiveT& ar) {
+      std::size_t size = 0;
+      ar >> size;
+      auto* rv = ::new (allocated) LazyUnpacked(_packed_tag_t{}, size);
+      ar.template unpack_data_raw<char>(rv->packed_.data(), size);
+    }
+
+    // </editor-fold> end serialization }}}2
+    //--------------------------------------------------------------------------
+
+  private:
+
+    struct _packed_tag_t { };
+
+    LazyUnpacked(_packed_tag_t, std::size_t size)
+      : has_value_(false),
+        packed_(size),
+        packed_size_(size)
+    { }
+
+    T& _value() { return *reinterpret_cast<T*>(&value_storage_); }
+    T const& _value() const { return *reinterpret_cast<T const*>(&value_storage_); }
+
+    std::size_t
+    _packed_size() const {
+      if(packed_size_ == _unknown_size) {
+        // sizing always immediately precedes packing, so the pack call can
+        // reuse this
+        packed_size_ = has_value_ ?
+          _manager().get_packed_data_size(&value_storage_, nullptr)
+          : packed_.size();
+      }
+      return packed_size_;
+    }
+
+    std::aligned_storage_t<sizeof(T), alignof(T)> value_storage_;
+    bool has_value_;
+    std::vector<char> packed_;
+    mutable std::size_t packed_size_ = _unknown_size;
+
+};
+
+template <typename T>
+struct is_lazy_unpacked : std::false_type { };
+
+template <typename T>
+struct is_lazy_unpacked<LazyUnpacked<T>> : std::true_type { };
+
+/// The type in which a functor task stores a by-value argument of type T
+template <typename T>
+using lazy_unpacked_arg_t = std::conditional_t<
+  lazy_unpack_task_argument<T>::value, LazyUnpacked<T>, T
+>;
+
+} // end namespace detail
+
+} // end namespace serialization
+
+} // end namespace darma
+
+#endif //DARMA_IMPL_SERIALIZATION_LAZY_UNPACKED_H
@@ -45,9 +45,24 @@
 #ifndef DARMA_IMPL_SERIALIZATION_MANAGER_H
 #define DARMA_IMPL_SERIALIZATION_MANAGER_H
 
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#include <tinympl/bool.hpp>
+#include <tinympl/detection.hpp>
+
+#include <darma/utility/darma_assert.h>
+
+#include <darma/interface/app/serialization_traits.h>
+#include <darma/interface/backend/serialization_policy.h>
 #include <darma/interface/frontend/serialization_manager.h>
 #include <darma/serialization/simple_handler.h>
 
+#include <darma/impl/array/indexable.h>
+#include <darma/impl/serialization/arena_allocator.h>
+#include <darma/impl/serialization/compression.h>
+
 namespace darma {
 namespace serialization {
 namespace detail {
@@ -71,25 +86,164 @@ class SerializationManagerForType
     // just use simple archive and handler for now
     using serialization_handler_t = SimpleSerializationHandler<std::allocator<T>>;
 
-  public:
+    using _idx_traits = darma::detail::IndexingTraits<T>;
+    using _element_t = std::remove_cv_t<typename _idx_traits::element_type>;
+
+    template <typename U>
+    using _has_resize_archetype = decltype(
+      std::declval<U&>().resize(std::declval<size_t>())
+    );
+
+    using _can_pack_as_blob_t = tinympl::bool_<
+      _idx_traits::has_contiguous_trivially_copyable_elements
+      and tinympl::is_detected<_has_resize_archetype, T>::value
+      and std::is_default_constructible<T>::value
+    >;
+
+    // see compressed_packing_mode
+    using _compress_by_default_t = tinympl::bool_<
+      compressed_packing_mode<T>::value != CompressionMode::None
+      and _can_pack_as_blob_t::value
+    >;
+
+    abstract::backend::SerializationPolicy*
+    _effective_policy(abstract::backend::SerializationPolicy* ser_pol) const {
+      if(ser_pol == nullptr) {
+        return _default_policy(_compress_by_default_t{});
+      }
+      return ser_pol;
+    }
 
+  private:
+
+    struct _no_compression_policy {
+      explicit _no_compression_policy(CompressionMode) { }
+    };
+
+    using _compression_policy_t = std::conditional_t<
+      _compress_by_default_t::value,
+      CompressingSerializationPolicy, _no_compression_policy
+    >;
+
+    // Used in place of a null policy from the backend; only collects stats
+    mutable _compression_policy_t compression_policy_ {
+      compressed_packing_mode<T>::value
+    };
+
+    abstract::backend::SerializationPolicy*
+    _default_policy(std::true_type /* compress */) const {
+      return &compression_policy_;
+    }
+
+    abstract::backend::SerializationPolicy*
+    _default_policy(std::false_type /* compress */) const {
+      return nullptr;
+    }
+
+    // Sizing and packing with compression_policy_ through the
+    // SerializationPolicy interface would compress twice, so compress once
+    // into scratch that lives across both
     size_t
-    get_packed_data_size(
-      const void *const object_data,
-      abstract::backend::SerializationPolicy* /* ignored */
-    ) const override {
+    _pack_compressed_with_allocator(
+      std::true_type /* compress */,
+      T const& obj, abstract::backend::PackBufferAllocator& allocator
+    ) const {
+      size_t const n_elem = _idx_traits::n_elements(obj);
+      size_t const n_bytes = n_elem * sizeof(_element_t);
+      auto const compressed = compression_policy_.compress_blob(
+        obj.data(), n_bytes
+      );
+      size_t const size = sizeof(size_t) + compressed.size();
+      void* const buffer = allocator.allocate(size);
+      std::memcpy(buffer, &n_elem, sizeof(size_t));
+      void* blob_buffer = static_cast<char*>(buffer) + sizeof(size_t);
+      compression_policy_.pack_compressed_blob(blob_buffer, compressed, n_bytes);
+      return size;
+    }
+
+    size_t
+    _pack_compressed_with_allocator(
+      std::false_type /* compress */,
+      T const&, abstract::backend::PackBufferAllocator&
+    ) const {
+      return 0; // unreachable
+    }
+
+    // ser_pol must already be the effective policy
+    size_t
+    _get_packed_data_size(
+      T const& obj, abstract::backend::SerializationPolicy* ser_pol
+    ) const {
+      if(ser_pol != nullptr) {
+        return _get_packed_data_size(_can_pack_as_blob_t{}, obj, ser_pol);
+      }
+      else {
+        return _get_packed_data_size(std::false_type{}, obj, ser_pol);
+      }
+    }
+
+    // ser_pol must already be the effective policy
+    void
+    _pack_data(
+      T const& obj, void* const serialization_buffer,
+      abstract::backend::SerializationPolicy* ser_pol
+    ) const {
+      if(ser_pol != nullptr) {
+        _pack_data(_can_pack_as_blob_t{}, obj, serialization_buffer, ser_pol);
+      }
+      else {
+        _pack_data(std::false_type{}, obj, serialization_buffer, ser_pol);
+      }
+    }
+
+    //--------------------------------------------------------------------------
+    // <editor-fold desc="blob (policy-aware) packing"> {{{2
+
+    // Types whose whole payload is a contiguous array of trivially copyable
+    // elements are packed as an element count followed by a single blob that
+    // is handed to the backend's SerializationPolicy.  The policy can then
+    // copy it (the default), or register it for RDMA or otherwise pass it by
+    // reference, in which case it need not take up space in the buffer.
+
+    size_t
+    _get_packed_data_size(
+      std::true_type /* as blob */,
+      T const& obj, abstract::backend::SerializationPolicy* ser_pol
+    ) const {
+      return sizeof(size_t) + ser_pol->packed_size_contribution_for_blob(
+        obj.data(), _idx_traits::n_elements(obj) * sizeof(_element_t)
+      );
+    }
+
+    size_t
+    _get_packed_data_size(
+      std::false_type /* as blob */,
+      T const& obj, abstract::backend::SerializationPolicy*
+    ) const {
       auto ar = serialization_handler_t::make_sizing_archive();
       // call the customization point, allow ADL
-      darma_compute_size(*static_cast<T const*>(object_data), ar);
+      darma_compute_size(obj, ar);
       return serialization_handler_t::get_size(ar);
     }
 
     void
-    pack_data(
-      const void *const object_data,
-      void *const serialization_buffer,
-      abstract::backend::SerializationPolicy* /* ignored */
-    ) const override {
+    _pack_data(
+      std::true_type /* as blob */,
+      T const& obj, void* const serialization_buffer,
+      abstract::backend::SerializationPolicy* ser_pol
+    ) const {
+      size_t const n_elem = _idx_traits::n_elements(obj);
+      std::memcpy(serialization_buffer, &n_elem, sizeof(size_t));
+      void* blob_buffer = static_cast<char*>(serialization_buffer) + sizeof(size_t);
+      ser_pol->pack_blob(blob_buffer, obj.data(), n_elem * sizeof(_element_t));
+    }
+
+    void
+    _pack_data(
+      std::false_type /* as blob */,
+      T const& obj, void* const serialization_buffer,
+      abstract::backend::SerializationPolicy*
+    ) const {
       auto ar = serialization_handler_t::make_packing_archive(
         // Capacity unknown, but it doesn't matter
         NonOwningSerializationBuffer(
@@ -97,15 +251,31 @@ class SerializationManagerForType
         )
       );
       // call the customization point, allow ADL
-      darma_pack(*static_cast<T const*>(object_data), ar);
+      darma_pack(obj, ar);
     }
 
     void
-    unpack_data(
-      void *const object_dest,
-      const void *const serialized_data,
-      abstract::backend::SerializationPolicy* /* unused */
-    ) const override {
+    _unpack_data(
+      std::true_type /* as blob */,
+      void* const object_dest, void const* const serialized_data,
+      abstract::backend::SerializationPolicy* ser_pol
+    ) const {
+      size_t n_elem = 0;
+      std::memcpy(&n_elem, serialized_data, sizeof(size_t));
+      auto* obj = new (object_dest) T();
+      obj->resize(n_elem);
+      void* blob_buffer = const_cast<char*>(
+        static_cast<char const*>(serialized_data)
+      ) + sizeof(size_t);
+      ser_pol->unpack_blob(blob_buffer, obj->data(), n_elem * sizeof(_element_t));
+    }
+
+    void
+    _unpack_data(
+      std::false_type /* as blob */,
+      void* const object_dest, void const* const serialized_data,
+      abstract::backend::SerializationPolicy*
+    ) const {
       auto ar = serialization_handler_t::make_unpacking_archive(
         // Capacity unknown, but it doesn't matter
         ConstNonOwningSerializationBuffer(
@@ -118,6 +288,106 @@ class SerializationManagerForType
       );
     }
 
+    // </editor-fold> end blob (policy-aware) packing }}}2
+    //--------------------------------------------------------------------------
+
+  public:
+
+    // If no policy is given, everything goes through the archive.  Backends
+    // must pass the same (kind of) policy to the packing and unpacking side.
+
+    size_t
+    get_packed_data_size(
+      const void *const object_data,
+      abstract::backend::SerializationPolicy* ser_pol
+    ) const override {
+      return _get_packed_data_size(
+        *static_cast<T const*>(object_data), _effective_policy(ser_pol)
+      );
+    }
+
+    void
+    pack_data(
+      const void *const object_data,
+      void *const serialization_buffer,
+      abstract::backend::SerializationPolicy* ser_pol
+    ) const override {
+      _pack_data(
+        *static_cast<T const*>(object_data), serialization_buffer,
+        _effective_policy(ser_pol)
+      );
+    }
+
+    /** @brief The policy used in place of a null policy from the backend,
+     *  for types with a compressed_packing_mode (e.g., for its stats())
+     */
+    _compression_policy_t const&
+    default_compression_policy() const {
+      return compression_policy_;
+    }
+
+    bool
+    packed_size_is_invariant() const override {
+      return darma::serialization::packed_size_is_invariant<T>::value;
+    }
+
+    // Blob sizes are computed without touching the elements, so blobs are
+    // only traversed once, by the packing itself.  Everything else goes
+    // through the archives, which pack into a buffer that has to be big
+    // enough up front; those are still sized with darma_compute_size first
+    // unless the backend passes in a known (invariant) size.
+    size_t
+    pack_data_with_allocator(
+      const void* const object_data,
+      abstract::backend::PackBufferAllocator& allocator,
+      abstract::backend::SerializationPolicy* ser_pol,
+      size_t known_packed_size
+    ) const override {
+      DARMA_ASSERT_MESSAGE(
+        known_packed_size == 0 or packed_size_is_invariant(),
+        "pack_data_with_allocator() given a known packed size for a type whose"
+        " packed size isn't invariant"
+      );
+      auto const& obj = *static_cast<T const*>(object_data);
+      if(ser_pol == nullptr and _compress_by_default_t::value) {
+        return _pack_compressed_with_allocator(
+          _compress_by_default_t{}, obj, allocator
+        );
+      }
+      ser_pol = _effective_policy(ser_pol);
+      size_t const size = known_packed_size != 0 ?
+        known_packed_size : _get_packed_data_size(obj, ser_pol);
+      _pack_data(obj, allocator.allocate(size), ser_pol);
+      return size;
+    }
+
+    void
+    unpack_data(
+      void *const object_dest,
+      const void *const serialized_data,
+      abstract::backend::SerializationPolicy* ser_pol
+    ) const override {
+      ser_pol = _effective_policy(ser_pol);
+      if(ser_pol != nullptr) {
+        _unpack_data(_can_pack_as_blob_t{}, object_dest, serialized_data, ser_pol);
+      }
+      else {
+        _unpack_data(std::false_type{}, object_dest, serialized_data, ser_pol);
+      }
+    }
+
+    void
+    unpack_data_into_arena(
+      void *const object_dest,
+      const void *const serialized_data,
+      abstract::backend::SerializationPolicy* ser_pol,
+      abstract::backend::UnpackArena& arena
+    ) const override {
+      // ArenaAllocators created while unpacking pick up the arena
+      ScopedUnpackArena _arena_scope(&arena);
+      this->unpack_data(object_dest, serialized_data, ser_pol);
+    }
+
   private:
 
     template <typename U>
@@ -359,6 +359,9 @@ struct FunctorTask
     }
 
     void run() override {
+      TaskRunTimer timer(this->name_, this->cost_estimate_);
+      TraceSpan trace_span(abstract::frontend::TraceEventKind::RunTask);
+      trace_span.set_task(*this);
       this->run_functor();
     }
 
@@ -45,6 +45,9 @@
 #ifndef DARMAFRONTEND_LAMBDA_TASK_H
 #define DARMAFRONTEND_LAMBDA_TASK_H
 
+#include <memory>
+#include <vector>
+
 #include <darma/serialization/polymorphic/polymorphic_serialization_adapter.h>
 
 #include "task_base.h"
@@ -60,23 +63,28 @@ struct LambdaCaptureSetupHelper : private CaptureSetupHelperBase {
   LambdaCaptureSetupHelper(
     TaskBase* parent_task,
     CaptureManagerT* current_capture_context,
-    bool double_copy_capture = true // not always double copy, like in inner
-                                    // captures of create_work_while
+    bool double_copy_capture = true, // not always double copy, like in inner
+                                     // captures of create_work_while
+    bool moves_captured_values = false
   ) {
     // Note that the arguments (especially parent_task) to this constructor
     // should *not* be stored as data members because they may not be valid
     // for the entirety of this object's lifetime
-    pre_capture_setup(parent_task, current_capture_context, double_copy_capture);
+    pre_capture_setup(parent_task, current_capture_context,
+      double_copy_capture, moves_captured_values
+    );
   }
 
   template <typename CaptureManagerT>
   void pre_capture_setup(
     TaskBase* parent_task,
     CaptureManagerT* current_capture_context,
-    bool double_copy_capture = true
+    bool double_copy_capture = true,
+    bool moves_captured_values = false
   ) {
     CaptureSetupHelperBase::template pre_capture_setup(parent_task, current_capture_context);
     current_capture_context->is_double_copy_capture = double_copy_capture;
+    current_capture_context->moves_captured_values = moves_captured_values;
   }
 
   template <typename CaptureManagerT>
@@ -85,6 +93,7 @@ struct LambdaCaptureSetupHelper : private CaptureSetupHelperBase {
     CaptureManagerT* current_capture_context
   ) {
     current_capture_context->is_double_copy_capture = false;
+    current_capture_context->moves_captured_values = false;
     CaptureSetupHelperBase::template post_capture_cleanup(parent_task, current_capture_context);
   }
 
@@ -182,12 +191,18 @@ struct LambdaCapturer
     TaskBase* parent_task,
     CaptureManagerT* capture_manager,
     bool double_copy_capture = true
-  ) : LambdaCaptureSetupHelper(parent_task, capture_manager, double_copy_capture),
+  ) : LambdaCaptureSetupHelper(parent_task, capture_manager, double_copy_capture,
+        // Only a lambda that nobody else can see again can be moved out of
+        /* moves_captured_values = */ not std::is_lvalue_reference<LambdaDeduced>::value
+      ),
       callable_(
         // Intentionally *don't* forward to trigger copy ctors of captured vars
         callable_in
       )
   {
+    #if _darma_has_feature(task_migration)
+    _claim_captured_objects(capture_manager);
+    #endif
     post_capture_cleanup(parent_task, capture_manager);
   }
 
@@ -217,9 +232,38 @@ struct LambdaCapturer
         callable_in
       )
   {
+    _claim_captured_objects(capture_manager);
     post_unpack_cleanup(parent_task, capture_manager, ar);
   }
 
+  template <typename CaptureManagerT>
+  void
+  _claim_captured_objects(CaptureManagerT* capture_manager) {
+    // Only keep the objects that were copied into this closure (the capture
+    // manager may be shared with other captures, e.g., in create_work_while)
+    auto const* begin = reinterpret_cast<char const*>(std::addressof(callable_));
+    auto const* end = begin + sizeof(Lambda);
+    for(auto const& captured : capture_manager->captured_objects_for_serdes) {
+      auto const* object = static_cast<char const*>(captured.object);
+      if(object >= begin and object < end) {
+        captured_objects_.push_back({
+          static_cast<std::size_t>(object - begin), captured
+        });
+      }
+    }
+  }
+
+  // Offsets (rather than addresses) so that this stays valid if moved
+  struct captured_object_in_closure {
+    std::size_t offset;
+    CaptureManager::CapturedObjectSerdes serdes;
+
+    void const*
+    get_object(Lambda const& callable) const {
+      return reinterpret_cast<char const*>(std::addressof(callable)) + offset;
+    }
+  };
+
   #endif // darma_has_feature(task_migration)
   // </editor-fold> end darma_has_feature(task_migration) }}}2
   //------------------------------------------------------------------------------
@@ -233,6 +277,13 @@ struct LambdaCapturer
 
   Lambda callable_;
 
+  #if _darma_has_feature(task_migration)
+  // Captured objects in callable_ that need more than a raw copy to migrate,
+  // in the order that copying callable_ visits them (which is also the
+  // order in which they are unpacked)
+  std::vector<captured_object_in_closure> captured_objects_;
+  #endif
+
   // </editor-fold> end data members }}}1
   //============================================================================
 
@@ -438,24 +489,12 @@ struct LambdaTask
 
     ar.add_to_size_raw(sizeof(Lambda));
 
-    auto* running_task = static_cast<darma::detail::TaskBase*>(
-      abstract::backend::get_backend_context()->get_running_task()
-    );
-    running_task->current_create_work_context = const_cast<LambdaTask*>(this);
-    this->lambda_serdes_mode = CaptureManager::SerializerMode::Sizing;
-    this->lambda_serdes_computed_size = 0;
-
-    // Trigger a copy, but be sure not to use _garbage for anything!!!
-    // in fact, make sure it doesn't get destroyed
-    char* _garbage_as_raw = new char[sizeof(Lambda)];
-    new (_garbage_as_raw) Lambda(this->callable_);
-    delete[] _garbage_as_raw;
-
-    this->lambda_serdes_mode = CaptureManager::SerializerMode::None;
-    running_task->current_create_work_context = nullptr;
-
-    ar.add_to_size_raw(this->lambda_serdes_computed_size);
-    this->lambda_serdes_computed_size = 0;
+    // Size the captured objects in place, without copying the closure
+    for(auto const& captured : this->captured_objects_) {
+      ar.add_to_size_raw(
+        captured.serdes.get_packed_size(captured.get_object(this->callable_))
+      );
+    }
 
     const_cast<LambdaTask*>(this)->TaskBase::template do_serialize(ar);
 
@@ -465,28 +504,18 @@ struct LambdaTask
   void pack(PackingArchive& ar) const {
     ar.pack_data_raw(&this->callable_, &this->callable_ + 1);
 
-    auto* running_task = static_cast<darma::detail::TaskBase*>(
-      abstract::backend::get_backend_context()->get_running_task()
-    );
-    running_task->current_create_work_context = const_cast<LambdaTask*>(this);
-    this->lambda_serdes_mode = CaptureManager::SerializerMode::Packing;
-
     auto ptr_ar = serialization::PointerReferenceSerializationHandler<>::make_packing_archive_referencing(ar);
 
-    this->lambda_serdes_buffer = *reinterpret_cast<char**>(&ptr_ar.data_pointer_reference());
+    char* buffer = *reinterpret_cast<char**>(&ptr_ar.data_pointer_reference());
 
-    // Trigger a copy, but be sure not to use _garbage for anything!!!
-    // in fact, make sure it doesn't get destroyed
-    char* _garbage_as_raw = new char[sizeof(Lambda)];
-    new (_garbage_as_raw) Lambda(this->callable_);
-    delete[] _garbage_as_raw;
-
-    this->lambda_serdes_mode = CaptureManager::SerializerMode::None;
-    running_task->current_create_work_context = nullptr;
+    // Pack the captured objects in place, in the same order that copying the
+    // closure in unpack() will read them back
+    for(auto const& captured : this->captured_objects_) {
+      captured.serdes.pack(captured.get_object(this->callable_), buffer);
+    }
 
     // And advance the buffer
-    ptr_ar.data_pointer_reference() = this->lambda_serdes_buffer;
-    this->lambda_serdes_buffer = nullptr;
+    ptr_ar.data_pointer_reference() = buffer;
 
     const_cast<LambdaTask*>(this)->TaskBase::template do_serialize(ar);
   }
@@ -531,6 +560,9 @@ struct LambdaTask
   // <editor-fold desc="darma::abstract::frontend::Task method implementations"> {{{1
 
   void run() override {
+    TaskRunTimer timer(this->name_, this->cost_estimate_);
+    TraceSpan trace_span(abstract::frontend::TraceEventKind::RunTask);
+    trace_span.set_task(*this);
     this->callable_();
   }
 
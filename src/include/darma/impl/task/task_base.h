@@ -51,6 +51,7 @@
 #include <unordered_map>
 #include <unordered_set>
 #include <set>
+#include <vector>
 
 #include <tinympl/greater.hpp>
 #include <tinympl/int.hpp>
@@ -74,6 +75,9 @@
 #include <darma/interface/frontend/task.h>
 #include <darma/interface/frontend/unpack_task.h>
 
+#include <darma/impl/task/task_run_timing.h>
+#include <darma/impl/util/frontend_trace.h>
+
 #include <darma/serialization/serializers/arithmetic_types.h>
 #include <darma/serialization/polymorphic/polymorphic_serialization_adapter.h>
 #include <darma/serialization/serializers/standard_library/string.h> // for task calling file and function
@@ -139,22 +143,37 @@ class CaptureManager {
         use->already_captured = false;
       }
       uses_to_unmark_already_captured.clear();
+      captured_objects_for_serdes.clear();
     }
 
     typedef enum struct SerializerMode {
       None,
-      Sizing,
-      Packing,
       Unpacking
     } SerializerMode;
 
+    /**
+     *  A captured object (e.g., an AccessHandle) living inside the closure of
+     *  a lambda task, along with how to size and pack it for migration, so
+     *  that the closure doesn't need to be copied to serialize its captures
+     */
+    struct CapturedObjectSerdes {
+      void const* object;
+      std::size_t (*get_packed_size)(void const*);
+      void (*pack)(void const*, char*& buffer);
+    };
+
     std::set<HandleUseBase*> uses_to_unmark_already_captured;
     bool is_double_copy_capture = false;
+    // true while a lambda passed as an rvalue is being copied into its task,
+    // so that captured MovedCapture<T>s can move out of it (see moved())
+    bool moves_captured_values = false;
     AccessHandleBase::capture_op_t scheduling_capture_op = AccessHandleBase::CaptureOp::modify_capture;
     AccessHandleBase::capture_op_t immediate_capture_op = AccessHandleBase::CaptureOp::modify_capture;
-    mutable std::size_t lambda_serdes_computed_size = 0;
     mutable SerializerMode lambda_serdes_mode = SerializerMode::None;
     mutable char* lambda_serdes_buffer = nullptr;
+    // objects captured (or unpacked) during the current capture, in copy
+    // order; claimed by the LambdaCapturer whose closure holds them
+    std::vector<CapturedObjectSerdes> captured_objects_for_serdes;
 
     get_deps_container_t dependencies_;
 
@@ -345,6 +364,9 @@ class TaskBase
     template <typename ArchiveT>
     void do_serialize(ArchiveT& ar) {
       ar | name_;
+      ar | affinity_;
+      ar | priority_;
+      ar | cost_estimate_;
       #if _darma_has_feature(create_parallel_for)
       ar | width_;
       #if _darma_has_feature(create_parallel_for_custom_cpu_set)
@@ -404,6 +426,21 @@ class TaskBase
       name_ = name;
     }
 
+    abstract::frontend::TaskAffinity const&
+    get_affinity() const override {
+      return affinity_;
+    }
+
+    int
+    get_priority() const override {
+      return priority_;
+    }
+
+    double
+    get_cost_estimate() const override {
+      return cost_estimate_;
+    }
+
     //--------------------------------------------------------------------------
     // <editor-fold desc="DARMA feature: task_migration"> {{{2
     #if _darma_has_feature(task_migration)
@@ -547,8 +584,23 @@ class TaskBase
 #endif // _darma_has_feature(task_collection_token)
     }
 
+    // Used when recapturing the next iteration of a create_work_while: every
+    // iteration keeps the affinity, priority, and cost estimate given to the
+    // first one
+    void copy_scheduling_hints_from(TaskBase const& previous_iteration) {
+      affinity_ = previous_iteration.affinity_;
+      priority_ = previous_iteration.priority_;
+      cost_estimate_ = previous_iteration.cost_estimate_;
+    }
+
     bool is_parallel_for_task_ = false;
     bool is_data_parallel_task_ = false;
+    // placement hint from the affinity= keyword (see TaskAffinity)
+    abstract::frontend::TaskAffinity affinity_;
+    // scheduling priority from the priority= keyword (see inherit_priority())
+    int priority_ = 0;
+    // estimated cost from the cost= keyword (0 if not given)
+    double cost_estimate_ = 0.0;
     bool must_specify_permissions = false; // added by gb -- 02-08-2018
 
   protected:
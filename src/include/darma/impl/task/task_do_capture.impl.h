@@ -144,11 +144,19 @@ TaskBase::TaskBase(
         darma::types::key_t name_key,
         auto&& allow_aliasing_desc,
         bool data_parallel,
+        abstract::frontend::TaskAffinity affinity,
+        TaskPriorityDescription const& priority,
+        double cost_estimate,
         darma::detail::variadic_arguments_begin_tag,
         auto&&... deferred_permissions_modifications
       ) {
         this->allowed_aliasing = std::forward<decltype(allow_aliasing_desc)>(allow_aliasing_desc);
         this->is_data_parallel_task_ = data_parallel;
+        this->affinity_ = std::move(affinity);
+        this->priority_ = priority.resolve(
+          parent_task != nullptr ? parent_task->priority_ : 0
+        );
+        this->cost_estimate_ = cost_estimate;
         this->name_ = name_key;
         std::make_tuple( // only for fold emulation
           (deferred_permissions_modifications.do_permissions_modifications()
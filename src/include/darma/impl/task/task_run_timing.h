@@ -0,0 +1,145 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                      task_run_timing.h
+//                         DARMA
+//              Copyright (C) 2017 NTESS, LLC
+//
+// Under the terms of Contract DE-NA-0003525 with NTESS, LLC,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact darma@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef DARMA_IMPL_TASK_TASK_RUN_TIMING_H
+#define DARMA_IMPL_TASK_TASK_RUN_TIMING_H
+
+#include <chrono>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <darma_types.h>
+
+#include <darma/interface/frontend/task_run_timing.h>
+#include <darma/impl/util/per_thread_ring_buffer.h>
+
+namespace darma {
+namespace detail {
+
+using task_run_timing_buffers_t = PerThreadRingBuffers<
+  abstract::frontend::TaskRunTiming
+>;
+
+// Put one of these at the top of a Task::run() implementation to record the
+// wall time of the call (does nothing unless DARMA_MEASURE_TASK_RUN_TIME)
+class TaskRunTimer {
+  public:
+
+#if DARMA_MEASURE_TASK_RUN_TIME
+    TaskRunTimer(
+      types::key_t const& name,
+      double cost_estimate,
+      std::size_t collection_index =
+        abstract::frontend::TaskRunTiming::not_a_collection_task
+    ) : name_(name),
+        cost_estimate_(cost_estimate),
+        collection_index_(collection_index),
+        start_(clock_t::now())
+    { }
+
+    ~TaskRunTimer() {
+      abstract::frontend::TaskRunTiming timing;
+      timing.wall_time = std::chrono::duration<double>(
+        clock_t::now() - start_
+      ).count();
+      timing.name = name_;
+      timing.collection_index = collection_index_;
+      timing.cost_estimate = cost_estimate_;
+      task_run_timing_buffers_t::local_buffer(
+        DARMA_TASK_RUN_TIMING_BUFFER_SIZE
+      ).try_push(std::move(timing));
+    }
+
+  private:
+
+    using clock_t = std::chrono::steady_clock;
+
+    types::key_t const& name_;
+    double cost_estimate_;
+    std::size_t collection_index_;
+    clock_t::time_point start_;
+#else
+    TaskRunTimer(types::key_t const&, double, std::size_t = 0) { }
+#endif
+
+  public:
+
+    TaskRunTimer(TaskRunTimer const&) = delete;
+    TaskRunTimer& operator=(TaskRunTimer const&) = delete;
+};
+
+} // end namespace detail
+
+namespace frontend {
+
+inline std::size_t
+collect_task_run_timings(
+  std::vector<abstract::frontend::TaskRunTiming>& timings
+) {
+#if DARMA_MEASURE_TASK_RUN_TIME
+  return detail::task_run_timing_buffers_t::drain_all(
+    [&](abstract::frontend::TaskRunTiming&& timing) {
+      timings.push_back(std::move(timing));
+    }
+  );
+#else
+  return 0;
+#endif
+}
+
+inline std::size_t
+n_dropped_task_run_timings() {
+#if DARMA_MEASURE_TASK_RUN_TIME
+  return detail::task_run_timing_buffers_t::n_dropped();
+#else
+  return 0;
+#endif
+}
+
+} // end namespace frontend
+
+} // end namespace darma
+
+#endif //DARMA_IMPL_TASK_TASK_RUN_TIMING_H
@@ -50,6 +50,12 @@
 #if _darma_has_feature(create_concurrent_work)
 #include <darma/impl/task_collection/task_collection.h>
 
+#include <darma/interface/app/keyword_arguments/affinity.h>
+#include <darma/interface/app/keyword_arguments/priority.h>
+#include <darma/interface/app/keyword_arguments/cost.h>
+#include <darma/interface/app/task_priority.h>
+#include <darma/interface/frontend/task_affinity.h>
+
 namespace darma {
 
 template <typename Functor, typename... Args>
@@ -57,10 +63,16 @@ void create_concurrent_work(Args&&... args) {
   using namespace darma::detail;
   using darma::keyword_tags_for_create_concurrent_work::index_range;
   using darma::keyword_tags_for_task_creation::name;
+  using darma::keyword_tags_for_task_creation::affinity;
+  using darma::keyword_tags_for_task_creation::priority;
+  using darma::keyword_tags_for_task_creation::cost;
   using parser = kwarg_parser<
   variadic_positional_overload_description<
     _keyword<deduced_parameter, index_range>,
-    _optional_keyword<converted_parameter, name>
+    _optional_keyword<converted_parameter, name>,
+    _optional_keyword<abstract::frontend::TaskAffinity, affinity>,
+    _optional_keyword<TaskPriorityDescription, priority>,
+    _optional_keyword<double, cost>
   >
   // TODO other overloads
   >;
@@ -70,7 +82,14 @@ void create_concurrent_work(Args&&... args) {
 
   parser()
     .with_default_generators(
-      keyword_arguments_for_task_creation::name=[]{ return darma::make_key(); }
+      keyword_arguments_for_task_creation::name=[]{ return darma::make_key(); },
+      keyword_arguments_for_task_creation::affinity=[]{
+        return abstract::frontend::TaskAffinity{};
+      },
+      keyword_arguments_for_task_creation::priority=[]{
+        return TaskPriorityDescription{};
+      },
+      keyword_arguments_for_task_creation::cost=[]{ return 0.0; }
     )
     .with_converters(
       [](auto&&... key_parts) {
@@ -81,9 +100,16 @@ void create_concurrent_work(Args&&... args) {
     .invoke([](
       auto&& index_range,
       types::key_t name_key,
+      abstract::frontend::TaskAffinity affinity,
+      TaskPriorityDescription const& priority,
+      double cost_estimate,
       darma::detail::variadic_arguments_begin_tag,
       auto&&... my_args
     ){
+      TraceSpan trace_span(
+        abstract::frontend::TraceEventKind::CreateConcurrentWork
+      );
+
       using task_collection_impl_t = typename detail::make_task_collection_impl_t<
         Functor, std::decay_t<decltype(index_range)>, decltype(my_args)...
       >::type;
@@ -94,6 +120,13 @@ void create_concurrent_work(Args&&... args) {
       );
 
       task_collection->name_ = std::move(name_key);
+      task_collection->affinity_ = std::move(affinity);
+      auto* parent_task = get_running_task_impl();
+      task_collection->priority_ = priority.resolve(
+        parent_task != nullptr ? parent_task->priority_ : 0
+      );
+      task_collection->cost_estimate_ = cost_estimate;
+      trace_span.set_task(*task_collection);
 
       auto* backend_runtime = abstract::backend::get_backend_runtime();
       backend_runtime->register_task_collection(
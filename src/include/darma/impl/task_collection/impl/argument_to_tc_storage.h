@@ -453,8 +453,7 @@ struct _get_storage_arg_helper<
           _captured_use_with_mapping_maker<full_mapping_t, handle_range_t>(
             full_mapping_t(
               arg.mapping,
-              tc_index_range_traits::mapping_to_dense(collection.collection_range_)
-              //, collection.collection_range_
+              collection.indexing_->mapping_to_dense
             ),
             utility::safe_static_cast< UnmappedUseCollection<handle_range_t> const* >(
               arg.collection.get_current_use()->use()->collection_.get()
@@ -553,7 +552,7 @@ struct _get_storage_arg_helper<
 
     // First, check that the identity mapping is valid...
     DARMA_ASSERT_EQUAL_VERBOSE(
-      arg.get_index_range().size(), collection.collection_range_.size()
+      arg.get_index_range().size(), collection.collection_range().size()
     );
 
     // This default should probably be:
@@ -563,7 +562,7 @@ struct _get_storage_arg_helper<
           handle_range_traits::mapping_to_dense(arg.get_index_range()),
           // Intentionally leave this as ADL; user could want to override it
           make_reverse_mapping(
-            collection_range_traits::mapping_to_dense(collection.collection_range_)
+            collection.indexing_->mapping_to_dense
           )
         }
       )
@@ -117,14 +117,13 @@ struct TaskCollectionImpl
     ) {
       return std::make_unique<
         TaskCollectionTaskImpl<
-          Functor, typename index_range_traits::mapping_to_dense_type,
+          Functor, IndexRangeT,
           typename _task_collection_impl::_get_task_stored_arg_helper<
             Functor, Args, Spots
           >::type...
         >
       >(
-        index, index_range_traits::mapping_to_dense(collection_range_),
-        *this, seq, args_stored_
+        index, indexing_, *this, seq, args_stored_
       );
     }
 
@@ -136,8 +135,13 @@ struct TaskCollectionImpl
 
     types::key_t name_ = detail::key_traits<types::key_t>::make_awaiting_backend_assignment_key();
 
+    // Given to each task created by create_task_for_index()
+    abstract::frontend::TaskAffinity affinity_;
+    int priority_ = 0;
+    double cost_estimate_ = 0.0;
+
     // Leave this member declaration order the same; construction of args_stored_
-    // depends on collection_range_ being initialized already
+    // depends on indexing_ being initialized already
 
     using dependencies_container_t = types::handle_container_template<
       abstract::frontend::DependencyUse*
@@ -148,22 +152,38 @@ struct TaskCollectionImpl
     #endif // _darma_has_feature(task_collection_token)
 
     dependencies_container_t dependencies_;
-    IndexRangeT collection_range_;
+    // The collection range and its mapping to dense are computed once here and
+    // shared by reference with every task created from this collection
+    std::shared_ptr<TaskCollectionIndexing<IndexRangeT> const> indexing_;
+#if _darma_has_feature(simple_collectives)
+    // Created if the backend tells us how many tasks will run in this process
+    std::shared_ptr<LocalAllreduceCombiner> local_combiner_ = nullptr;
+#endif // _darma_has_feature(simple_collectives)
     args_tuple_t args_stored_;
 
+    IndexRangeT const& collection_range() const {
+      return indexing_->index_range;
+    }
+
     template <typename Archive>
     void compute_size(Archive& ar) const {
-      ar | collection_range_;
+      ar | indexing_->index_range;
       ar | args_stored_;
       ar | name_;
+      ar | affinity_;
+      ar | priority_;
+      ar | cost_estimate_;
       // nothing to pack for dependencies.  They'll be handled later
     }
 
     template <typename Archive>
     void pack(Archive& ar) const {
-      ar | collection_range_;
+      ar | indexing_->index_range;
       ar | args_stored_;
       ar | name_;
+      ar | affinity_;
+      ar | priority_;
+      ar | cost_estimate_;
       // nothing to pack for dependencies.  They'll be handled later
     }
 
@@ -174,7 +194,13 @@ struct TaskCollectionImpl
 
       // TODO deal with range default constructibility?
 
-      ar >> rv_ptr->collection_range_;
+      {
+        IndexRangeT collection_range;
+        ar >> collection_range;
+        rv_ptr->indexing_ = std::make_shared<
+          TaskCollectionIndexing<IndexRangeT> const
+        >(std::move(collection_range));
+      }
 
       // Some arguments might not be default constructible either...
       ar >> rv_ptr->args_stored_;
@@ -183,9 +209,12 @@ struct TaskCollectionImpl
       new (&rv_ptr->dependencies_) dependencies_container_t();
 
       // Unpacking.
-      // collection_range_ already unpacked in reconstruct
+      // indexing_ already unpacked in reconstruct
       // args_stored_ already unpacked in reconstruct
       ar >> rv_ptr->name_;
+      ar >> rv_ptr->affinity_;
+      ar >> rv_ptr->priority_;
+      ar >> rv_ptr->cost_estimate_;
 
       // need to set up dependencies here...
       rv_ptr->_unpack_deps(std::index_sequence_for<Args...>{});
@@ -264,7 +293,11 @@ struct TaskCollectionImpl
     TaskCollectionImpl(
       IndexRangeDeduced&& collection_range,
       ArgsForwarded&& ... args_forwarded
-    ) : collection_range_(std::forward<IndexRangeDeduced>(collection_range)),
+    ) : indexing_(
+          std::make_shared<TaskCollectionIndexing<IndexRangeT> const>(
+            std::forward<IndexRangeDeduced>(collection_range)
+          )
+        ),
 #if _darma_has_feature(task_collection_token)
         token_(),
 #endif // _darma_has_feature(task_collection_token)
@@ -282,7 +315,21 @@ struct TaskCollectionImpl
     //==========================================================================
     // <editor-fold desc="TaskCollection concrete implementation"> {{{1
 
-    size_t size() const override { return collection_range_.size(); }
+    size_t size() const override { return indexing_->index_range.size(); }
+
+    void set_local_task_count(std::size_t n_local_tasks) override {
+#if _darma_has_feature(simple_collectives)
+      // Nothing to combine with only one local task
+      if(n_local_tasks > 1) {
+        local_combiner_ = std::make_shared<LocalAllreduceCombiner>(
+          n_local_tasks
+        );
+      }
+      else {
+        local_combiner_ = nullptr;
+      }
+#endif // _darma_has_feature(simple_collectives)
+    }
 
     std::unique_ptr<types::task_collection_task_t>
     create_task_for_index(std::size_t index) override {
@@ -312,6 +359,15 @@ struct TaskCollectionImpl
     void
     set_name(types::key_t const& name) override { name_ = name; }
 
+    abstract::frontend::TaskAffinity const&
+    get_affinity() const override { return affinity_; }
+
+    int
+    get_priority() const override { return priority_; }
+
+    double
+    get_cost_estimate() const override { return cost_estimate_; }
+
 #if _darma_has_feature(task_collection_token)
     types::task_collection_token_t const&
     get_task_collection_token() const override {
@@ -96,6 +96,13 @@ template <
 >
 struct TaskCollectionImpl;
 
+template <
+  typename Functor,
+  typename IndexRangeT,
+  typename... StoredArgs
+>
+struct TaskCollectionTaskImpl;
+
 template <typename IndexRangeT>
 class BasicAccessHandleCollection;
 
@@ -45,9 +45,14 @@
 #ifndef DARMA_IMPL_TASK_COLLECTION_TASK_COLLECTION_TASK_H
 #define DARMA_IMPL_TASK_COLLECTION_TASK_COLLECTION_TASK_H
 
+#include <cassert>
+#include <memory> // std::shared_ptr
 #include <type_traits>
 
 #include <darma/impl/task/task.h>
+#include <darma/impl/index_range/index_range_traits.h>
+#include <darma/impl/collective/local_combiner.h>
+#include <darma/impl/task_collection/task_collection_fwd.h>
 
 #include "impl/tc_storage_to_task_storage.h"
 #include "impl/task_storage_to_param.h"
@@ -74,7 +79,9 @@ struct ConcurrentContext {
     >;
 
     index_t index_;
-    index_range_t index_range_;
+    // Points into the index range shared by the task collection and all of
+    // its tasks, so it doesn't need to be copied into every task
+    index_range_t const* index_range_ = nullptr;
     size_t backend_index_;
     size_t backend_size_;
 
@@ -82,6 +89,17 @@ struct ConcurrentContext {
     types::task_collection_token_t token_;
 #endif // _darma_has_feature(task_collection_token)
 
+#if _darma_has_feature(simple_collectives)
+    // Owned by the task collection; set by the task that creates this context
+    detail::LocalAllreduceCombiner* local_combiner_ = nullptr;
+#endif // _darma_has_feature(simple_collectives)
+
+    template <typename>
+    friend struct ConcurrentContext;
+
+    template <typename, typename, typename...>
+    friend struct detail::TaskCollectionTaskImpl;
+
   public:
 
     ConcurrentContext(
@@ -99,13 +117,18 @@ struct ConcurrentContext {
 #endif // _darma_has_feature(task_collection_token)
     { }
 
+    /**
+     *  @remark `index_range` is held by reference; it must outlive the context
+     *  (for contexts created by the task collection, it is owned by the state
+     *  the collection shares with its tasks)
+     */
     ConcurrentContext(
       index_t const& index,
       index_range_t const& index_range,
       size_t backend_index,
       size_t backend_size
     ) : index_(index),
-        index_range_(index_range),
+        index_range_(&index_range),
         backend_index_(backend_index),
         backend_size_(backend_size)
     { }
@@ -118,13 +141,38 @@ struct ConcurrentContext {
       size_t backend_size,
       types::task_collection_token_t const& token
     ) : index_(index),
-        index_range_(index_range),
+        index_range_(&index_range),
         backend_index_(backend_index),
         backend_size_(backend_size),
         token_(token)
     { }
 #endif // _darma_has_feature(task_collection_token)
 
+    // Allow a context that knows its index range to be passed to a functor
+    // that only asks for the index, e.g., ConcurrentContext<Index1D<int>>
+    template <
+      typename IndexRangeT,
+      typename=std::enable_if_t<
+        std::is_same<index_range_t, detail::not_an_index_range>::value
+        and indexing::index_range_traits<IndexRangeT>::is_index_range
+        and std::is_same<
+          typename indexing::index_range_traits<IndexRangeT>::index_type,
+          index_t
+        >::value
+      >
+    >
+    ConcurrentContext(ConcurrentContext<IndexRangeT> const& other)
+      : index_(other.index_),
+        backend_index_(other.backend_index_),
+        backend_size_(other.backend_size_)
+#if _darma_has_feature(task_collection_token)
+        , token_(other.token_)
+#endif // _darma_has_feature(task_collection_token)
+#if _darma_has_feature(simple_collectives)
+        , local_combiner_(other.local_combiner_)
+#endif // _darma_has_feature(simple_collectives)
+    { }
+
     operator index_t() { return index_; }
 
     index_t const& index() const { return index_; }
@@ -138,7 +186,8 @@ struct ConcurrentContext {
       >
     >
     index_range_t const& index_range() const {
-      return index_range_;
+      assert(index_range_ != nullptr);
+      return *index_range_;
     };
 
 #if _darma_has_feature(simple_collectives)
@@ -177,6 +226,7 @@ struct ConcurrentContext {
 #if _darma_has_feature(task_collection_token)
           , this->token_
 #endif // _darma_has_feature(task_collection_token)
+          , local_combiner_
         ));
     }
 #endif // _darma_has_feature(_simple_collectives)
@@ -185,31 +235,77 @@ struct ConcurrentContext {
 
 namespace detail {
 
+//==============================================================================
+// <editor-fold desc="TaskCollectionIndexing">
+
+/**
+ *  @internal
+ *  @brief The index range of a task collection together with its mapping to
+ *  dense.
+ *
+ *  This is immutable once created and is shared (via `std::shared_ptr`)
+ *  between the `TaskCollectionImpl` and every task it creates, so that tasks
+ *  don't each carry a copy of a potentially large range and mapping.
+ */
+template <typename IndexRangeT>
+struct TaskCollectionIndexing {
+
+  using index_range_t = IndexRangeT;
+  using index_range_traits = indexing::index_range_traits<index_range_t>;
+  using mapping_to_dense_t = typename index_range_traits::mapping_to_dense_type;
+
+  // Leave this member declaration order the same; construction of
+  // mapping_to_dense depends on index_range being initialized already
+
+  index_range_t index_range;
+  // This is the mapping from frontend index to backend index for the collection
+  mapping_to_dense_t mapping_to_dense;
+
+  template <typename IndexRangeDeduced>
+  explicit
+  TaskCollectionIndexing(IndexRangeDeduced&& range)
+    : index_range(std::forward<IndexRangeDeduced>(range)),
+      mapping_to_dense(index_range_traits::mapping_to_dense(index_range))
+  { }
+
+};
+
+// </editor-fold> end TaskCollectionIndexing
+//==============================================================================
+
 //==============================================================================
 // <editor-fold desc="TaskCollectionTaskImpl">
 
 template <
-  typename Functor, typename Mapping,
+  typename Functor, typename IndexRangeT,
   typename... StoredArgs
 >
 struct TaskCollectionTaskImpl
   : serialization::PolymorphicSerializationAdapter<
-      TaskCollectionTaskImpl<Functor, Mapping, StoredArgs...>,
+      TaskCollectionTaskImpl<Functor, IndexRangeT, StoredArgs...>,
       abstract::frontend::TaskCollectionTask<TaskBase>
     >
 {
   using base_t = serialization::PolymorphicSerializationAdapter<
-    TaskCollectionTaskImpl<Functor, Mapping, StoredArgs...>,
+    TaskCollectionTaskImpl<Functor, IndexRangeT, StoredArgs...>,
     abstract::frontend::TaskCollectionTask<TaskBase>
   >;
 
   using args_tuple_t = std::tuple<StoredArgs...>;
+  using indexing_t = TaskCollectionIndexing<IndexRangeT>;
 
   size_t backend_index_;
   size_t backend_size_;
-  // This is the mapping from frontend index to backend index for the collection itself
-  Mapping mapping_;
+  // Shared with the parent collection and all of its other tasks
+  std::shared_ptr<indexing_t const> indexing_;
+#if _darma_has_feature(simple_collectives)
+  // Only non-null if the backend has enabled node-local combining of
+  // collectives for the parent collection
+  std::shared_ptr<LocalAllreduceCombiner> local_combiner_;
+#endif // _darma_has_feature(simple_collectives)
   args_tuple_t args_;
+  // recorded as the name in this task's TaskRunTiming and RunTask trace event
+  types::key_t collection_name_;
 
 
 
@@ -230,29 +326,35 @@ struct TaskCollectionTaskImpl
   }
 
 
-  // TODO potentially propagate Index Range object?
   auto
   _get_first_argument() {
-    return ConcurrentContext<
-        decltype(mapping_.map_backward(backend_index_))
-    >(
-      mapping_.map_backward(backend_index_),
+    auto rv = ConcurrentContext<IndexRangeT>(
+      indexing_->mapping_to_dense.map_backward(backend_index_),
+      indexing_->index_range,
       backend_index_, backend_size_
 #if _darma_has_feature(task_collection_token)
       , this->token_
 #endif
     );
+#if _darma_has_feature(simple_collectives)
+    rv.local_combiner_ = local_combiner_.get();
+#endif // _darma_has_feature(simple_collectives)
+    return rv;
   }
 
   template <typename TaskCollectionT, typename CollectionStoredArgs, size_t... Spots>
   TaskCollectionTaskImpl(
-    std::size_t backend_index, Mapping const& mapping,
+    std::size_t backend_index,
+    std::shared_ptr<indexing_t const> const& indexing,
     TaskCollectionT& parent,
     std::index_sequence<Spots...>,
     CollectionStoredArgs&& args_stored
   ) : backend_index_(backend_index),
       backend_size_(parent.size()),
-      mapping_(mapping),
+      indexing_(indexing),
+#if _darma_has_feature(simple_collectives)
+      local_combiner_(parent.local_combiner_),
+#endif // _darma_has_feature(simple_collectives)
       args_(
         _task_collection_impl::_get_task_stored_arg_helper<
           Functor,
@@ -265,6 +367,10 @@ struct TaskCollectionTaskImpl
         )...
       )
   {
+    this->affinity_ = parent.affinity_;
+    this->priority_ = parent.priority_;
+    this->cost_estimate_ = parent.cost_estimate_;
+    collection_name_ = parent.name_;
 #if _darma_has_feature(task_collection_token)
     this->parent_token_available = true;
     this->token_ = parent.token_;
@@ -272,6 +378,10 @@ struct TaskCollectionTaskImpl
   }
 
   void run() override {
+    TaskRunTimer timer(collection_name_, this->cost_estimate_, backend_index_);
+    TraceSpan trace_span(abstract::frontend::TraceEventKind::RunTask);
+    trace_span.set_name(collection_name_).set_task_id(this)
+      .set_index(backend_index_);
     meta::splat_tuple(
       _get_call_args_impl(std::index_sequence_for<StoredArgs...>{}),
       [&](auto&&... args) mutable {
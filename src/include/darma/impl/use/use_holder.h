@@ -47,6 +47,7 @@
 
 #include <darma/utility/managed_swap_storage.h>
 #include <darma/impl/handle_use_base.h>
+#include <darma/impl/util/frontend_trace.h>
 #include <darma/interface/backend/mpi_interop_fwd.h>
 
 namespace darma {
@@ -130,7 +131,7 @@ class UseHolder : public UseHolderBase {
         private_ctor_tag,
         std::forward<UseCtorArgs>(args)...
       );
-      abstract::backend::get_backend_runtime()->register_use(rv->use_base);
+      register_use_traced(rv->use_base);
       return rv;
     }
 
@@ -164,7 +165,7 @@ class UseHolder : public UseHolderBase {
       assert(use_ || !"Can't release Use when UseHolder doesn't contain a registered Use!");
       use_->establishes_alias_ = could_be_alias;
       if(context == nullptr) {
-        abstract::backend::get_backend_runtime()->release_use(use_.get());
+        release_use_traced(use_.get());
       }
       else if(collection_token != nullptr) {
         darma::backend::release_persistent_collection(context, collection_token);
@@ -182,8 +183,8 @@ class UseHolder : public UseHolderBase {
       use_.swap_with_callback_before_destruction(
         std::forward<UnderlyingUse>(new_use),
         [](UnderlyingUse& to_be_registered, UnderlyingUse& to_be_released) {
-          abstract::backend::get_backend_runtime()->register_use(&to_be_registered);
-          abstract::backend::get_backend_runtime()->release_use(&to_be_released);
+          register_use_traced(&to_be_registered);
+          release_use_traced(&to_be_released);
         }
       );
     }
@@ -193,7 +194,7 @@ class UseHolder : public UseHolderBase {
       if (!is_use_registered) {
         assert(use_ || !"Can't register Use when UseHolder doesn't contain a registered Use!");
         is_use_registered = true;
-        abstract::backend::get_backend_runtime()->register_use(this->use_base);      
+        register_use_traced(this->use_base);
       }
     }
 
@@ -211,8 +212,8 @@ class UseHolder : public UseHolderBase {
       assert(use_ || !"Can't replace Use when UseHolder doesn't contain a registered Use!");
       use_.swap_with_callback_before_destruction(
         [](UnderlyingUse& to_be_registered, UnderlyingUse& to_be_released) {
-          abstract::backend::get_backend_runtime()->register_use(&to_be_registered);
-          abstract::backend::get_backend_runtime()->release_use(&to_be_released);
+          register_use_traced(&to_be_registered);
+          release_use_traced(&to_be_released);
         },
         utility::in_place_tag,
         std::forward<Arg1>(a1),
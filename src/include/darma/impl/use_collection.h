@@ -211,10 +211,12 @@ class UnmappedUseCollection final /* final for now, at least */
 
     bool is_mapped() const final { return false; }
 
-    abstract::frontend::UseCollection::index_iterable<size_t>
-    local_indices_for(size_t task_index) const final {
-      assert(!"local_indices_for() called on unmapped UseCollection");
-      return { }; // unreachable
+    void
+    visit_local_indices_for(
+      size_t task_index,
+      abstract::frontend::UseCollection::LocalIndexVisitor& visitor
+    ) const final {
+      assert(!"visit_local_indices_for() called on unmapped UseCollection");
     }
 
     size_t
@@ -338,34 +340,14 @@ class MappedUseCollection final /* final for now, at least */
 
     bool is_mapped() const override { return true; }
 
-    abstract::frontend::UseCollection::index_iterable<size_t>
-    local_indices_for(size_t backend_task_index) const override {
-      // TODO cache this?
-      // TODO short buffer optimization for the return type?
-      // Map from backend task index to frontend handle index first:
-      // TODO do this more generally, rather than using index_iterable?
-      auto fe_handle_idxs = abstract::frontend::UseCollection::index_iterable<
-        typename mapping_traits_t::from_index_type
-      >{
-        mapping_traits_t::map_backward(
-          /* mapping= */ mapping_fe_handle_to_be_task_,
-          backend_task_index,
-          this->index_range_
-        )
-      };
-      // Now map the frontend handle indices to dense, backend handle indices:
-      abstract::frontend::UseCollection::index_iterable<std::size_t> rv;
-      rv.reserve(fe_handle_idxs.size());
-      for(auto&& fe_idx : fe_handle_idxs) {
-        rv.push_back(
-          base_t::mapping_to_dense_traits_t::map_forward(
-            /* mapping= */ this->mapping_to_dense_,
-            /* from= */ fe_idx,
-            /* from_range= */ this->index_range_
-          )
-        );
-      }
-      return rv;
+    void
+    visit_local_indices_for(
+      size_t backend_task_index,
+      abstract::frontend::UseCollection::LocalIndexVisitor& visitor
+    ) const override {
+      _visit_local_indices_for(backend_task_index, visitor,
+        typename _mapping_is_one_to_one::type{}
+      );
     }
 
     size_t
@@ -417,6 +399,72 @@ class MappedUseCollection final /* final for now, at least */
       this->BasicUseCollection<IndexRange>::serialize(ar);
     }
 
+  private:
+
+    using _mapping_is_one_to_one = std::is_same<
+      typename mapping_traits_t::from_multi_index_type,
+      typename mapping_traits_t::from_index_type
+    >;
+
+    size_t
+    _fe_handle_index_to_dense(
+      typename mapping_traits_t::from_index_type const& fe_idx
+    ) const {
+      return base_t::mapping_to_dense_traits_t::map_forward(
+        /* mapping= */ this->mapping_to_dense_,
+        /* from= */ fe_idx,
+        /* from_range= */ this->index_range_
+      );
+    }
+
+    // Fast path: exactly one local index, so no storage is needed at all
+    void
+    _visit_local_indices_for(
+      size_t backend_task_index,
+      abstract::frontend::UseCollection::LocalIndexVisitor& visitor,
+      std::true_type /* mapping is one-to-one */
+    ) const {
+      auto const dense_idx = _fe_handle_index_to_dense(
+        mapping_traits_t::map_backward(
+          /* mapping= */ mapping_fe_handle_to_be_task_,
+          backend_task_index,
+          this->index_range_
+        )
+      );
+      visitor.visit_interval(dense_idx, dense_idx + 1);
+    }
+
+    // General path: the only storage is whatever the user's mapping returns
+    // from map_backward(); consecutive dense indices are coalesced into
+    // intervals as they are mapped
+    void
+    _visit_local_indices_for(
+      size_t backend_task_index,
+      abstract::frontend::UseCollection::LocalIndexVisitor& visitor,
+      std::false_type /* mapping is not one-to-one */
+    ) const {
+      auto const& fe_handle_idxs = mapping_traits_t::map_backward(
+        /* mapping= */ mapping_fe_handle_to_be_task_,
+        backend_task_index,
+        this->index_range_
+      );
+      bool have_interval = false;
+      size_t interval_begin = 0, interval_end = 0;
+      for(auto&& fe_idx : fe_handle_idxs) {
+        auto const dense_idx = _fe_handle_index_to_dense(fe_idx);
+        if(have_interval and dense_idx == interval_end) {
+          ++interval_end;
+        }
+        else {
+          if(have_interval) visitor.visit_interval(interval_begin, interval_end);
+          interval_begin = dense_idx;
+          interval_end = dense_idx + 1;
+          have_interval = true;
+        }
+      }
+      if(have_interval) visitor.visit_interval(interval_begin, interval_end);
+    }
+
 
 };
 
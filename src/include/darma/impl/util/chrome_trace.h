@@ -0,0 +1,278 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                      chrome_trace.h
+//                         DARMA
+//              Copyright (C) 2017 NTESS, LLC
+//
+// Under the terms of Contract DE-NA-0003525 with NTESS, LLC,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact darma@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef DARMA_IMPL_UTIL_CHROME_TRACE_H
+#define DARMA_IMPL_UTIL_CHROME_TRACE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ostream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <darma_types.h>
+
+#include <darma/key/key_concept.h>
+#include <darma/interface/frontend/frontend_trace.h>
+
+namespace darma {
+namespace detail {
+
+//==============================================================================
+// <editor-fold desc="Chrome trace event format helpers"> {{{1
+
+inline void
+_write_json_string(std::ostream& o, std::string const& str) {
+  o << '"';
+  for(char c : str) {
+    switch(c) {
+      case '"': o << "\\\""; break;
+      case '\\': o << "\\\\"; break;
+      case '\n': o << "\\n"; break;
+      case '\t': o << "\\t"; break;
+      default:
+        if(static_cast<unsigned char>(c) < 0x20) {
+          char buf[8];
+          std::snprintf(buf, sizeof(buf), "\\u%04x", static_cast<unsigned>(c));
+          o << buf;
+        }
+        else {
+          o << c;
+        }
+    }
+  }
+  o << '"';
+}
+
+// Chrome trace timestamps and durations are in (fractional) microseconds
+inline void
+_write_trace_microseconds(std::ostream& o, std::uint64_t ns) {
+  char buf[32];
+  std::snprintf(buf, sizeof(buf), "%llu.%03u",
+    static_cast<unsigned long long>(ns / 1000),
+    static_cast<unsigned>(ns % 1000)
+  );
+  o << buf;
+}
+
+inline const char*
+_trace_event_category(abstract::frontend::TraceEventKind kind) {
+  using kind_t = abstract::frontend::TraceEventKind;
+  switch(kind) {
+    case kind_t::CreateWork: return "create_work";
+    case kind_t::CreateConcurrentWork: return "create_concurrent_work";
+    case kind_t::RunTask: return "run";
+    case kind_t::RegisterUse: return "register_use";
+    case kind_t::ReleaseUse: return "release_use";
+    case kind_t::MakeFlow: return "make_flow";
+    case kind_t::Publish: return "publish";
+    case kind_t::Fetch: return "fetch";
+    case kind_t::Allreduce: return "allreduce";
+  }
+  return "unknown";
+}
+
+inline std::string
+_trace_event_label(abstract::frontend::TraceEvent const& event) {
+  std::ostringstream sstr;
+  sstr << event.name;
+  auto rv = sstr.str();
+  if(rv.empty() and event.file != nullptr) {
+    auto const* base = std::strrchr(event.file, '/');
+    sstr << (base ? base + 1 : event.file) << ":" << event.line;
+    rv = sstr.str();
+  }
+  return rv;
+}
+
+inline void
+_write_trace_event_common(
+  std::ostream& o, abstract::frontend::TraceEvent const& event,
+  const char* phase, std::size_t pid
+) {
+  o << "\"ph\":\"" << phase << "\",\"ts\":";
+  _write_trace_microseconds(o, event.begin_ns);
+  o << ",\"pid\":" << pid << ",\"tid\":" << event.thread;
+}
+
+inline void
+_write_trace_event_args(
+  std::ostream& o, abstract::frontend::TraceEvent const& event
+) {
+  using kind_t = abstract::frontend::TraceEventKind;
+  o << ",\"args\":{";
+  const char* sep = "";
+  if(event.task_id != 0) {
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "0x%llx",
+      static_cast<unsigned long long>(event.task_id)
+    );
+    o << "\"task\":\"" << buf << "\"";
+    sep = ",";
+  }
+  if(event.index != abstract::frontend::TraceEvent::no_index) {
+    o << sep << "\"index\":" << event.index;
+    sep = ",";
+  }
+  if(event.kind == kind_t::MakeFlow) {
+    o << sep << "\"flow_relationship\":" << event.flow_relationship;
+    sep = ",";
+  }
+  if(event.file != nullptr) {
+    o << sep << "\"file\":";
+    _write_json_string(o, event.file);
+    o << ",\"line\":" << event.line;
+    sep = ",";
+  }
+  if(event.function != nullptr) {
+    o << sep << "\"function\":";
+    _write_json_string(o, event.function);
+  }
+  o << "}";
+}
+
+// </editor-fold> end Chrome trace event format helpers }}}1
+//==============================================================================
+
+} // end namespace detail
+
+namespace frontend {
+
+inline void
+write_chrome_trace(
+  std::ostream& o,
+  std::vector<abstract::frontend::TraceEvent> const& events,
+  std::size_t pid /* = 0 */
+) {
+  using kind_t = abstract::frontend::TraceEventKind;
+  using abstract::frontend::TraceEvent;
+
+  // Task addresses can be reused once a task is destroyed, so creation and
+  // run events have to be matched up in time order
+  std::vector<TraceEvent const*> sorted;
+  sorted.reserve(events.size());
+  for(auto const& event : events) sorted.push_back(&event);
+  std::stable_sort(sorted.begin(), sorted.end(),
+    [](TraceEvent const* a, TraceEvent const* b) {
+      return a->begin_ns < b->begin_ns;
+    }
+  );
+
+  struct created_task_t {
+    std::string label;
+    std::size_t flow_id;
+  };
+  std::unordered_map<std::uintptr_t, created_task_t> created_tasks;
+  std::size_t next_flow_id = 0;
+  std::set<std::uint32_t> threads;
+
+  o << "{\"traceEvents\":[";
+  const char* sep = "\n";
+
+  for(auto const* event_ptr : sorted) {
+    auto const& event = *event_ptr;
+    threads.insert(event.thread);
+
+    auto label = detail::_trace_event_label(event);
+    if(event.kind == kind_t::RunTask and event.task_id != 0) {
+      auto found = created_tasks.find(event.task_id);
+      if(found != created_tasks.end()) {
+        if(label.empty()) label = found->second.label;
+        o << sep << "{\"name\":\"task\",\"cat\":\"task_flow\",\"id\":"
+          << found->second.flow_id << ",\"bp\":\"e\",";
+        detail::_write_trace_event_common(o, event, "f", pid);
+        o << "}";
+        sep = ",\n";
+        created_tasks.erase(found);
+      }
+    }
+    if(label.empty()) label = detail::_trace_event_category(event.kind);
+
+    o << sep << "{\"name\":";
+    detail::_write_json_string(o, label);
+    o << ",\"cat\":\"" << detail::_trace_event_category(event.kind) << "\",";
+    if(event.kind == kind_t::MakeFlow) {
+      detail::_write_trace_event_common(o, event, "i", pid);
+      o << ",\"s\":\"t\"";
+    }
+    else {
+      detail::_write_trace_event_common(o, event, "X", pid);
+      o << ",\"dur\":";
+      detail::_write_trace_microseconds(o, event.duration_ns);
+    }
+    detail::_write_trace_event_args(o, event);
+    o << "}";
+    sep = ",\n";
+
+    if(event.kind == kind_t::CreateWork and event.task_id != 0) {
+      auto const flow_id = next_flow_id++;
+      created_tasks[event.task_id] = created_task_t{ label, flow_id };
+      o << sep << "{\"name\":\"task\",\"cat\":\"task_flow\",\"id\":"
+        << flow_id << ",";
+      detail::_write_trace_event_common(o, event, "s", pid);
+      o << "}";
+    }
+  }
+
+  for(auto thread : threads) {
+    o << sep << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid
+      << ",\"tid\":" << thread << ",\"args\":{\"name\":\"darma thread "
+      << thread << "\"}}";
+    sep = ",\n";
+  }
+
+  o << "\n],\"displayTimeUnit\":\"ns\"}\n";
+}
+
+} // end namespace frontend
+
+} // end namespace darma
+
+#endif //DARMA_IMPL_UTIL_CHROME_TRACE_H
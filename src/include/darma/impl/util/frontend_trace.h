@@ -0,0 +1,268 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                      frontend_trace.h
+//                         DARMA
+//              Copyright (C) 2017 NTESS, LLC
+//
+// Under the terms of Contract DE-NA-0003525 with NTESS, LLC,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact darma@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef DARMA_IMPL_UTIL_FRONTEND_TRACE_H
+#define DARMA_IMPL_UTIL_FRONTEND_TRACE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <darma_types.h>
+
+#include <darma/interface/backend/runtime.h>
+#include <darma/interface/frontend/flow_relationship.h>
+#include <darma/interface/frontend/frontend_trace.h>
+#include <darma/interface/frontend/use.h>
+#include <darma/impl/util/chrome_trace.h>
+#include <darma/impl/util/per_thread_ring_buffer.h>
+
+namespace darma {
+namespace detail {
+
+//==============================================================================
+// <editor-fold desc="trace event recording"> {{{1
+
+#if DARMA_TRACE_FRONTEND
+
+using trace_event_buffers_t = PerThreadRingBuffers<
+  abstract::frontend::TraceEvent
+>;
+
+inline std::uint64_t
+_trace_now_ns() {
+  using clock_t = std::chrono::steady_clock;
+  static const auto epoch = clock_t::now();
+  return static_cast<std::uint64_t>(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(
+      clock_t::now() - epoch
+    ).count()
+  );
+}
+
+inline std::uint32_t
+_trace_thread_id() {
+  static std::atomic<std::uint32_t> next_thread_id = { 0 };
+  thread_local std::uint32_t const thread_id = next_thread_id.fetch_add(
+    1, std::memory_order_relaxed
+  );
+  return thread_id;
+}
+
+inline void
+_record_trace_event(abstract::frontend::TraceEvent&& event) {
+  event.thread = _trace_thread_id();
+  trace_event_buffers_t::local_buffer(
+    DARMA_TRACE_FRONTEND_BUFFER_SIZE
+  ).try_push(std::move(event));
+}
+
+#endif // DARMA_TRACE_FRONTEND
+
+// Records an event spanning the lifetime of the object (does nothing unless
+// DARMA_TRACE_FRONTEND); the setters only have to be valid until destruction
+class TraceSpan {
+  public:
+
+    using kind_t = abstract::frontend::TraceEventKind;
+
+#if DARMA_TRACE_FRONTEND
+    explicit
+    TraceSpan(kind_t kind) {
+      event_.kind = kind;
+      event_.begin_ns = _trace_now_ns();
+    }
+
+    ~TraceSpan() {
+      event_.duration_ns = _trace_now_ns() - event_.begin_ns;
+      _record_trace_event(std::move(event_));
+    }
+
+    TraceSpan& set_name(types::key_t const& name) {
+      event_.name = name;
+      return *this;
+    }
+
+    TraceSpan& set_task_id(void const* task) {
+      event_.task_id = reinterpret_cast<std::uintptr_t>(task);
+      return *this;
+    }
+
+    TraceSpan& set_index(std::size_t index) {
+      event_.index = index;
+      return *this;
+    }
+
+    TraceSpan& set_source_location(
+      const char* file, std::size_t line, const char* function
+    ) {
+      event_.file = file;
+      event_.line = line;
+      event_.function = function;
+      return *this;
+    }
+
+    // Task events: the name and address of a Task or TaskCollection
+    template <typename TaskT>
+    TraceSpan& set_task(TaskT const& task) {
+      return set_name(task.get_name()).set_task_id(&task);
+    }
+
+    // Use events: the handle key, plus a MakeFlow event for each flow that
+    // isn't just the same as one the backend already has
+    TraceSpan& set_use(abstract::frontend::UsePendingRegistration const& use) {
+      set_use(static_cast<abstract::frontend::Use const&>(use));
+      _record_make_flow(use.get_in_flow_relationship());
+      _record_make_flow(use.get_out_flow_relationship());
+      return *this;
+    }
+
+    TraceSpan& set_use(abstract::frontend::Use const& use) {
+      if(auto handle = use.get_handle()) set_name(handle->get_key());
+      return *this;
+    }
+
+  private:
+
+    void _record_make_flow(abstract::frontend::FlowRelationship const& rel) {
+      using abstract::frontend::FlowRelationship;
+      auto const desc = rel.description();
+      if(desc == FlowRelationship::Same) return;
+      abstract::frontend::TraceEvent flow_event;
+      flow_event.kind = kind_t::MakeFlow;
+      flow_event.begin_ns = _trace_now_ns();
+      flow_event.name = event_.name;
+      flow_event.flow_relationship = static_cast<std::uint32_t>(desc);
+      _record_trace_event(std::move(flow_event));
+    }
+
+    abstract::frontend::TraceEvent event_;
+#else
+    explicit TraceSpan(kind_t) { }
+    TraceSpan& set_name(types::key_t const&) { return *this; }
+    TraceSpan& set_task_id(void const*) { return *this; }
+    TraceSpan& set_index(std::size_t) { return *this; }
+    TraceSpan& set_source_location(const char*, std::size_t, const char*) {
+      return *this;
+    }
+    template <typename TaskT>
+    TraceSpan& set_task(TaskT const&) { return *this; }
+    TraceSpan& set_use(abstract::frontend::Use const&) { return *this; }
+#endif
+
+  public:
+
+    TraceSpan(TraceSpan const&) = delete;
+    TraceSpan& operator=(TraceSpan const&) = delete;
+};
+
+// </editor-fold> end trace event recording }}}1
+//==============================================================================
+
+//==============================================================================
+// <editor-fold desc="traced Use registration and release"> {{{1
+
+// All Use registrations and releases through a UseHolder go through these
+
+inline void
+register_use_traced(abstract::frontend::UsePendingRegistration* use) {
+#if DARMA_TRACE_FRONTEND
+  using abstract::frontend::FlowRelationship;
+  TraceSpan span(
+    (use->get_in_flow_relationship().description() & FlowRelationship::Fetching)
+      ? TraceSpan::kind_t::Fetch : TraceSpan::kind_t::RegisterUse
+  );
+  span.set_use(*use);
+#endif
+  abstract::backend::get_backend_runtime()->register_use(use);
+}
+
+inline void
+release_use_traced(abstract::frontend::UsePendingRelease* use) {
+#if DARMA_TRACE_FRONTEND
+  TraceSpan span(TraceSpan::kind_t::ReleaseUse);
+  span.set_use(*use);
+#endif
+  abstract::backend::get_backend_runtime()->release_use(use);
+}
+
+// </editor-fold> end traced Use registration and release }}}1
+//==============================================================================
+
+} // end namespace detail
+
+namespace frontend {
+
+inline std::size_t
+collect_trace_events(
+  std::vector<abstract::frontend::TraceEvent>& events
+) {
+#if DARMA_TRACE_FRONTEND
+  return detail::trace_event_buffers_t::drain_all(
+    [&](abstract::frontend::TraceEvent&& event) {
+      events.push_back(std::move(event));
+    }
+  );
+#else
+  return 0;
+#endif
+}
+
+inline std::size_t
+n_dropped_trace_events() {
+#if DARMA_TRACE_FRONTEND
+  return detail::trace_event_buffers_t::n_dropped();
+#else
+  return 0;
+#endif
+}
+
+} // end namespace frontend
+
+} // end namespace darma
+
+#endif //DARMA_IMPL_UTIL_FRONTEND_TRACE_H
@@ -0,0 +1,219 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                      per_thread_ring_buffer.h
+//                         DARMA
+//              Copyright (C) 2017 NTESS, LLC
+//
+// Under the terms of Contract DE-NA-0003525 with NTESS, LLC,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact darma@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef DARMA_IMPL_UTIL_PER_THREAD_RING_BUFFER_H
+#define DARMA_IMPL_UTIL_PER_THREAD_RING_BUFFER_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace darma {
+namespace detail {
+
+// A bounded, lock-free ring buffer for exactly one producer thread and one
+// consumer thread at a time.  Pushes into a full buffer are dropped (and
+// counted) rather than blocking the producer.
+template <typename T>
+class SPSCRingBuffer {
+  public:
+
+    explicit
+    SPSCRingBuffer(std::size_t min_capacity)
+      : capacity_(_round_up_to_power_of_two(min_capacity)),
+        mask_(capacity_ - 1),
+        slots_(new T[capacity_])
+    { }
+
+    SPSCRingBuffer(SPSCRingBuffer const&) = delete;
+    SPSCRingBuffer& operator=(SPSCRingBuffer const&) = delete;
+
+    // Producer side only
+    template <typename U>
+    bool
+    try_push(U&& value) {
+      auto const head = head_.load(std::memory_order_relaxed);
+      if(head - tail_.load(std::memory_order_acquire) == capacity_) {
+        n_dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      }
+      slots_[head & mask_] = std::forward<U>(value);
+      head_.store(head + 1, std::memory_order_release);
+      return true;
+    }
+
+    // Consumer side only; calls f on each value pushed since the last drain,
+    // oldest first, and returns the number of values drained
+    template <typename Callable>
+    std::size_t
+    drain(Callable&& f) {
+      auto tail = tail_.load(std::memory_order_relaxed);
+      auto const head = head_.load(std::memory_order_acquire);
+      std::size_t n_drained = 0;
+      for(; tail != head; ++tail, ++n_drained) {
+        f(std::move(slots_[tail & mask_]));
+      }
+      tail_.store(tail, std::memory_order_release);
+      return n_drained;
+    }
+
+    bool
+    empty() const {
+      return head_.load(std::memory_order_acquire)
+        == tail_.load(std::memory_order_acquire);
+    }
+
+    std::size_t capacity() const { return capacity_; }
+
+    std::size_t
+    n_dropped() const {
+      return n_dropped_.load(std::memory_order_relaxed);
+    }
+
+  private:
+
+    static std::size_t
+    _round_up_to_power_of_two(std::size_t n) {
+      std::size_t rv = 1;
+      while(rv < n) rv <<= 1;
+      return rv;
+    }
+
+    std::size_t const capacity_;
+    std::size_t const mask_;
+    std::unique_ptr<T[]> slots_;
+    std::atomic<std::size_t> head_ = { 0 };
+    std::atomic<std::size_t> tail_ = { 0 };
+    std::atomic<std::size_t> n_dropped_ = { 0 };
+};
+
+// One SPSCRingBuffer per thread that records into it, with a process-wide
+// list of them for the (single) consumer to drain.  Only a thread's first
+// call to local_buffer() takes a lock; after that, recording is lock-free.
+// Tag distinguishes otherwise identical sets of buffers.
+template <typename T, typename Tag=T>
+class PerThreadRingBuffers {
+  public:
+
+    using buffer_t = SPSCRingBuffer<T>;
+
+    static buffer_t&
+    local_buffer(std::size_t min_capacity) {
+      // The registry shares ownership, so that values recorded by a thread
+      // can still be drained after the thread exits
+      static thread_local std::shared_ptr<buffer_t> local =
+        _register_new_buffer(min_capacity);
+      return *local;
+    }
+
+    // Calls f on every value recorded (by any thread) since the last call.
+    // Safe to call while other threads are recording, but not concurrently
+    // with itself.
+    template <typename Callable>
+    static std::size_t
+    drain_all(Callable&& f) {
+      auto& reg = _get_registry();
+      std::lock_guard<std::mutex> lock(reg.mutex);
+      std::size_t n_drained = 0;
+      for(auto& buffer : reg.buffers) {
+        n_drained += buffer->drain(f);
+      }
+      // forget buffers of threads that have exited (but keep their drop
+      // counts)
+      auto new_end = reg.buffers.begin();
+      for(auto& buffer : reg.buffers) {
+        if(buffer.use_count() == 1 and buffer->empty()) {
+          reg.n_dropped_by_exited_threads += buffer->n_dropped();
+        }
+        else {
+          *new_end++ = std::move(buffer);
+        }
+      }
+      reg.buffers.erase(new_end, reg.buffers.end());
+      return n_drained;
+    }
+
+    // Total number of values dropped because a thread's buffer was full
+    static std::size_t
+    n_dropped() {
+      auto& reg = _get_registry();
+      std::lock_guard<std::mutex> lock(reg.mutex);
+      auto rv = reg.n_dropped_by_exited_threads;
+      for(auto const& buffer : reg.buffers) {
+        rv += buffer->n_dropped();
+      }
+      return rv;
+    }
+
+  private:
+
+    struct _registry {
+      std::mutex mutex;
+      std::vector<std::shared_ptr<buffer_t>> buffers;
+      std::size_t n_dropped_by_exited_threads = 0;
+    };
+
+    static _registry&
+    _get_registry() {
+      static _registry reg;
+      return reg;
+    }
+
+    static std::shared_ptr<buffer_t>
+    _register_new_buffer(std::size_t min_capacity) {
+      auto rv = std::make_shared<buffer_t>(min_capacity);
+      auto& reg = _get_registry();
+      std::lock_guard<std::mutex> lock(reg.mutex);
+      reg.buffers.push_back(rv);
+      return rv;
+    }
+};
+
+} // end namespace detail
+} // end namespace darma
+
+#endif //DARMA_IMPL_UTIL_PER_THREAD_RING_BUFFER_H
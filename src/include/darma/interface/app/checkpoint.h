@@ -0,0 +1,388 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                      checkpoint.h
+//                         DARMA
+//              Copyright (C) 2017 NTESS, LLC
+//
+// Under the terms of Contract DE-NA-0003525 with NTESS, LLC,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact darma@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef DARMA_INTERFACE_APP_CHECKPOINT_H
+#define DARMA_INTERFACE_APP_CHECKPOINT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <darma_types.h>
+
+#include <darma/interface/app/access_handle.h>
+#include <darma/interface/frontend/serialization_manager.h>
+#include <darma/impl/handle_attorneys.h>
+#include <darma/impl/checkpoint/mapped_file.h>
+#include <darma/impl/serialization/manager.h>
+#include <darma/key/key_concept.h>
+#include <darma/key/dependent_on/serialization/key_serialization.h>
+
+namespace darma {
+
+namespace detail {
+
+// <editor-fold desc="checkpoint file format">
+
+// File layout:
+//   CheckpointFileHeader
+//   CheckpointIndexEntry[n_entries]
+//   (packed key, packed data)[n_entries], each aligned to
+//     checkpoint_blob_alignment
+// All offsets are from the beginning of the file.
+
+static constexpr char checkpoint_file_magic[8] =
+  { 'D', 'A', 'R', 'M', 'A', 'C', 'K', 'P' };
+static constexpr uint64_t checkpoint_file_version = 1;
+static constexpr std::size_t checkpoint_blob_alignment = alignof(std::max_align_t);
+
+struct CheckpointFileHeader {
+  char magic[8];
+  uint64_t version;
+  uint64_t n_entries;
+  uint64_t file_size;
+};
+
+struct CheckpointIndexEntry {
+  uint64_t key_offset;
+  uint64_t key_size;
+  uint64_t data_offset;
+  uint64_t data_size;
+  // sizeof(T) and _checkpoint_type_hash<T>() for the handle's value type;
+  // both are checked on restore
+  uint64_t metadata_size;
+  uint64_t type_hash;
+};
+
+// FNV-1a hash of the name of T.  typeid names are only stable for a given
+// compiler and ABI, which is all that restarting a given build requires.
+template <typename T>
+uint64_t
+_checkpoint_type_hash() {
+  uint64_t hash = 14695981039346656037ull;
+  for(char const* c = typeid(T).name(); *c != '\0'; ++c) {
+    hash ^= static_cast<unsigned char>(*c);
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+inline std::size_t
+_checkpoint_align(std::size_t offset) {
+  return (offset + checkpoint_blob_alignment - 1)
+    & ~(checkpoint_blob_alignment - 1);
+}
+
+// </editor-fold> end checkpoint file format
+
+} // end namespace detail
+
+/** @brief Collects a set of `AccessHandle`s and writes their data, indexed by
+ *  the handles' keys, into a single memory-mapped checkpoint file.
+ *
+ *  Each handle must have (at least) immediate read permissions when it is
+ *  added and must remain valid, with its data unchanged, until write() returns.
+ *  Data is packed through the handle's SerializationManager directly into the
+ *  mapped file, so no intermediate buffer is allocated.
+ *
+ *  @sa write_checkpoint(), Checkpoint
+ */
+class CheckpointWriter {
+  public:
+
+    template <typename AccessHandleT,
+      typename=std::enable_if_t<
+        detail::decayed_is_access_handle<AccessHandleT>::value
+      >
+    >
+    CheckpointWriter&
+    add(AccessHandleT const& handle) {
+      auto const& key = handle.get_key();
+      DARMA_ASSERT_MESSAGE(
+        not detail::key_traits<types::key_t>::needs_backend_key(key),
+        "Can't checkpoint a handle without a user-defined key"
+      );
+      entries_.push_back(_pending_entry{
+        key,
+        detail::access_attorneys::for_AccessHandle::get_serialization_manager(
+          handle
+        ),
+        std::addressof(handle.get_value()),
+        detail::_checkpoint_type_hash<
+          std::remove_cv_t<typename AccessHandleT::value_type>
+        >()
+      });
+      return *this;
+    }
+
+    std::size_t size() const { return entries_.size(); }
+
+    /** @brief Write the data for all of the handles added so far into the
+     *  file at `path`, replacing any existing file
+     *
+     *  @return the size of the checkpoint file, in bytes
+     */
+    std::size_t
+    write(std::string const& path) const {
+      using namespace darma::detail;
+
+      // Compute the layout first, so that the file can be mapped once with
+      // its final size
+      std::vector<CheckpointIndexEntry> index(entries_.size());
+      std::size_t offset = _checkpoint_align(
+        sizeof(CheckpointFileHeader)
+          + entries_.size() * sizeof(CheckpointIndexEntry)
+      );
+      for(std::size_t i = 0; i < entries_.size(); ++i) {
+        auto const& entry = entries_[i];
+        index[i].key_offset = offset;
+        index[i].key_size = key_ser_.get_packed_data_size(&entry.key, nullptr);
+        offset = _checkpoint_align(offset + index[i].key_size);
+        index[i].data_offset = offset;
+        index[i].data_size = entry.ser_man->get_packed_data_size(
+          entry.data, nullptr
+        );
+        index[i].metadata_size = entry.ser_man->get_metadata_size();
+        index[i].type_hash = entry.type_hash;
+        offset = _checkpoint_align(offset + index[i].data_size);
+      }
+
+      MappedFile file(path, offset);
+      auto* const base = static_cast<char*>(file.data());
+
+      CheckpointFileHeader header;
+      std::memcpy(header.magic, checkpoint_file_magic, sizeof(header.magic));
+      header.version = checkpoint_file_version;
+      header.n_entries = entries_.size();
+      header.file_size = offset;
+      std::memcpy(base, &header, sizeof(header));
+      if(not index.empty()) {
+        std::memcpy(
+          base + sizeof(header), index.data(),
+          index.size() * sizeof(CheckpointIndexEntry)
+        );
+      }
+
+      for(std::size_t i = 0; i < entries_.size(); ++i) {
+        auto const& entry = entries_[i];
+        key_ser_.pack_data(&entry.key, base + index[i].key_offset, nullptr);
+        entry.ser_man->pack_data(
+          entry.data, base + index[i].data_offset, nullptr
+        );
+      }
+
+      file.sync();
+      return offset;
+    }
+
+  private:
+
+    struct _pending_entry {
+      types::key_t key;
+      abstract::frontend::SerializationManager const* ser_man;
+      void const* data;
+      uint64_t type_hash;
+    };
+
+    std::vector<_pending_entry> entries_;
+
+    serialization::detail::SerializationManagerForType<types::key_t> key_ser_;
+
+};
+
+/** @brief Write the data of `handles` into a single checkpoint file at `path`
+ *
+ *  @sa CheckpointWriter
+ */
+template <typename... AccessHandles>
+std::size_t
+write_checkpoint(std::string const& path, AccessHandles const&... handles) {
+  CheckpointWriter writer;
+  // (expansion trick to call add() on each handle in order)
+  std::initializer_list<int> _ignored = { 0, (writer.add(handles), 0)... };
+  (void)_ignored;
+  return writer.write(path);
+}
+
+/** @brief A checkpoint file written by CheckpointWriter, mapped for restart.
+ *
+ *  Opening a Checkpoint only maps the file and reads its index; no data is
+ *  unpacked (or even paged in) until the corresponding handle is restored, so
+ *  the cost of a restart scales with the data actually touched.
+ */
+class Checkpoint {
+  public:
+
+    explicit
+    Checkpoint(std::string const& path)
+      : file_(path)
+    {
+      using namespace darma::detail;
+
+      DARMA_ASSERT_MESSAGE(
+        file_.size() >= sizeof(CheckpointFileHeader),
+        "File is too small to be a DARMA checkpoint"
+      );
+      auto const* const base = static_cast<char const*>(file_.data());
+      CheckpointFileHeader header;
+      std::memcpy(&header, base, sizeof(header));
+      DARMA_ASSERT_MESSAGE(
+        std::memcmp(header.magic, checkpoint_file_magic, sizeof(header.magic))
+          == 0 and header.version == checkpoint_file_version
+          and header.file_size == file_.size(),
+        "File is not a DARMA checkpoint (or was written by a different version)"
+      );
+      DARMA_ASSERT_MESSAGE(
+        header.n_entries
+          <= (file_.size() - sizeof(header)) / sizeof(CheckpointIndexEntry),
+        "Checkpoint file index is truncated"
+      );
+
+      auto const* entries = reinterpret_cast<CheckpointIndexEntry const*>(
+        base + sizeof(header)
+      );
+      index_.reserve(header.n_entries);
+      for(std::size_t i = 0; i < header.n_entries; ++i) {
+        // (written so that none of the sums can overflow)
+        DARMA_ASSERT_MESSAGE(
+          entries[i].key_offset <= file_.size()
+            and entries[i].key_size <= file_.size() - entries[i].key_offset
+            and entries[i].data_offset <= file_.size()
+            and entries[i].data_size <= file_.size() - entries[i].data_offset,
+          "Checkpoint index entry " << i << " extends past the end of the file"
+        );
+        std::aligned_storage_t<sizeof(types::key_t), alignof(types::key_t)>
+          key_buffer;
+        key_ser_.unpack_data(
+          &key_buffer, base + entries[i].key_offset, nullptr
+        );
+        auto& key = *reinterpret_cast<types::key_t*>(&key_buffer);
+        auto inserted = index_.emplace(std::move(key), entries + i).second;
+        key_ser_.destroy(&key_buffer);
+        DARMA_ASSERT_MESSAGE(inserted, "Duplicate key in checkpoint file");
+      }
+    }
+
+    Checkpoint(Checkpoint&&) = default;
+    Checkpoint& operator=(Checkpoint&&) = default;
+
+    /// The number of handles stored in the checkpoint
+    std::size_t size() const { return index_.size(); }
+
+    bool
+    contains(types::key_t const& key) const {
+      return index_.find(key) != index_.end();
+    }
+
+    /// The number of entries unpacked so far by restore()
+    std::size_t n_entries_restored() const { return n_restored_; }
+
+    /** @brief Replace the value of `handle` with the checkpointed data stored
+     *  under `handle.get_key()`
+     *
+     *  The handle must have immediate modify permissions and must have the
+     *  same value type as the handle that was checkpointed under its key.
+     */
+    template <typename AccessHandleT,
+      typename=std::enable_if_t<
+        detail::decayed_is_access_handle<AccessHandleT>::value
+      >
+    >
+    void
+    restore(AccessHandleT const& handle) {
+      auto found = index_.find(handle.get_key());
+      DARMA_ASSERT_MESSAGE(found != index_.end(),
+        "restore() called on handle whose key is not in the checkpoint"
+      );
+      auto const& entry = *found->second;
+      auto const* ser_man =
+        detail::access_attorneys::for_AccessHandle::get_serialization_manager(
+          handle
+        );
+      DARMA_ASSERT_MESSAGE(
+        entry.metadata_size == ser_man->get_metadata_size()
+          and entry.type_hash == detail::_checkpoint_type_hash<
+            std::remove_cv_t<typename AccessHandleT::value_type>
+          >(),
+        "restore() called on handle with a different value type than the"
+        " checkpointed handle"
+      );
+      void* dest = std::addressof(handle.get_reference());
+      // unpack_data() constructs in place, so the existing value must go first
+      ser_man->destroy(dest);
+      ser_man->unpack_data(
+        dest, static_cast<char const*>(file_.data()) + entry.data_offset,
+        nullptr
+      );
+      ++n_restored_;
+    }
+
+  private:
+
+    using _key_traits_t = detail::key_traits<types::key_t>;
+
+    detail::MappedFile file_;
+
+    std::unordered_map<
+      types::key_t, detail::CheckpointIndexEntry const*,
+      typename _key_traits_t::hasher, typename _key_traits_t::key_equal
+    > index_;
+
+    std::size_t n_restored_ = 0;
+
+    serialization::detail::SerializationManagerForType<types::key_t> key_ser_;
+
+};
+
+} // end namespace darma
+
+#endif //DARMA_INTERFACE_APP_CHECKPOINT_H
@@ -60,5 +60,10 @@
 #include <darma/interface/app/containers.h>
 
 #include <darma/interface/app/backend_hint.h>
+#include <darma/interface/app/serialization_traits.h>
+#include <darma/interface/app/checkpoint.h>
+#include <darma/interface/app/moved_capture.h>
+#include <darma/interface/app/task_affinity.h>
+#include <darma/interface/app/task_priority.h>
 
 #endif /* SRC_INTERFACE_APP_DARMA_H_ */
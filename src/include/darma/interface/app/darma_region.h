@@ -47,11 +47,19 @@
 
 #include <darma/impl/feature_testing_macros.h>
 #include <darma/interface/backend/darma_region.h>
+#include <darma/interface/app/region_handle.h>
 
 #if _darma_has_feature(darma_regions)
 
+#include <atomic>
+#include <functional>
+#include <future>
+#include <memory>
+#include <utility>
+
 #include <darma_types.h>
 #include <darma/interface/backend/runtime.h>
+#include <darma/utility/darma_assert.h>
 
 namespace darma {
 namespace experimental {
@@ -129,6 +137,196 @@ darma_region(Callable&& callable) {
   return done_future;
 }
 
+/** @brief Create an additional runtime instance, so that regions launched on
+ *  it with darma_region_async() complete independently of regions on other
+ *  instances
+ */
+inline darma::types::runtime_instance_token_t
+make_runtime_instance() {
+  return backend::initialize_runtime_instance();
+}
+
+/** @brief Launch a region on the given runtime instance without waiting for
+ *  it to finish, returning a RegionHandle that completes when the instance
+ *  becomes quiescent.
+ *
+ *  Any number of regions may be in flight at once.  Regions launched on the
+ *  same instance complete together (when all of the instance's work drains),
+ *  so use a separate instance (see make_runtime_instance()) for each region
+ *  that needs its own completion.  The token is taken by value, like any
+ *  other handle, so `darma_region_async(make_runtime_instance(), ...)` works.
+ */
+template <typename Callable>
+RegionHandle
+darma_region_async(
+  darma::types::runtime_instance_token_t instance,
+  Callable&& callable
+) {
+  auto state = std::make_shared<_impl::RegionCompletionState>();
+  backend::register_runtime_instance_quiescence_callback(
+    instance,
+    std::function<void()>([state]{ state->set_done(); })
+  );
+  backend::with_active_runtime_instance(
+    instance,
+    std::forward<Callable>(callable)
+  );
+  return RegionHandle(std::move(state));
+}
+
+/** @brief Launch a region on the default runtime instance without waiting for
+ *  it to finish (see the overload taking a runtime instance)
+ */
+template <typename Callable>
+RegionHandle
+darma_region_async(Callable&& callable) {
+  return darma_region_async(
+    _impl::get_default_instance_token(),
+    std::forward<Callable>(callable)
+  );
+}
+
+/** @brief A region that stays open across repeated submissions, for codes
+ *  that enter and leave DARMA many times (e.g., once per iteration of an
+ *  MPI-driven outer loop).
+ *
+ *  Each call to submit() runs its callable on the region's runtime instance
+ *  and begins a new epoch; the epoch completes when the instance next becomes
+ *  quiescent.  Completion is tracked with an atomic epoch counter that can be
+ *  queried at any time (without registering callbacks or creating futures).
+ *  The region keeps at most one quiescence callback registered at a time:
+ *  submissions made while one is outstanding just advance the epoch, and the
+ *  callback registers a replacement (from within itself) if there were any.
+ *  No per-submission heap allocations are made by the frontend.
+ *
+ *  The backend must run the callable given to with_active_runtime_instance()
+ *  before returning from it (this is asserted), and must allow quiescence
+ *  callbacks to register further callbacks.  submit() must not be called
+ *  concurrently on the same region.
+ *
+ *  The region keeps its own copy of the runtime instance token, and the
+ *  destructor waits for all submitted work to complete.
+ */
+class PersistentRegion {
+  public:
+
+    PersistentRegion()
+      : PersistentRegion(_impl::get_default_instance_token())
+    { }
+
+    explicit
+    PersistentRegion(darma::types::runtime_instance_token_t instance)
+      : state_(std::make_unique<_state_t>(std::move(instance)))
+    { }
+
+    PersistentRegion(PersistentRegion const&) = delete;
+    PersistentRegion(PersistentRegion&&) = default;
+    PersistentRegion& operator=(PersistentRegion const&) = delete;
+    PersistentRegion& operator=(PersistentRegion&&) = delete;
+
+    ~PersistentRegion() {
+      if(state_) wait_for_quiescence();
+    }
+
+    /** @brief Run `callable` in the region, returning the epoch that
+     *  completes once everything it spawned has finished
+     */
+    template <typename Callable>
+    std::size_t
+    submit(Callable&& callable) {
+      auto epoch = state_->counter.begin_epoch();
+      // As in darma_region(), the quiescence callback has to be registered
+      // before the work is launched, or the work could drain first.  If a
+      // callback for an earlier epoch is still outstanding, it re-registers
+      // itself when it sees this epoch.
+      state_->launched.store(epoch);
+      if(not state_->armed.exchange(true)) _arm(state_.get());
+      // Both of these are captured by reference, which is only safe because
+      // the backend has to run the callable before returning; the captures
+      // are small enough to be stored inside of the std::function, so this
+      // doesn't allocate
+      bool ran = false;
+      backend::with_active_runtime_instance(
+        state_->instance,
+        std::function<void()>([&callable, &ran]{
+          callable();
+          ran = true;
+        })
+      );
+      DARMA_ASSERT_MESSAGE(ran,
+        "PersistentRegion requires the backend to run the callable passed to"
+        " with_active_runtime_instance() before returning from it"
+      );
+      return epoch;
+    }
+
+    /** @brief The most recently submitted epoch (0 if nothing was submitted) */
+    std::size_t current_epoch() const { return state_->counter.current_epoch(); }
+
+    /** @brief All epochs up to and including this one have completed */
+    std::size_t completed_epoch() const {
+      return state_->counter.completed_epoch();
+    }
+
+    bool is_complete(std::size_t epoch) const {
+      return state_->counter.is_complete(epoch);
+    }
+
+    /** @brief true if all submitted work has completed */
+    bool is_quiescent() const { return state_->counter.is_quiescent(); }
+
+    void wait_for_epoch(std::size_t epoch) const {
+      state_->counter.wait_for_epoch(epoch);
+    }
+
+    void wait_for_quiescence() const {
+      state_->counter.wait_for_epoch(state_->counter.current_epoch());
+    }
+
+  private:
+
+    // Kept on the heap, so that it stays put for the quiescence callback if
+    // the region is moved
+    struct _state_t {
+      explicit _state_t(darma::types::runtime_instance_token_t&& in_instance)
+        : instance(std::move(in_instance))
+      { }
+
+      darma::types::runtime_instance_token_t instance;
+      _impl::RegionEpochCounter counter;
+      // the latest epoch submitted (set before its callable is run)
+      std::atomic<std::size_t> launched = { 0 };
+      // whether a quiescence callback is outstanding, and for which epoch
+      std::atomic<bool> armed = { false };
+      std::atomic<std::size_t> armed_epoch = { 0 };
+    };
+
+    // The caller must have set state->armed
+    static void
+    _arm(_state_t* state) {
+      state->armed_epoch.store(state->launched.load());
+      backend::register_runtime_instance_quiescence_callback(
+        state->instance,
+        std::function<void()>([state]{ _on_quiescence(state); })
+      );
+    }
+
+    static void
+    _on_quiescence(_state_t* state) {
+      auto const epoch = state->armed_epoch.load();
+      state->armed.store(false);
+      // Work launched since the callback was registered needs another one
+      if(state->launched.load() > epoch and not state->armed.exchange(true)) {
+        _arm(state);
+      }
+      // Last, since a waiting destructor may free the state as soon as the
+      // final epoch completes
+      state->counter.complete_epoch(epoch);
+    }
+
+    std::unique_ptr<_state_t> state_;
+};
+
 inline auto
 darma_initialize(int& argc, char**& argv) {
   backend::initialize_with_arguments(argc, argv);
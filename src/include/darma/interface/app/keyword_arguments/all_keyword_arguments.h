@@ -56,12 +56,17 @@
 #include <darma/interface/app/keyword_arguments/data.h>
 #include <darma/interface/app/keyword_arguments/index.h>
 #include <darma/interface/app/keyword_arguments/indices.h>
+#include <darma/interface/app/keyword_arguments/pieces.h>
+#include <darma/interface/app/keyword_arguments/zero_copy.h>
 #include <darma/interface/app/keyword_arguments/input.h>
 #include <darma/interface/app/keyword_arguments/output.h>
 #include <darma/interface/app/keyword_arguments/in_out.h>
 #include <darma/interface/app/keyword_arguments/tag.h>
 #include <darma/interface/app/keyword_arguments/is_parallel.h>
 #include <darma/interface/app/keyword_arguments/allow_aliasing.h>
+#include <darma/interface/app/keyword_arguments/affinity.h>
+#include <darma/interface/app/keyword_arguments/priority.h>
+#include <darma/interface/app/keyword_arguments/cost.h>
 #include <darma/interface/app/keyword_arguments/per.h>
 #include <darma/interface/app/keyword_arguments/depth.h>
 #include <darma/interface/app/keyword_arguments/to_handle.h>
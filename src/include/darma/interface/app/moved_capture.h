@@ -0,0 +1,146 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                      moved_capture.h
+//                         DARMA
+//              Copyright (C) 2017 NTESS, LLC
+//
+// Under the terms of Contract DE-NA-0003525 with NTESS, LLC,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact darma@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef DARMA_INTERFACE_APP_MOVED_CAPTURE_H
+#define DARMA_INTERFACE_APP_MOVED_CAPTURE_H
+
+#include <type_traits>
+#include <utility>
+
+#include <darma/impl/task/task_base.h>
+
+namespace darma {
+
+/** @brief A value captured by a `create_work` lambda that is moved, rather
+ *  than copied, into the task.
+ *
+ *  Lambda tasks are captured by copying the closure (so that the copy
+ *  constructors of captured `AccessHandle`s can do their work), which means
+ *  that other by-value captures get copied once into the closure and once
+ *  more into the task.  Wrapping a capture with darma::moved() skips the
+ *  second copy:
+ *
+ *  @code
+ *  create_work([=, params = darma::moved(std::move(params))]{
+ *    solve(h.get_value(), *params);
+ *  });
+ *  @endcode
+ *
+ *  The move only happens when the lambda is passed to `create_work` as an
+ *  rvalue; if it is passed as a named lambda (which could be used again),
+ *  the value is copied as usual.  Copies made outside of task creation
+ *  are always regular copies.
+ */
+template <typename T>
+class MovedCapture {
+  public:
+
+    using value_type = T;
+
+    template <
+      typename U,
+      typename=std::enable_if_t<
+        std::is_constructible<T, U&&>::value
+        and not std::is_same<std::decay_t<U>, MovedCapture>::value
+      >
+    >
+    explicit
+    MovedCapture(U&& val) : value_(std::forward<U>(val)) { }
+
+    MovedCapture(MovedCapture const& other)
+      : value_(
+          _is_moving_capture() ?
+            std::move(other.value_)
+            : T(other.value_)
+        )
+    { }
+
+    MovedCapture(MovedCapture&&) = default;
+
+    MovedCapture& operator=(MovedCapture const&) = default;
+    MovedCapture& operator=(MovedCapture&&) = default;
+
+    T& get() { return value_; }
+    T const& get() const { return value_; }
+
+    T& operator*() { return value_; }
+    T const& operator*() const { return value_; }
+
+    T* operator->() { return &value_; }
+    T const* operator->() const { return &value_; }
+
+  private:
+
+    static bool
+    _is_moving_capture() {
+      // (copies can be made with no runtime or no task running, e.g.,
+      // during setup)
+      auto* context = abstract::backend::get_backend_context();
+      if(context == nullptr) return false;
+      auto* running_task = detail::get_running_task_impl(context);
+      if(running_task == nullptr) return false;
+      auto* capture_manager = running_task->current_create_work_context;
+      // if so, the source is the caller's closure, which is discarded right
+      // after the capture, so it's safe to steal from it
+      return capture_manager != nullptr
+        and capture_manager->moves_captured_values;
+    }
+
+    // mutable so that the copy constructor can move out of the (const)
+    // closure being captured; see _is_moving_capture()
+    mutable T value_;
+};
+
+/** @brief Wrap a value captured by a `create_work` lambda so that it is moved
+ *  into the task rather than copied again (see MovedCapture)
+ */
+template <typename T>
+MovedCapture<std::decay_t<T>>
+moved(T&& val) {
+  return MovedCapture<std::decay_t<T>>(std::forward<T>(val));
+}
+
+} // end namespace darma
+
+#endif //DARMA_INTERFACE_APP_MOVED_CAPTURE_H
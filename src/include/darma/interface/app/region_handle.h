@@ -0,0 +1,273 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                      region_handle.h
+//                         DARMA
+//              Copyright (C) 2017 NTESS, LLC
+//
+// Under the terms of Contract DE-NA-0003525 with NTESS, LLC,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact darma@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef DARMA_INTERFACE_APP_REGION_HANDLE_H
+#define DARMA_INTERFACE_APP_REGION_HANDLE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace darma {
+namespace experimental {
+
+namespace _impl {
+
+// Shared between a RegionHandle (and its copies) and whatever completes it
+// (e.g., a runtime instance quiescence callback)
+class RegionCompletionState {
+  public:
+
+    bool
+    is_done() const {
+      return done_.load(std::memory_order_acquire);
+    }
+
+    void
+    set_done() {
+      std::vector<std::function<void()>> to_run;
+      {
+        std::lock_guard<std::mutex> lg(mutex_);
+        done_.store(true, std::memory_order_release);
+        to_run.swap(continuations_);
+      }
+      cv_.notify_all();
+      // run continuations outside of the lock, since they may launch other
+      // regions or add continuations of their own
+      for(auto& continuation : to_run) continuation();
+    }
+
+    void
+    wait() {
+      if(is_done()) return;
+      std::unique_lock<std::mutex> lk(mutex_);
+      cv_.wait(lk, [this]{ return is_done(); });
+    }
+
+    void
+    add_continuation(std::function<void()> continuation) {
+      {
+        std::lock_guard<std::mutex> lg(mutex_);
+        if(not is_done()) {
+          continuations_.push_back(std::move(continuation));
+          return;
+        }
+      }
+      // already done, so just run it here
+      continuation();
+    }
+
+  private:
+
+    std::atomic<bool> done_ = { false };
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::vector<std::function<void()>> continuations_;
+};
+
+// Epoch-based completion tracking for a PersistentRegion: each submission
+// begins a new epoch, and each quiescence of the runtime instance completes
+// (at least) the epoch that was current when its callback was registered.
+// Queries are plain atomic loads, so they can be made as often as needed;
+// only waiting takes the lock.
+class RegionEpochCounter {
+  public:
+
+    std::size_t
+    begin_epoch() {
+      return begun_.fetch_add(1, std::memory_order_acq_rel) + 1;
+    }
+
+    void
+    complete_epoch(std::size_t epoch) {
+      // Notify under the lock, since a waiter may destroy this as soon as it
+      // sees the epoch complete
+      std::lock_guard<std::mutex> lg(mutex_);
+      // quiescence at a given epoch implies all earlier epochs are complete,
+      // and callbacks may arrive out of order, so only ever move forward
+      if(completed_.load(std::memory_order_relaxed) < epoch) {
+        completed_.store(epoch, std::memory_order_release);
+      }
+      cv_.notify_all();
+    }
+
+    std::size_t
+    current_epoch() const {
+      return begun_.load(std::memory_order_acquire);
+    }
+
+    std::size_t
+    completed_epoch() const {
+      return completed_.load(std::memory_order_acquire);
+    }
+
+    bool
+    is_complete(std::size_t epoch) const {
+      return completed_epoch() >= epoch;
+    }
+
+    bool
+    is_quiescent() const {
+      return is_complete(current_epoch());
+    }
+
+    void
+    wait_for_epoch(std::size_t epoch) const {
+      // (always through the lock; see complete_epoch())
+      std::unique_lock<std::mutex> lk(mutex_);
+      cv_.wait(lk, [this, epoch]{ return is_complete(epoch); });
+    }
+
+  private:
+
+    std::atomic<std::size_t> begun_ = { 0 };
+    std::atomic<std::size_t> completed_ = { 0 };
+    mutable std::mutex mutex_;
+    mutable std::condition_variable cv_;
+};
+
+} // end namespace _impl
+
+/** @brief A completion handle for a region launched with
+ *  darma_region_async() (or for a continuation chained onto one).
+ *
+ *  Copies refer to the same region.  Completion can be polled with
+ *  is_ready() (which never blocks), waited on with wait(), or chained with
+ *  then(), so that, e.g., an MPI-driven outer loop can post the next region
+ *  from a continuation while the previous one drains:
+ *
+ *  @code
+ *  auto region = darma_region_async(instance, [&]{ ... });
+ *  auto next = region.then([&]{
+ *    return darma_region_async(instance, [&]{ ... });
+ *  });
+ *  while(not next.is_ready()) { progress_mpi(); }
+ *  @endcode
+ */
+class RegionHandle {
+  public:
+
+    RegionHandle()
+      : state_(std::make_shared<_impl::RegionCompletionState>())
+    { }
+
+    explicit
+    RegionHandle(std::shared_ptr<_impl::RegionCompletionState> state)
+      : state_(std::move(state))
+    { }
+
+    RegionHandle(RegionHandle const&) = default;
+    RegionHandle(RegionHandle&&) = default;
+    RegionHandle& operator=(RegionHandle const&) = default;
+    RegionHandle& operator=(RegionHandle&&) = default;
+
+    /** @brief true if all of the region's work has completed */
+    bool is_ready() const { return state_->is_done(); }
+
+    /** @brief Block until all of the region's work has completed */
+    void wait() const { state_->wait(); }
+
+    /** @brief Run `continuation` once the region completes (immediately, on
+     *  the calling thread, if it already has).
+     *
+     *  If `continuation` returns a RegionHandle (e.g., because it launches
+     *  another region), the returned handle completes when that region does;
+     *  otherwise, it completes when `continuation` returns.  Continuations
+     *  otherwise run on whichever thread completes the region, so they should
+     *  be short.
+     */
+    template <typename Callable>
+    RegionHandle
+    then(Callable&& continuation) const {
+      auto next = std::make_shared<_impl::RegionCompletionState>();
+      state_->add_continuation(
+        _make_continuation(next, std::forward<Callable>(continuation),
+          std::is_same<
+            std::decay_t<decltype(continuation())>, RegionHandle
+          >{}
+        )
+      );
+      return RegionHandle(std::move(next));
+    }
+
+  private:
+
+    template <typename Callable>
+    static std::function<void()>
+    _make_continuation(
+      std::shared_ptr<_impl::RegionCompletionState> const& next,
+      Callable&& continuation,
+      std::false_type /* continuation returns a RegionHandle */
+    ) {
+      return [next, continuation=std::forward<Callable>(continuation)]() mutable {
+        continuation();
+        next->set_done();
+      };
+    }
+
+    template <typename Callable>
+    static std::function<void()>
+    _make_continuation(
+      std::shared_ptr<_impl::RegionCompletionState> const& next,
+      Callable&& continuation,
+      std::true_type /* continuation returns a RegionHandle */
+    ) {
+      return [next, continuation=std::forward<Callable>(continuation)]() mutable {
+        RegionHandle inner = continuation();
+        inner.state_->add_continuation([next]{ next->set_done(); });
+      };
+    }
+
+    std::shared_ptr<_impl::RegionCompletionState> state_;
+};
+
+} // end namespace experimental
+} // end namespace darma
+
+#endif //DARMA_INTERFACE_APP_REGION_HANDLE_H
@@ -0,0 +1,108 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                      serialization_traits.h
+//                         DARMA
+//              Copyright (C) 2017 NTESS, LLC
+//
+// Under the terms of Contract DE-NA-0003525 with NTESS, LLC,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact darma@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef DARMA_INTERFACE_APP_SERIALIZATION_TRAITS_H
+#define DARMA_INTERFACE_APP_SERIALIZATION_TRAITS_H
+
+#include <cstdint>
+#include <type_traits>
+
+namespace darma {
+namespace serialization {
+
+/** @brief Codecs available for compressed packing (see
+ *  CompressingSerializationPolicy and compressed_packing_mode)
+ */
+enum class CompressionMode : uint8_t {
+  None,
+  /// Fast LZ-class byte compression
+  LZ,
+  /// Lossless XOR delta of consecutive 4-byte words, then LZ (float data)
+  FloatDeltaLZ,
+  /// Lossless XOR delta of consecutive 8-byte words, then LZ (double data)
+  DoubleDeltaLZ
+};
+
+/** @brief Specialize this (as `std::true_type`) for types whose packed size
+ *  never changes after construction (e.g., fixed-size meshes or tables that
+ *  are republished every iteration).
+ *
+ *  Backends that keep the size from the first pack of such an object can
+ *  then hand it back to SerializationManager::pack_data_with_allocator(),
+ *  which skips the sizing traversal.
+ */
+template <typename T, typename Enable=void>
+struct packed_size_is_invariant : std::false_type { };
+
+/** @brief Specialize this (as an `std::integral_constant<CompressionMode, ...>`)
+ *  to compress the payload of values of type T whenever the backend packs
+ *  them without its own SerializationPolicy.
+ *
+ *  Only applies to types whose data is a contiguous array of trivially
+ *  copyable elements (e.g., `std::vector<double>`); other types are packed
+ *  as usual.  Backends can instead request compression for a single call by
+ *  passing a CompressingSerializationPolicy.
+ */
+template <typename T, typename Enable=void>
+struct compressed_packing_mode
+  : std::integral_constant<CompressionMode, CompressionMode::None>
+{ };
+
+/** @brief Whether a by-value argument of type T to a functor-style task
+ *  should stay packed after the task migrates, until the task first reads it.
+ *
+ *  Defaults to true for types that aren't trivially copyable (i.e., ones that
+ *  generally own out-of-line storage, like containers).  Arguments that are
+ *  never read on a given process are also forwarded on further migrations
+ *  without being unpacked and re-packed.
+ */
+template <typename T, typename Enable=void>
+struct lazy_unpack_task_argument
+  : std::integral_constant<bool, not std::is_trivially_copyable<T>::value>
+{ };
+
+} // end namespace serialization
+} // end namespace darma
+
+#endif //DARMA_INTERFACE_APP_SERIALIZATION_TRAITS_H
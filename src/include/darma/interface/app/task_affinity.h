@@ -0,0 +1,88 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                      task_affinity.h
+//                         DARMA
+//              Copyright (C) 2017 NTESS, LLC
+//
+// Under the terms of Contract DE-NA-0003525 with NTESS, LLC,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact darma@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef DARMA_INTERFACE_APP_TASK_AFFINITY_H
+#define DARMA_INTERFACE_APP_TASK_AFFINITY_H
+
+#include <cstddef>
+
+#include <darma/interface/frontend/task_affinity.h>
+#include <darma/interface/app/keyword_arguments/affinity.h>
+
+namespace darma {
+
+using TaskAffinity = abstract::frontend::TaskAffinity;
+
+/** @brief Ask the backend to run a task on the same socket as the data of
+ *  `handle`, for use with the `affinity=` keyword argument:
+ *
+ *  @code
+ *  create_work(affinity=same_socket_as(h), [=]{ h.set_value(update(h.get_value())); });
+ *  @endcode
+ *
+ *  Most useful for tasks that modify `handle`, so that the writes stay
+ *  local to the memory the backend already placed the data in.
+ */
+template <typename HandleT>
+auto
+same_socket_as(HandleT const& handle)
+  -> decltype(handle.get_key(), TaskAffinity())
+{
+  return TaskAffinity::same_socket_as_handle(handle.get_key());
+}
+
+/** @brief Ask the backend to run a task on the given socket, for use with
+ *  the `affinity=` keyword argument (e.g., `affinity=on_socket(i)`).
+ *
+ *  Sockets are numbered from 0 up to
+ *  `resource_count(Execution, depth=Socket, per=Process)`.
+ */
+inline TaskAffinity
+on_socket(std::size_t socket_index) {
+  return TaskAffinity::on_socket(socket_index);
+}
+
+} // end namespace darma
+
+#endif //DARMA_INTERFACE_APP_TASK_AFFINITY_H
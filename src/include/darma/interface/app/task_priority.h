@@ -0,0 +1,106 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                      task_priority.h
+//                         DARMA
+//              Copyright (C) 2017 NTESS, LLC
+//
+// Under the terms of Contract DE-NA-0003525 with NTESS, LLC,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact darma@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef DARMA_INTERFACE_APP_TASK_PRIORITY_H
+#define DARMA_INTERFACE_APP_TASK_PRIORITY_H
+
+#include <darma/interface/app/keyword_arguments/priority.h>
+
+namespace darma {
+
+namespace detail {
+
+struct inherited_priority_t {
+  int delta = 0;
+};
+
+/** @brief The value of the `priority=` keyword argument: either a fixed
+ *  priority or an offset from the priority of the creating task
+ */
+class TaskPriorityDescription {
+  public:
+
+    TaskPriorityDescription() = default;
+
+    // implicit, so that priority=<integer> works
+    TaskPriorityDescription(int priority)
+      : value_(priority), inherits_from_parent_(false)
+    { }
+
+    TaskPriorityDescription(inherited_priority_t inherited)
+      : value_(inherited.delta), inherits_from_parent_(true)
+    { }
+
+    int
+    resolve(int parent_priority) const {
+      return inherits_from_parent_ ? parent_priority + value_ : value_;
+    }
+
+  private:
+
+    int value_ = 0;
+    bool inherits_from_parent_ = false;
+};
+
+} // end namespace detail
+
+/** @brief Give a task the priority of the task creating it plus `delta`, for
+ *  use with the `priority=` keyword argument:
+ *
+ *  @code
+ *  create_work(priority=inherit_priority(1), [=]{ sweep_next_plane(h); });
+ *  @endcode
+ *
+ *  Tasks on a critical path can use this to stay ahead of bulk work however
+ *  deeply they're nested.  Tasks created without `priority=` get priority 0
+ *  (i.e., priority is not inherited by default).
+ */
+inline detail::inherited_priority_t
+inherit_priority(int delta = 0) {
+  return { delta };
+}
+
+} // end namespace darma
+
+#endif //DARMA_INTERFACE_APP_TASK_PRIORITY_H
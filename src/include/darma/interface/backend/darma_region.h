@@ -45,6 +45,8 @@
 #ifndef DARMAFRONTEND_INTERFACE_BACKEND_DARMA_REGIONS_H
 #define DARMAFRONTEND_INTERFACE_BACKEND_DARMA_REGIONS_H
 
+#include <functional>
+
 #include <darma/impl/feature_testing_macros.h>
 #include <darma_types.h>
 
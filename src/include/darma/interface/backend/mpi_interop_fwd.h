@@ -60,6 +60,14 @@ namespace backend {
 types::runtime_context_token_t
 create_runtime_context(darma::types::MPI_Comm);
 
+/** @brief A piece of a piecewise collection owned by the calling rank, for
+ *  bulk registration with register_piecewise_collection_pieces()
+ */
+struct piecewise_collection_piece_t {
+  size_t index;
+  void* data;
+};
+
 types::piecewise_collection_token_t
 register_piecewise_collection(
   types::runtime_context_token_t,
@@ -80,6 +88,23 @@ register_persistent_collection(
   size_t
 );
 
+/** @brief Register a persistent collection whose data is the MPI-owned
+ *  memory of the calling rank's pieces, rather than DARMA-managed storage.
+ *
+ *  Analogous to register_unmanaged_pointer_handle() for a single handle: the
+ *  backend uses each piece's memory directly (it outlives the collection),
+ *  so distributed regions only need to synchronize on the readiness of the
+ *  pieces and never copy their data in or out.
+ */
+types::persistent_collection_token_t
+register_aliased_persistent_collection(
+  types::runtime_context_token_t,
+  std::shared_ptr<darma::abstract::frontend::Handle>,
+  size_t,
+  piecewise_collection_piece_t const* pieces,
+  size_t n_pieces
+);
+
 void
 release_persistent_collection(
   types::runtime_context_token_t,
@@ -96,6 +121,27 @@ register_piecewise_collection_piece(
   std::function<void(void const*, void*)> = nullptr
 );
 
+/** @brief Register all of the calling rank's pieces of a piecewise collection
+ *  at once.
+ *
+ *  If zero_copy is true, the backend must use the memory pointed to by each
+ *  piece directly as the data for that index of the collection (the pieces
+ *  outlive the collection), so the callbacks are empty and no copies are made
+ *  into or out of DARMA-managed storage.  Otherwise, the pieces are treated
+ *  exactly as if each had been given to register_piecewise_collection_piece()
+ *  with the given callbacks.
+ */
+void
+register_piecewise_collection_pieces(
+  types::runtime_context_token_t,
+  types::piecewise_collection_token_t,
+  piecewise_collection_piece_t const* pieces,
+  size_t n_pieces,
+  bool zero_copy,
+  std::function<void(void const*, void*)> = nullptr,
+  std::function<void(void const*, void*)> = nullptr
+);
+
 void run_distributed_region(
   types::runtime_context_token_t,
   std::function<void()>
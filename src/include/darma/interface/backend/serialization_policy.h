@@ -121,6 +121,47 @@ struct SerializationPolicy {
 
 };
 
+/** @brief Backend-provided allocation callback for
+ *  frontend::SerializationManager::pack_data_with_allocator()
+ *
+ */
+struct PackBufferAllocator {
+  public:
+
+    /** @brief Return a buffer of at least `n_bytes` bytes for the frontend to
+     *  pack into.  Ownership of the buffer stays with the backend.
+     */
+    virtual void*
+    allocate(std::size_t n_bytes) =0;
+
+    virtual ~PackBufferAllocator() = default;
+};
+
+/** @brief Backend-provided storage for the out-of-line data (container
+ *  elements, string characters, etc.) of objects unpacked by
+ *  frontend::SerializationManager::unpack_data_into_arena()
+ *
+ *  The backend decides the lifetime of the arena (e.g., that of the received
+ *  message or of the handle the data is unpacked into), and must keep it alive
+ *  until every object unpacked into it has been destroyed.
+ */
+struct UnpackArena {
+  public:
+
+    /** @brief Return storage for `n_bytes` bytes aligned to `alignment`
+     */
+    virtual void*
+    allocate(std::size_t n_bytes, std::size_t alignment) =0;
+
+    /** @brief Return storage obtained from allocate().  Arenas that release
+     *  everything at once can ignore this.
+     */
+    virtual void
+    deallocate(void* /* ptr */, std::size_t /* n_bytes */) { }
+
+    virtual ~UnpackArena() = default;
+};
+
 } // end namespace backend
 } // end namespace abstract
 } // end namespace darma
@@ -81,10 +81,11 @@ class ArrayConceptManager {
       size_t offset, size_t n_elem
     ) const =0;
 
-    /** @todo
+    /** @brief Get an element range for the (possibly non-contiguous)
+     *  selection of elements described by `idx_range`
      *
      * @param obj
-     * @param idx_range
+     * @param idx_range must be an ElementIndexRange
      * @return
      */
     virtual types::unique_ptr_template<ElementRange>
@@ -116,11 +117,12 @@ class ArrayConceptManager {
       size_t offset, size_t size
     ) const =0;
 
-    /** @todo
+    /** @brief Write back an element range obtained from the `idx_range`
+     *  overload of `get_element_range()`
      *
      * @param obj
      * @param range
-     * @param idx_range
+     * @param idx_range must be an ElementIndexRange
      */
     virtual void
     set_element_range(
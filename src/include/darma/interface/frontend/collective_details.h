@@ -80,6 +80,21 @@ class CollectiveDetails {
     virtual ReduceOp const*
     reduce_operation() const =0;
 
+    /** @brief The number of contributions whose data has already been reduced
+     *  into the data of this one by the frontend.
+     *
+     *  This is 1 for an ordinary contribution.  When the tasks of a task
+     *  collection running in the same process have their contributions
+     *  combined locally (see TaskCollection::set_local_task_count()), one of
+     *  them carries the combined data of all k of them and returns k here,
+     *  while the others return 0.  A contribution returning 0 carries no data
+     *  that should be reduced; it only needs to receive the result.  In all
+     *  cases, the collective is complete when the sum of these values over the
+     *  contributions received equals n_contributions().
+     */
+    virtual size_t
+    n_combined_contributions() const { return 1; }
+
 #if _darma_has_feature(task_collection_token)
     virtual darma::types::task_collection_token_t const&
     get_task_collection_token() const =0;
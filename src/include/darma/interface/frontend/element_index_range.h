@@ -0,0 +1,101 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                      element_index_range.h
+//                         DARMA
+//              Copyright (C) 2017 NTESS, LLC
+//
+// Under the terms of Contract DE-NA-0003525 with NTESS, LLC,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact darma@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef DARMA_INTERFACE_FRONTEND_ELEMENT_INDEX_RANGE_H
+#define DARMA_INTERFACE_FRONTEND_ELEMENT_INDEX_RANGE_H
+
+#include <cstdlib> // size_t
+
+#include "index_range.h"
+
+namespace darma {
+namespace abstract {
+namespace frontend {
+
+/** @brief An IndexRange that selects elements of a flat (i.e., one-dimensional,
+ *  or multi-dimensional in row-major order) array by their offsets.
+ *
+ *  This is what the IndexRange-based overloads in ArrayConceptManager and
+ *  ArrayMovementManager take, and it determines the order in which the
+ *  selected elements are packed.  size() is the number of elements selected.
+ */
+class ElementIndexRange
+  : public IndexRange
+{
+  public:
+
+    /** @brief The offset in the array of the i-th selected element (in packing
+     *  order), for 0 <= i < size()
+     */
+    virtual size_t
+    element_offset(size_t i) const =0;
+
+    /** @brief Describe the selection as a regular block pattern, if possible
+     *
+     *  If the selection is `n_blocks` blocks of `block_length` contiguous
+     *  elements each, with the first block starting at offset `offset` and
+     *  each subsequent block starting `block_stride` elements after the start
+     *  of the previous one, set the output parameters accordingly and return
+     *  true.  This covers contiguous, strided 1D, and 2D sub-block selections,
+     *  and allows them to be copied a block at a time rather than by offset.
+     *
+     *  @return false if the selection has no such pattern (the default)
+     */
+    virtual bool
+    get_block_pattern(
+      size_t& offset, size_t& n_blocks,
+      size_t& block_length, size_t& block_stride
+    ) const {
+      return false;
+    }
+
+    virtual ~ElementIndexRange() = default;
+
+};
+
+} // end namespace frontend
+} // end namespace abstract
+} // end namespace darma
+
+#endif //DARMA_INTERFACE_FRONTEND_ELEMENT_INDEX_RANGE_H
@@ -80,6 +80,26 @@ class ElementRange {
     virtual bool
     is_deep_copy() const =0;
 
+    /** @brief For ranges that are not deep copies, a pointer to the parent's
+     *  storage for the elements in the range, if that storage is contiguous
+     *  and can be copied bytewise
+     *
+     *  Backends can use this to transfer the slice (e.g., via RDMA) without
+     *  packing it into an intermediate container.  The pointer remains valid
+     *  as long as both the range and its parent object are alive and the
+     *  parent is not resized.
+     *
+     *  @return nullptr if no such storage is available (the default)
+     */
+    virtual void const*
+    get_contiguous_data() const { return nullptr; }
+
+    /** @brief The number of bytes starting at get_contiguous_data() that make
+     *  up the range (0 if get_contiguous_data() returns nullptr)
+     */
+    virtual size_t
+    get_contiguous_data_size() const { return 0; }
+
     /** @todo
      *
      * @return
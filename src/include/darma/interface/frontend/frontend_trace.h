@@ -0,0 +1,186 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                      frontend_trace.h
+//                         DARMA
+//              Copyright (C) 2017 NTESS, LLC
+//
+// Under the terms of Contract DE-NA-0003525 with NTESS, LLC,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact darma@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef DARMA_INTERFACE_FRONTEND_FRONTEND_TRACE_H
+#define DARMA_INTERFACE_FRONTEND_FRONTEND_TRACE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+
+#include <darma_types.h>
+
+// Define to 1 to record timestamped trace events for task creation and
+// execution, Use registration and release, and publish/fetch/allreduce (see
+// darma::frontend::collect_trace_events())
+#ifndef DARMA_TRACE_FRONTEND
+#  define DARMA_TRACE_FRONTEND 0
+#endif
+
+// Minimum number of trace events each thread can hold between collections;
+// events recorded into a full buffer are dropped
+#ifndef DARMA_TRACE_FRONTEND_BUFFER_SIZE
+#  define DARMA_TRACE_FRONTEND_BUFFER_SIZE 16384
+#endif
+
+namespace darma {
+
+namespace abstract {
+
+namespace frontend {
+
+enum class TraceEventKind : std::uint8_t {
+  /// Construction (including capture) and registration of a create_work task
+  CreateWork,
+  /// Construction and registration of a create_concurrent_work collection
+  CreateConcurrentWork,
+  /// A call to Task::run()
+  RunTask,
+  /// A call to Runtime::register_use()
+  RegisterUse,
+  /// A call to Runtime::release_use()
+  ReleaseUse,
+  /// A flow the backend is asked to make for a Use being registered
+  /// (instantaneous; recorded at the start of the Use's RegisterUse or Fetch)
+  MakeFlow,
+  /// A publish(), including the capture of the published Use
+  Publish,
+  /// A call to Runtime::register_use() for a Use with a fetching in flow
+  Fetch,
+  /// An allreduce() or a collection task's allreduce contribution
+  Allreduce
+};
+
+/** @brief One event recorded by the frontend when it is compiled with
+ *  `DARMA_TRACE_FRONTEND` set to 1
+ */
+struct TraceEvent {
+
+  enum : std::size_t { no_index = static_cast<std::size_t>(-1) };
+
+  TraceEventKind kind = TraceEventKind::CreateWork;
+
+  /// Small integer identifying the recording thread (in order of first event)
+  std::uint32_t thread = 0;
+
+  /// Start of the event, in nanoseconds since the first event of the process
+  std::uint64_t begin_ns = 0;
+
+  /// Length of the event in nanoseconds (0 for MakeFlow)
+  std::uint64_t duration_ns = 0;
+
+  /// The task (or task collection) name for task events, the handle key for
+  /// Use and flow events, and the tag of an allreduce
+  types::key_t name;
+
+  /// The address of the task (or task collection) for task events, which
+  /// matches a CreateWork event to the RunTask event of the same task
+  std::uintptr_t task_id = 0;
+
+  /// The backend index of a collection task or the piece of an allreduce
+  /// contribution, or no_index
+  std::size_t index = no_index;
+
+  /// The FlowRelationship::description() of a MakeFlow event
+  std::uint32_t flow_relationship = 0;
+
+  /// Where create_work was called from, if the frontend is compiled with
+  /// DARMA_CREATE_WORK_RECORD_LINE_NUMBERS (string literals, or null)
+  const char* file = nullptr;
+  const char* function = nullptr;
+  std::size_t line = 0;
+
+};
+
+} // end namespace frontend
+
+} // end namespace abstract
+
+namespace frontend {
+
+/** @brief Append all trace events recorded since the last call to `events`.
+ *
+ *  Events are recorded into a per-thread buffer without locking, so this can
+ *  be called while other threads are running, though only from one thread at
+ *  a time.  Events are grouped by thread, not sorted by time.  Always returns
+ *  0 unless the frontend is compiled with `DARMA_TRACE_FRONTEND` set to 1.
+ *
+ *  @param events The container to append the events to
+ *  @return The number of events appended
+ */
+inline std::size_t
+collect_trace_events(
+  std::vector<abstract::frontend::TraceEvent>& events
+);
+
+/** @brief The number of events dropped so far because a thread recorded more
+ *  than DARMA_TRACE_FRONTEND_BUFFER_SIZE between collections
+ */
+inline std::size_t
+n_dropped_trace_events();
+
+/** @brief Write `events` as a Chrome trace event JSON document (as read by
+ *  chrome://tracing and the Perfetto UI), with one track per recording thread
+ *
+ *  Tasks created without a name are labeled with the source location of
+ *  their create_work call when it was recorded.  Each CreateWork event is
+ *  linked to the RunTask event of the same task by a flow arrow.
+ *
+ *  @param o The stream to write the JSON document to
+ *  @param events Events from collect_trace_events(), in any order
+ *  @param pid The process id to report (e.g., the rank of this process)
+ */
+inline void
+write_chrome_trace(
+  std::ostream& o,
+  std::vector<abstract::frontend::TraceEvent> const& events,
+  std::size_t pid = 0
+);
+
+} // end namespace frontend
+
+} // end namespace darma
+
+#endif //DARMA_INTERFACE_FRONTEND_FRONTEND_TRACE_H
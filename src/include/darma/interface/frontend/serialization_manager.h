@@ -153,6 +153,72 @@ class SerializationManager {
       backend::SerializationPolicy* ser_policy
     ) const =0;
 
+    /** @brief Same as unpack_data(), but any memory the unpacked object
+     *  allocates for itself (through serialization::ArenaAllocator) comes
+     *  from `arena` rather than from the heap
+     *
+     *  The default implementation ignores the arena and calls unpack_data().
+     *
+     *  @param arena the backend-provided arena; must outlive the unpacked
+     *  object
+     */
+    virtual void
+    unpack_data_into_arena(
+      void* const object_dest,
+      const void* const packed_buffer,
+      backend::SerializationPolicy* ser_policy,
+      backend::UnpackArena& arena
+    ) const {
+      unpack_data(object_dest, packed_buffer, ser_policy);
+    }
+
+    /** @brief If true, the packed size of a given object (with a given
+     *  policy) never changes after it is constructed, so the backend may keep
+     *  the size returned by pack_data_with_allocator() for that object and
+     *  pass it back as `known_packed_size` on later packs of the same object.
+     */
+    virtual bool
+    packed_size_is_invariant() const {
+      return false;
+    }
+
+    /** @brief Packs the object data into a buffer obtained from `allocator`,
+     *  in place of a call to get_packed_data_size() followed by pack_data()
+     *
+     *  This saves the backend a call, not necessarily a traversal: the
+     *  object still has to be sized before it can be packed unless the
+     *  implementation can size it without walking it (e.g., a contiguous
+     *  blob) or the backend passes `known_packed_size`.  The default
+     *  implementation just calls get_packed_data_size() (unless
+     *  `known_packed_size` is given) and pack_data().
+
+     *  @param object_data pointer to the start of the C++ object to be
+     *  serialized (see get_packed_data_size())
+     *
+     *  @param allocator called exactly once, with the exact packed size, to
+     *  get the buffer into which the data is packed
+     *
+     *  @param ser_policy see pack_data()
+     *
+     *  @param known_packed_size 0, or (only if packed_size_is_invariant()) the
+     *  size returned by an earlier pack of the same object with the same policy
+     *
+     *  @return the number of bytes packed into the buffer from `allocator`
+     */
+    virtual size_t
+    pack_data_with_allocator(
+      const void* const object_data,
+      backend::PackBufferAllocator& allocator,
+      backend::SerializationPolicy* ser_policy,
+      size_t known_packed_size
+    ) const {
+      assert(known_packed_size == 0 or packed_size_is_invariant());
+      const size_t size = known_packed_size != 0 ?
+        known_packed_size : get_packed_data_size(object_data, ser_policy);
+      pack_data(object_data, allocator.allocate(size), ser_policy);
+      return size;
+    }
+
     /** @todo document this
      */
     virtual void
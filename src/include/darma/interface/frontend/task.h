@@ -54,6 +54,8 @@
 #include <darma/impl/feature_testing_macros.h>
 
 #include "use.h"
+#include "task_affinity.h"
+#include "task_run_timing.h"
 
 #include <darma/serialization/polymorphic/polymorphic_serializable_object.h>
 
@@ -188,6 +190,43 @@ class Task
 
     //==========================================================================
 
+    /** @brief Returns the placement hint given (e.g., with the `affinity=`
+     *  keyword argument) when the task was created.
+     *
+     *  Backends may ignore this.  NUMA-aware backends can use it to run the
+     *  task next to the memory of the handle(s) it modifies.
+     *
+     *  @return The task's affinity hint; TaskAffinity::Kind::None if not given
+     */
+    virtual TaskAffinity const&
+    get_affinity() const { return TaskAffinity::none(); }
+
+    /** @brief Returns the task's scheduling priority, as given with the
+     *  `priority=` keyword argument when the task was created.
+     *
+     *  Among tasks that are ready to run, backends should prefer those with
+     *  higher priorities (e.g., ones on an application's critical path), but
+     *  may otherwise ignore this.
+     *
+     *  @return The task's priority; 0 if none was given
+     */
+    virtual int
+    get_priority() const { return 0; }
+
+    /** @brief Returns the estimated cost of running the task, as given with
+     *  the `cost=` keyword argument when the task was created.
+     *
+     *  The units are up to the application (but should be consistent within
+     *  it); load balancers can compare these with the measured run times
+     *  (see frontend::collect_task_run_timings()).
+     *
+     *  @return The task's cost estimate; 0 if none was given
+     */
+    virtual double
+    get_cost_estimate() const { return 0.0; }
+
+    //==========================================================================
+
 #if _darma_has_feature(resilient_tasks)
     virtual bool is_replayable() const =0;
 #endif
@@ -0,0 +1,140 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                      task_affinity.h
+//                         DARMA
+//              Copyright (C) 2017 NTESS, LLC
+//
+// Under the terms of Contract DE-NA-0003525 with NTESS, LLC,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact darma@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef DARMA_INTERFACE_FRONTEND_TASK_AFFINITY_H
+#define DARMA_INTERFACE_FRONTEND_TASK_AFFINITY_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include <darma_types.h>
+
+namespace darma {
+
+namespace abstract {
+
+namespace frontend {
+
+/** @brief A placement hint attached to a task (or task collection) at
+ *  creation time, e.g., with `create_work(affinity=same_socket_as(h), ...)`.
+ *
+ *  Hints never affect correctness; a backend that isn't NUMA-aware may ignore
+ *  them entirely.  A backend that is can use them to run the task on the
+ *  socket that holds the memory the task will modify.
+ */
+class TaskAffinity {
+  public:
+
+    enum class Kind : uint8_t {
+      /// No placement requested
+      None,
+      /// Run on the socket given by socket_index()
+      Socket,
+      /// Run on the socket holding the data of the handle named handle_key()
+      SameSocketAsHandle
+    };
+
+    TaskAffinity() = default;
+
+    /** @brief A shared instance meaning "no placement requested"
+     */
+    static TaskAffinity const&
+    none() {
+      static const TaskAffinity none_ = { };
+      return none_;
+    }
+
+    static TaskAffinity
+    on_socket(std::size_t socket_index) {
+      TaskAffinity rv;
+      rv.kind_ = Kind::Socket;
+      rv.socket_index_ = socket_index;
+      return rv;
+    }
+
+    static TaskAffinity
+    same_socket_as_handle(types::key_t const& handle_key) {
+      TaskAffinity rv;
+      rv.kind_ = Kind::SameSocketAsHandle;
+      rv.handle_key_ = handle_key;
+      return rv;
+    }
+
+    Kind kind() const { return kind_; }
+
+    bool is_none() const { return kind_ == Kind::None; }
+
+    /** @brief The requested socket; only meaningful if kind() is Kind::Socket
+     */
+    std::size_t socket_index() const { return socket_index_; }
+
+    /** @brief The key of the handle whose data the task should run next to;
+     *  only meaningful if kind() is Kind::SameSocketAsHandle.
+     *
+     *  This is the key returned by Handle::get_key() for the corresponding
+     *  Use among the task's dependencies (if the task captured it).
+     */
+    types::key_t const& handle_key() const { return handle_key_; }
+
+    template <typename ArchiveT>
+    void serialize(ArchiveT& ar) {
+      auto kind = static_cast<uint8_t>(kind_);
+      ar | kind | socket_index_ | handle_key_;
+      kind_ = static_cast<Kind>(kind);
+    }
+
+  private:
+
+    Kind kind_ = Kind::None;
+    std::size_t socket_index_ = 0;
+    types::key_t handle_key_;
+};
+
+} // end namespace frontend
+
+} // end namespace abstract
+
+} // end namespace darma
+
+#endif //DARMA_INTERFACE_FRONTEND_TASK_AFFINITY_H
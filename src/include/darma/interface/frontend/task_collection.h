@@ -50,6 +50,7 @@
 #include <darma/serialization/polymorphic/polymorphic_serializable_object.h>
 
 #include <darma/interface/frontend/types/task_collection_task_t.h>
+#include <darma/interface/frontend/task_affinity.h>
 
 #include <darma_types.h>
 #include <darma/utility/optional_boolean.h>
@@ -99,9 +100,45 @@ class TaskCollection
     virtual void
     set_name(types::key_t const&) =0;
 
+    /** @brief The placement hint given with the `affinity=` keyword argument
+     *  to create_concurrent_work(); each task created by
+     *  create_task_for_index() reports the same hint from
+     *  Task::get_affinity().
+     */
+    virtual TaskAffinity const&
+    get_affinity() const { return TaskAffinity::none(); }
+
+    /** @brief The priority given with the `priority=` keyword argument to
+     *  create_concurrent_work(), which is also the priority of each task
+     *  created by create_task_for_index()
+     */
+    virtual int
+    get_priority() const { return 0; }
+
+    /** @brief The estimated cost of each task in the collection, as given
+     *  with the `cost=` keyword argument to create_concurrent_work() (0 if
+     *  none was given)
+     */
+    virtual double
+    get_cost_estimate() const { return 0.0; }
+
     virtual OptionalBoolean
     all_mappings_same_as(TaskCollection const* other) const =0;
 
+    /** @brief Tell the frontend how many of this collection's tasks the
+     *  backend will create (via create_task_for_index()) in this process.
+     *
+     *  Optional; if called, it must be called before any of those tasks are
+     *  created.  When given, collectives invoked by the tasks through their
+     *  ConcurrentContext are combined in shared memory first, and only one
+     *  contribution per process carries data to the backend's collective
+     *  (see CollectiveDetails::n_combined_contributions()).
+     *
+     *  @param n_local_tasks the number of tasks that will run in this process
+     */
+    virtual void
+    set_local_task_count(std::size_t /* n_local_tasks */) { }
+
 #if _darma_has_feature(mpi_interoperability)
     virtual bool
     requires_exactly_one_index_per_process() const {
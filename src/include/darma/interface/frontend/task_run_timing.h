@@ -0,0 +1,124 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                      task_run_timing.h
+//                         DARMA
+//              Copyright (C) 2017 NTESS, LLC
+//
+// Under the terms of Contract DE-NA-0003525 with NTESS, LLC,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact darma@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef DARMA_INTERFACE_FRONTEND_TASK_RUN_TIMING_H
+#define DARMA_INTERFACE_FRONTEND_TASK_RUN_TIMING_H
+
+#include <cstddef>
+#include <vector>
+
+#include <darma_types.h>
+
+// Define to 1 to time every Task::run() and record the results for the
+// backend (see darma::frontend::collect_task_run_timings())
+#ifndef DARMA_MEASURE_TASK_RUN_TIME
+#  define DARMA_MEASURE_TASK_RUN_TIME 0
+#endif
+
+// Minimum number of timings each thread can hold between collections;
+// timings recorded into a full buffer are dropped
+#ifndef DARMA_TASK_RUN_TIMING_BUFFER_SIZE
+#  define DARMA_TASK_RUN_TIMING_BUFFER_SIZE 4096
+#endif
+
+namespace darma {
+
+namespace abstract {
+
+namespace frontend {
+
+/** @brief The measured wall time of one call to Task::run(), recorded when
+ *  the frontend is compiled with `DARMA_MEASURE_TASK_RUN_TIME` set to 1
+ */
+struct TaskRunTiming {
+
+  enum : std::size_t { not_a_collection_task = static_cast<std::size_t>(-1) };
+
+  /// The task's name, or the task collection's name for a collection task
+  types::key_t name;
+
+  /// The backend index of a collection task, or not_a_collection_task
+  std::size_t collection_index = not_a_collection_task;
+
+  /// The estimate given with the `cost=` keyword argument (0 if none)
+  double cost_estimate = 0.0;
+
+  /// Wall time spent in Task::run(), in seconds
+  double wall_time = 0.0;
+
+};
+
+} // end namespace frontend
+
+} // end namespace abstract
+
+namespace frontend {
+
+/** @brief Append the timings of all Task::run() calls that finished since the
+ *  last call to `timings` (e.g., for the backend's load balancer).
+ *
+ *  Tasks record their timings into a per-thread buffer without locking, so
+ *  this can be called while other threads run tasks, though only from one
+ *  thread at a time.  Always returns 0 unless the frontend is compiled with
+ *  `DARMA_MEASURE_TASK_RUN_TIME` set to 1.
+ *
+ *  @param timings The container to append the timings to
+ *  @return The number of timings appended
+ */
+inline std::size_t
+collect_task_run_timings(
+  std::vector<abstract::frontend::TaskRunTiming>& timings
+);
+
+/** @brief The number of timings dropped so far because a thread recorded
+ *  more than DARMA_TASK_RUN_TIMING_BUFFER_SIZE between collections
+ */
+inline std::size_t
+n_dropped_task_run_timings();
+
+} // end namespace frontend
+
+} // end namespace darma
+
+#endif //DARMA_INTERFACE_FRONTEND_TASK_RUN_TIMING_H
@@ -46,6 +46,7 @@
 #define DARMA_USE_COLLECTION_H
 
 #include <cstdlib> // std::size_t
+#include <type_traits> // std::remove_reference_t
 #include <vector>
 #include <darma/utility/optional_boolean.h>
 
@@ -83,13 +84,73 @@ class UseCollection {
     virtual bool
     is_mapped() const =0;
 
-    /** @todo document this
+    /** @brief Receives the local indices for a task as half-open intervals
+     *  of backend (dense) collection indices.
      *
-     *  @param task_index
-     *  @return
+     *  @sa UseCollection::visit_local_indices_for
+     */
+    class LocalIndexVisitor {
+      public:
+        /** @brief Called once for each interval `[begin, end)` of collection
+         *  indices local to the task being visited.
+         *
+         *  Intervals are never empty, but they are not guaranteed to be
+         *  sorted or maximal.
+         */
+        virtual void
+        visit_interval(std::size_t begin, std::size_t end) =0;
+
+        virtual ~LocalIndexVisitor() = default;
+    };
+
+    /** @brief Reports the collection indices mapped to `task_index` to
+     *  `visitor` without allocating any storage for them.
+     *
+     *  This is the preferred way for a backend to query the local indices of
+     *  a mapped collection.  Contiguous runs of indices are reported as a
+     *  single interval, so for one-to-one mappings the visitor is invoked
+     *  exactly once with an interval of length 1.
+     *
+     *  @param task_index The backend index of the task in the `TaskCollection`
+     *  @param visitor The visitor to report the local index intervals to
+     */
+    virtual void
+    visit_local_indices_for(
+      std::size_t task_index, LocalIndexVisitor& visitor
+    ) const =0;
+
+    /** @brief Convenience wrapper around `visit_local_indices_for()` that
+     *  accepts any callable with the signature `void(std::size_t, std::size_t)`
+     */
+    template <typename Callable>
+    void
+    for_each_local_index_interval(
+      std::size_t task_index, Callable&& callable
+    ) const {
+      _callable_index_visitor<std::remove_reference_t<Callable>> visitor(callable);
+      visit_local_indices_for(task_index, visitor);
+    }
+
+    /** @brief Returns the collection indices mapped to `task_index` as a
+     *  container.
+     *
+     *  @deprecated This allocates on every call; use
+     *  `visit_local_indices_for()` (or `for_each_local_index_interval()`)
+     *  instead
+     *
+     *  @param task_index The backend index of the task in the `TaskCollection`
+     *  @return The backend (dense) collection indices local to `task_index`
      */
     virtual index_iterable<std::size_t>
-    local_indices_for(std::size_t task_index) const =0;
+    local_indices_for(std::size_t task_index) const {
+      index_iterable<std::size_t> rv;
+      for_each_local_index_interval(task_index,
+        [&rv](std::size_t begin, std::size_t end) {
+          for(; begin < end; ++begin) rv.push_back(begin);
+        }
+      );
+      return rv;
+    }
 
     virtual std::size_t
     task_index_for(std::size_t collection_index) const =0;
@@ -105,6 +166,23 @@ class UseCollection {
     virtual std::size_t
     size() const =0;
 
+    virtual ~UseCollection() = default;
+
+  private:
+
+    template <typename Callable>
+    class _callable_index_visitor : public LocalIndexVisitor {
+      public:
+        explicit _callable_index_visitor(Callable& callable)
+          : callable_(callable)
+        { }
+        void visit_interval(std::size_t begin, std::size_t end) override {
+          callable_(begin, end);
+        }
+      private:
+        Callable& callable_;
+    };
+
 };
 
 } // end namespace frontend
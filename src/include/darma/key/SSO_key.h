@@ -222,6 +222,100 @@ inline auto _sum() {
   return 0ul;
 }
 
+//==============================================================================
+// <editor-fold desc="all-integer keys"> {{{1
+
+// Keys made entirely of integers (by far the most common case) are encoded in
+// a single pass over the components, rather than one bytes_convert at a time.
+// The encoding is identical to that of the general path.  The raw values are
+// copied out of a uintmax_t, so this requires a little-endian target.
+// Define DARMA_SSO_KEY_NO_INTEGER_FAST_PATH to always use the general path.
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+static constexpr auto integer_key_little_endian = true;
+#else
+static constexpr auto integer_key_little_endian = false;
+#endif
+
+#ifdef DARMA_SSO_KEY_NO_INTEGER_FAST_PATH
+static constexpr auto integer_key_fast_path_enabled = false;
+#else
+static constexpr auto integer_key_fast_path_enabled =
+  integer_key_little_endian;
+#endif
+
+inline constexpr bool _all_of() { return true; }
+
+template <typename... Bools>
+inline constexpr bool _all_of(bool b, Bools... bs) {
+  return b and _all_of(bs...);
+}
+
+template <typename T>
+using is_integer_key_component = std::integral_constant<bool,
+  std::is_integral<std::decay_t<T>>::value
+  and not std::is_enum<std::decay_t<T>>::value
+>;
+
+template <typename... Args>
+using use_integer_key_fast_path = std::integral_constant<bool,
+  integer_key_fast_path_enabled
+  and sizeof...(Args) > 0
+  and _all_of(is_integer_key_component<Args>::value...)
+>;
+
+template <
+  typename PieceSizeOrdinal, typename ComponentCountOrdinal, size_t NComponents
+>
+struct integer_key_encoding {
+
+  uintmax_t magnitudes[NComponents];
+  bytes_type_metadata metadata[NComponents];
+  PieceSizeOrdinal piece_sizes[NComponents];
+  size_t size = sizeof(ComponentCountOrdinal)
+    + NComponents * (sizeof(PieceSizeOrdinal) + sizeof(bytes_type_metadata));
+
+  template <typename... Ints>
+  explicit
+  integer_key_encoding(Ints const&... vals)
+    : magnitudes{ int_key_magnitude(vals)... }
+  {
+    static_assert(sizeof...(Ints) == NComponents, "wrong number of values");
+    bool const negative[NComponents] = { int_key_is_negative(vals)... };
+    for(size_t i = 0; i < NComponents; ++i) {
+      auto const exponent = int_key_size_exponent(magnitudes[i]);
+      int_like_type_metadata md;
+      md._always_false = false;
+      md._always_true = true;
+      md.is_enumerated = false;
+      md.is_negative = negative[i];
+      md.int_size_exponent = exponent;
+      ::memcpy(&metadata[i], &md, sizeof(bytes_type_metadata));
+      piece_sizes[i] = PieceSizeOrdinal(1) << exponent;
+      size += piece_sizes[i];
+    }
+  }
+
+  inline void
+  write(char* buffer) const {
+    ComponentCountOrdinal const n_comps = NComponents;
+    ::memcpy(buffer, &n_comps, sizeof(ComponentCountOrdinal));
+    buffer += sizeof(ComponentCountOrdinal);
+    for(size_t i = 0; i < NComponents; ++i) {
+      ::memcpy(buffer, &piece_sizes[i], sizeof(PieceSizeOrdinal));
+      buffer += sizeof(PieceSizeOrdinal);
+      ::memcpy(buffer, &metadata[i], sizeof(bytes_type_metadata));
+      buffer += sizeof(bytes_type_metadata);
+      ::memcpy(buffer, &magnitudes[i], piece_sizes[i]);
+      buffer += piece_sizes[i];
+    }
+  }
+
+};
+
+// </editor-fold> end all-integer keys }}}1
+//==============================================================================
+
 } // end namespace _impl
 
 //==============================================================================
@@ -309,6 +403,14 @@ class SSOKey {
       Args&& ... args
     );
 
+    template <typename... Args>
+    void _construct(std::false_type /* all integers */, Args&&... args);
+
+    template <typename... Args>
+    void _construct(std::true_type /* all integers */, Args&&... args);
+
+    char* _allocate(size_t buffer_size);
+
     bool _is_long() const { return mode == _impl::Long; }
     bool _is_short() const { return mode == _impl::Short; }
     bool _is_backend_assigned() const { return mode == _impl::BackendAssigned; }
@@ -457,6 +559,44 @@ class SSOKey {
       }
     }
 
+    /** Decodes every component of a key made up entirely of (non-enum)
+     *  integers into `dest`, which must have room for n_components() values,
+     *  in a single pass over the key
+     */
+    template <typename Integer>
+    void
+    integer_components(Integer* dest) const {
+      DARMA_ASSERT_MESSAGE(mode != _impl::BackendAssigned,
+        "Can't get components of backend-assigned key"
+      );
+      assert(_data_pointer() != nullptr);
+      char const* buffer = _data_pointer() + sizeof(ComponentCountOrdinal);
+      const size_t n_comps = n_components();
+      for(size_t i = 0; i < n_comps; ++i) {
+        PieceSizeOrdinal psize;
+        ::memcpy(&psize, buffer, sizeof(PieceSizeOrdinal));
+        buffer += sizeof(PieceSizeOrdinal);
+        auto const* md = reinterpret_cast<int_like_type_metadata const*>(buffer);
+        DARMA_ASSERT_MESSAGE(md->_always_true and not md->_always_false
+            and not md->is_enumerated,
+          "integer_components() called on a key with non-integer components"
+        );
+        buffer += sizeof(bytes_type_metadata);
+        if(_impl::integer_key_little_endian) {
+          uintmax_t mag = 0;
+          ::memcpy(&mag, buffer, psize);
+          Integer const value = static_cast<Integer>(mag);
+          dest[i] = md->is_negative ? Integer(-value) : value;
+        }
+        else {
+          dest[i] = bytes_convert<Integer>().get_value(
+            reinterpret_cast<bytes_type_metadata const*>(md), buffer, psize
+          );
+        }
+        buffer += psize;
+      }
+    }
+
     template <uint8_t N = _impl::_component_index_not_given>
     SSOKeyComponent
     component(size_t N_dynamic = _impl::_component_index_not_given) const {
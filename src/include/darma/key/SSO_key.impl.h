@@ -103,32 +103,83 @@ SSOKey<BufferSize, BackendAssignedKeyType, PieceSizeOrdinal, ComponentCountOrdin
     sizeof...(Args) < std::numeric_limits<ComponentCountOrdinal>::max(),
     "Too many components given to SSO Key"
   );
-  size_t buffer_size = _impl::_sum(
-    bytes_convert<std::remove_reference_t<Args>>().get_size(
-      std::forward<Args>(args)
-    )...
-  ) + sizeof...(Args)
-    * (sizeof(PieceSizeOrdinal) + sizeof(bytes_type_metadata))
-    + sizeof(ComponentCountOrdinal);
-  char* buffer, * buffer_start;
+  _construct(
+    _impl::use_integer_key_fast_path<Args...>{},
+    std::forward<Args>(args)...
+  );
+}
+
+template <
+  size_t BufferSize,
+  typename BackendAssignedKeyType,
+  typename PieceSizeOrdinal,
+  typename ComponentCountOrdinal
+>
+char*
+SSOKey<BufferSize, BackendAssignedKeyType, PieceSizeOrdinal, ComponentCountOrdinal>::_allocate(
+  size_t buffer_size
+) {
   if (buffer_size < BufferSize) {
     // Employ SSO
     mode = _impl::Short;
     repr.as_short = _short();
     repr.as_short.size = buffer_size;
-    buffer = buffer_start = repr.as_short.data;
+    return repr.as_short.data;
   } else {
     // use large buffer
     mode = _impl::Long;
     repr.as_long = _long();
     repr.as_long.size = buffer_size;
-    repr.as_long.data = buffer = buffer_start = static_cast<char*>(
+    repr.as_long.data = static_cast<char*>(
       abstract::backend::get_backend_memory_manager()->allocate(buffer_size)
     );
+    return repr.as_long.data;
   }
+}
+
+template <
+  size_t BufferSize,
+  typename BackendAssignedKeyType,
+  typename PieceSizeOrdinal,
+  typename ComponentCountOrdinal
+>
+template <typename... Args>
+void
+SSOKey<BufferSize, BackendAssignedKeyType, PieceSizeOrdinal, ComponentCountOrdinal>::_construct(
+  std::true_type /* all integers */,
+  Args&&... args
+) {
+  // Sizes, metadata, and magnitudes are all computed in one pass, then
+  // written out in another
+  const auto encoding = _impl::integer_key_encoding<
+    PieceSizeOrdinal, ComponentCountOrdinal, sizeof...(Args)
+  >(args...);
+  encoding.write(_allocate(encoding.size));
+}
+
+template <
+  size_t BufferSize,
+  typename BackendAssignedKeyType,
+  typename PieceSizeOrdinal,
+  typename ComponentCountOrdinal
+>
+template <typename... Args>
+void
+SSOKey<BufferSize, BackendAssignedKeyType, PieceSizeOrdinal, ComponentCountOrdinal>::_construct(
+  std::false_type /* all integers */,
+  Args&&... args
+) {
+  size_t buffer_size = _impl::_sum(
+    bytes_convert<std::remove_reference_t<Args>>().get_size(
+      std::forward<Args>(args)
+    )...
+  ) + sizeof...(Args)
+    * (sizeof(PieceSizeOrdinal) + sizeof(bytes_type_metadata))
+    + sizeof(ComponentCountOrdinal);
+  char* buffer, * buffer_start;
+  buffer = buffer_start = _allocate(buffer_size);
   // Skip over the number of components; we'll come back to it
   buffer += sizeof(ComponentCountOrdinal);
-  ComponentCountOrdinal actual_component_count = 0;
   // use out-of-line functor to avoid lambda instantiation proliferation and
   // speed up compile times, even though this makes the code a bit less readable
   auto component_adder = _impl::_do_add_component<SSOKey, ComponentCountOrdinal>(*this, buffer);
@@ -143,6 +143,49 @@ struct bytes_convert;
 //----------------------------------------
 // <editor-fold desc="integral types">
 
+namespace _impl {
+
+template <typename T>
+inline constexpr bool
+int_key_is_negative(T const& val, std::true_type /* signed */) {
+  return val < 0;
+}
+
+template <typename T>
+inline constexpr bool
+int_key_is_negative(T const&, std::false_type /* signed */) {
+  return false;
+}
+
+template <typename T>
+inline constexpr bool
+int_key_is_negative(T const& val) {
+  return int_key_is_negative(val, std::is_signed<std::remove_cv_t<T>>{});
+}
+
+// The absolute value of val, computed without branches (and without
+// overflowing on the most negative value of T)
+template <typename T>
+inline constexpr uintmax_t
+int_key_magnitude(T const& val) {
+  return (uintmax_t(intmax_t(val)) ^ (uintmax_t(0) - int_key_is_negative(val)))
+    + uintmax_t(int_key_is_negative(val));
+}
+
+// The smallest N such that magnitude fits in 2**N bytes (see
+// int_like_type_metadata::int_size_exponent), computed without branches
+inline constexpr uint8_t
+int_key_size_exponent(uintmax_t magnitude) {
+  static_assert(sizeof(uint64_t) == sizeof(uintmax_t),
+    "not enough int sizes handled"
+  );
+  return uint8_t(magnitude > 0xFFull)
+    + uint8_t(magnitude > 0xFFFFull)
+    + uint8_t(magnitude > 0xFFFFFFFFull);
+}
+
+} // end namespace _impl
+
 template <typename T>
 struct bytes_convert<T,
   // I think is_integral returns false for enums anyway, but just in case
@@ -151,18 +194,7 @@ struct bytes_convert<T,
 > {
   private:
     uint8_t get_min_bytes_exponent(T const& val) const {
-      uint8_t N = 0;
-      // 8*(2**N) = 2**(N+3) = 1<<(N+3)
-      uintmax_t current_max = uintmax_t(1) << uintmax_t(1 << (N+3));
-      while(
-        val >= current_max
-        and N <= int_like_type_metadata::max_int_size_exponent
-      ) {
-        assert(current_max > 0); // overflow if this fails
-        current_max = uintmax_t(1) << uintmax_t(1 << (N+3));
-        ++N;
-      }
-      return N;
+      return _impl::int_key_size_exponent(_impl::int_key_magnitude(val));
     }
 
   public:
@@ -173,7 +205,7 @@ struct bytes_convert<T,
       md_int->_always_false = false;
       md_int->_always_true = true;
       md_int->is_enumerated = false;
-      md_int->is_negative = val < 0;
+      md_int->is_negative = _impl::int_key_is_negative(val);
       md_int->int_size_exponent = get_min_bytes_exponent(val);
     }
 
@@ -189,25 +221,25 @@ struct bytes_convert<T,
 
     inline constexpr void
     operator()(T const &val, void *dest, const size_t n_bytes, const size_t offset) const {
-      using signed_T = std::make_signed_t<T>;
-      switch(get_min_bytes_exponent(val)) {
+      const uintmax_t mag = _impl::int_key_magnitude(val);
+      switch(_impl::int_key_size_exponent(mag)) {
         case 0: {
-          uint8_t v = (uint8_t)(std::abs(signed_T(val)));
+          uint8_t v = (uint8_t)mag;
           ::memcpy(dest, (char*)(&v) + offset, n_bytes);
           break;
         }
         case 1: {
-          uint16_t v = (uint16_t)(std::abs(signed_T(val)));
+          uint16_t v = (uint16_t)mag;
           ::memcpy(dest, (char*)(&v) + offset, n_bytes);
           break;
         }
         case 2: {
-          uint32_t v = (uint32_t)(std::abs(signed_T(val)));
+          uint32_t v = (uint32_t)mag;
           ::memcpy(dest, (char*)(&v) + offset, n_bytes);
           break;
         }
         case 3: {
-          uint64_t v = (uint64_t)(std::abs(signed_T(val)));
+          uint64_t v = (uint64_t)mag;
           ::memcpy(dest, (char*)(&v) + offset, n_bytes);
           break;
         }
@@ -0,0 +1,170 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                      benchmark_darma_region.cc
+//                         DARMA
+//              Copyright (C) 2017 NTESS, LLC
+//
+// Under the terms of Contract DE-NA-0003525 with NTESS, LLC,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact darma@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+*/
+
+// Microbenchmark of region enter/exit latency against a mock backend whose
+// runtime instances run the region's work immediately, comparing a fresh
+// darma_region() per iteration with repeated submissions to a
+// PersistentRegion.
+
+// The rest of the frontend validation tests are built without DARMA regions
+#include "darma_features.h"
+#undef _darma_has_feature_darma_regions
+#define _darma_has_feature_darma_regions 1
+
+#include <gtest/gtest.h>
+
+#include <darma/interface/app/darma_region.h>
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+// Mock backend for regions: all of the work in a region runs inside of
+// with_active_runtime_instance(), so the instance is quiescent when it returns
+// and the callbacks registered before then run
+
+namespace {
+
+std::vector<std::function<void()>> pending_quiescence_callbacks;
+// (swapped with the pending ones before running them, since they may
+// register more)
+std::vector<std::function<void()>> running_quiescence_callbacks;
+
+} // end anonymous namespace
+
+namespace darma {
+namespace backend {
+
+void initialize_with_arguments(int&, char**&) { }
+
+void finalize() { }
+
+types::runtime_instance_token_t
+initialize_runtime_instance() {
+  return types::runtime_instance_token_t("benchmark");
+}
+
+void
+register_runtime_instance_quiescence_callback(
+  types::runtime_instance_token_t&,
+  std::function<void()> callback
+) {
+  pending_quiescence_callbacks.push_back(std::move(callback));
+}
+
+void
+with_active_runtime_instance(
+  types::runtime_instance_token_t&,
+  std::function<void()> callback
+) {
+  callback();
+  running_quiescence_callbacks.swap(pending_quiescence_callbacks);
+  for(auto& quiescence_callback : running_quiescence_callbacks) {
+    quiescence_callback();
+  }
+  running_quiescence_callbacks.clear();
+}
+
+} // end namespace backend
+} // end namespace darma
+
+////////////////////////////////////////////////////////////////////////////////
+
+class BenchmarkDARMARegion
+  : public ::testing::Test
+{
+  protected:
+
+    virtual void SetUp() {
+      // so that the vectors don't need to grow during the timed loops
+      pending_quiescence_callbacks.reserve(4);
+      running_quiescence_callbacks.reserve(4);
+    }
+
+    static constexpr int n_regions = 100000;
+
+    template <typename Callable>
+    static double
+    time_per_region_ns(Callable&& f) {
+      auto start = std::chrono::steady_clock::now();
+      for(int i = 0; i < n_regions; ++i) {
+        f(i);
+      }
+      auto stop = std::chrono::steady_clock::now();
+      return std::chrono::duration<double, std::nano>(stop - start).count()
+        / double(n_regions);
+    }
+
+    static void
+    report(char const* what, double ns_per_region) {
+      std::cout << "[ BENCHMARK] " << what << ": " << ns_per_region
+        << " ns/region" << std::endl;
+    }
+};
+
+TEST_F(BenchmarkDARMARegion, darma_region_enter_exit) {
+  using namespace darma::experimental;
+  long total = 0;
+  auto ns = time_per_region_ns([&](int i) {
+    darma_region([&]{ total += i; }).wait();
+  });
+  report("darma_region() + wait", ns);
+  ASSERT_EQ(total, long(n_regions) * (n_regions - 1) / 2);
+}
+
+TEST_F(BenchmarkDARMARegion, persistent_region_enter_exit) {
+  using namespace darma::experimental;
+  long total = 0;
+  PersistentRegion region;
+  auto ns = time_per_region_ns([&](int i) {
+    auto epoch = region.submit([&]{ total += i; });
+    region.wait_for_epoch(epoch);
+  });
+  report("PersistentRegion::submit() + wait_for_epoch()", ns);
+  ASSERT_EQ(total, long(n_regions) * (n_regions - 1) / 2);
+  ASSERT_EQ(region.completed_epoch(), size_t(n_regions));
+  ASSERT_TRUE(region.is_quiescent());
+}
@@ -0,0 +1,129 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                      benchmark_sso_key.cc
+//                         DARMA
+//              Copyright (C) 2017 NTESS, LLC
+//
+// Under the terms of Contract DE-NA-0003525 with NTESS, LLC,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact darma@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+*/
+
+// Microbenchmark of SSOKey construction and hashing for keys of three ints.
+// This file is built twice: once as is, and once with
+// DARMA_SSO_KEY_NO_INTEGER_FAST_PATH defined, to compare the all-integer
+// fast path against the general (component by component) encoding.
+
+#include <gtest/gtest.h>
+
+#include <darma/key/SSO_key.h>
+#include <darma/key/key_concept.h>
+
+#include <darma/impl/darma.h>
+
+#include <chrono>
+#include <iostream>
+
+using namespace darma;
+using namespace darma::detail;
+
+using sso_key_t = SSOKey<>;
+
+#include "test_frontend.h"
+#include "mock_backend.h"
+
+class BenchmarkSSOKey
+  : public TestFrontend
+{
+  protected:
+
+    virtual void SetUp() {
+      setup_mock_runtime<::testing::NiceMock>();
+      TestFrontend::SetUp();
+    }
+
+    virtual void TearDown() {
+      TestFrontend::TearDown();
+    }
+
+    static constexpr int n_per_dim = 100;
+
+    template <typename Callable>
+    static double
+    time_per_key_ns(Callable&& f) {
+      auto start = std::chrono::steady_clock::now();
+      for(int i = 0; i < n_per_dim; ++i) {
+        for(int j = 0; j < n_per_dim; ++j) {
+          for(int k = 0; k < n_per_dim; ++k) {
+            f(i, j - n_per_dim / 2, k * 1000);
+          }
+        }
+      }
+      auto stop = std::chrono::steady_clock::now();
+      return std::chrono::duration<double, std::nano>(stop - start).count()
+        / (double(n_per_dim) * n_per_dim * n_per_dim);
+    }
+
+    static void
+    report(char const* what, double ns_per_key) {
+      std::cout << "[ BENCHMARK] " << what << " ("
+        << (_impl::integer_key_fast_path_enabled ? "fast path" : "general path")
+        << "): " << ns_per_key << " ns/key" << std::endl;
+    }
+};
+
+TEST_F(BenchmarkSSOKey, make_key_3_ints) {
+  auto maker = typename key_traits<sso_key_t>::maker{};
+  size_t total_size = 0;
+  auto ns = time_per_key_ns([&](int i, int j, int k) {
+    auto key = maker(i, j, k);
+    total_size += _impl::SSOKeyAttorney::get_data_size(key);
+  });
+  report("make_key(int, int, int)", ns);
+  ASSERT_GT(total_size, 0);
+}
+
+TEST_F(BenchmarkSSOKey, make_key_and_hash_3_ints) {
+  auto maker = typename key_traits<sso_key_t>::maker{};
+  auto hasher = typename key_traits<sso_key_t>::hasher{};
+  size_t hash_accumulator = 0;
+  auto ns = time_per_key_ns([&](int i, int j, int k) {
+    hash_accumulator ^= hasher(maker(i, j, k));
+  });
+  report("make_key(int, int, int) + hash", ns);
+  // use the result so the loop isn't optimized away
+  ASSERT_NE(hash_accumulator, size_t(1));
+}
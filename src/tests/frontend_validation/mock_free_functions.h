@@ -47,6 +47,7 @@
 #define SRC_TESTS_FRONTEND_VALIDATION_MOCK_FREE_FUNCTIONS_H_
 
 #include <utility>
+#include <vector>
 
 #include "mock_backend.h"
 #include <darma/interface/app/initial_access.h>
@@ -76,6 +77,13 @@ inline piecewise_collection_token_t register_piecewise_collection(runtime_contex
   return piecewise_collection_token_t();
 }
 
+inline persistent_collection_token_t register_persistent_collection(runtime_context_token_t,
+  std::shared_ptr<darma::abstract::frontend::Handle>,
+  size_t
+) {
+  return persistent_collection_token_t();
+}
+
 inline void
 register_piecewise_collection_piece(
   runtime_context_token_t context_token,
@@ -88,6 +96,56 @@ register_piecewise_collection_piece(
 
 }
 
+struct registered_piece_span {
+  std::vector<piecewise_collection_piece_t> pieces;
+  bool zero_copy;
+  bool has_callbacks;
+};
+
+inline std::vector<registered_piece_span>&
+registered_piece_spans() {
+  static std::vector<registered_piece_span> spans;
+  return spans;
+}
+
+inline void
+register_piecewise_collection_pieces(
+  runtime_context_token_t,
+  piecewise_collection_token_t,
+  piecewise_collection_piece_t const* pieces,
+  size_t n_pieces,
+  bool zero_copy,
+  std::function<void(void const*, void*)> copy_callback,
+  std::function<void(void const*, void*)> copy_back_callback
+) {
+  registered_piece_spans().push_back({
+    std::vector<piecewise_collection_piece_t>(pieces, pieces + n_pieces),
+    zero_copy,
+    bool(copy_callback) or bool(copy_back_callback)
+  });
+}
+
+inline std::vector<registered_piece_span>&
+aliased_persistent_collections() {
+  static std::vector<registered_piece_span> spans;
+  return spans;
+}
+
+inline persistent_collection_token_t
+register_aliased_persistent_collection(
+  runtime_context_token_t,
+  std::shared_ptr<darma::abstract::frontend::Handle>,
+  size_t,
+  piecewise_collection_piece_t const* pieces,
+  size_t n_pieces
+) {
+  aliased_persistent_collections().push_back({
+    std::vector<piecewise_collection_piece_t>(pieces, pieces + n_pieces),
+    /* zero_copy = */ true, /* has_callbacks = */ false
+  });
+  return persistent_collection_token_t();
+}
+
 inline void
 run_distributed_region(
   runtime_context_token_t,
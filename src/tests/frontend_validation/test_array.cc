@@ -48,8 +48,13 @@
 
 #include <darma/impl/array/index_decomposition.h>
 #include <darma/impl/array/indexable.h>
+#include <darma/impl/array/element_index_range.h>
+#include <darma/impl/array/concept.impl.h>
 #include <darma/impl/serialization/manager.h>
 
+#include <string>
+#include <vector>
+
 using namespace darma;
 using namespace darma::detail;
 
@@ -70,6 +75,222 @@ TEST(TestIndexDecomposition, vector_simple) {
 
 }
 
+TEST(TestIndexDecomposition, vector_pack_direct) {
+
+  using namespace ::testing;
+  using handler_t = darma::serialization::SimpleSerializationHandler<
+    std::allocator<std::vector<double>>
+  >;
+
+  using traits = IndexingTraits<std::vector<double>>;
+
+  static_assert(traits::has_contiguous_trivially_copyable_elements,
+    "std::vector<double> element ranges should be packed directly"
+  );
+  static_assert(
+    not IndexingTraits<std::vector<std::string>>::has_contiguous_trivially_copyable_elements,
+    "std::vector<std::string> element ranges can't be packed directly"
+  );
+
+  std::vector<double> v = { 3, 1, 4, 1, 5, 9 };
+
+  auto size_ar = handler_t::make_sizing_archive();
+  traits::get_packed_size(v, size_ar, 1, 4);
+  auto size = handler_t::get_size(size_ar);
+  // count, followed by just the slice
+  ASSERT_THAT(size, Eq(sizeof(size_t) + 4 * sizeof(double)));
+
+  std::vector<char> buffer(size);
+  auto pack_ar = handler_t::make_packing_archive(
+    darma::serialization::NonOwningSerializationBuffer(buffer.data(), size)
+  );
+  traits::pack_elements(v, pack_ar, 1, 4);
+
+  std::vector<double> v2 = { 2, 0, 0, 0, 0, 7, 8 };
+  auto unpack_ar = handler_t::make_unpacking_archive(
+    darma::serialization::ConstNonOwningSerializationBuffer(buffer.data(), size)
+  );
+  traits::unpack_elements(v2, unpack_ar, 1, 4);
+
+  ASSERT_THAT(v, ElementsAre(3, 1, 4, 1, 5, 9));
+  ASSERT_THAT(v2, ElementsAre(2, 1, 4, 1, 5, 7, 8));
+
+}
+
+namespace {
+
+template <typename T, typename RangeT>
+void
+round_trip_elements(T const& src, T& dest, RangeT const& range) {
+  using handler_t = darma::serialization::SimpleSerializationHandler<
+    std::allocator<T>
+  >;
+  using traits = IndexingTraits<T>;
+
+  auto size_ar = handler_t::make_sizing_archive();
+  traits::get_packed_size(src, size_ar, range);
+  auto size = handler_t::get_size(size_ar);
+
+  std::vector<char> buffer(size);
+  auto pack_ar = handler_t::make_packing_archive(
+    darma::serialization::NonOwningSerializationBuffer(buffer.data(), size)
+  );
+  traits::pack_elements(src, pack_ar, range);
+
+  auto unpack_ar = handler_t::make_unpacking_archive(
+    darma::serialization::ConstNonOwningSerializationBuffer(buffer.data(), size)
+  );
+  traits::unpack_elements(dest, unpack_ar, range);
+}
+
+} // end anonymous namespace
+
+TEST(TestIndexDecomposition, vector_pack_index_ranges) {
+
+  using namespace ::testing;
+
+  std::vector<double> v = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 };
+
+  {
+    // every third element, starting at 1
+    std::vector<double> v2(v.size(), -1);
+    round_trip_elements(v, v2, StridedElementRange(1, 4, 3));
+    ASSERT_THAT(v2, ElementsAre(-1, 1, -1, -1, 4, -1, -1, 7, -1, -1, 10, -1));
+  }
+  {
+    // 2x2 block in the middle of a 3x4 row-major matrix
+    std::vector<double> v2(v.size(), -1);
+    round_trip_elements(v, v2, ElementBlock2D(4, 1, 1, 2, 2));
+    ASSERT_THAT(v2, ElementsAre(-1, -1, -1, -1, -1, 5, 6, -1, -1, 9, 10, -1));
+  }
+  {
+    std::vector<double> v2(v.size(), -1);
+    round_trip_elements(v, v2, ElementIndexList{ 11, 0, 7 });
+    ASSERT_THAT(v2, ElementsAre(0, -1, -1, -1, -1, -1, -1, 7, -1, -1, -1, 11));
+  }
+
+}
+
+TEST(TestIndexDecomposition, vector_string_pack_index_list) {
+
+  using namespace ::testing;
+
+  std::vector<std::string> v = { "hello", "world", "foo", "bar" };
+  std::vector<std::string> v2(v.size());
+
+  round_trip_elements(v, v2, ElementIndexList{ 3, 1 });
+
+  ASSERT_THAT(v2, ElementsAre("", "world", "", "bar"));
+
+}
+
+TEST(TestIndexDecomposition, vector_gathered_element_range) {
+
+  using namespace ::testing;
+  using manager_t = ArrayConceptManagerForType<
+    std::vector<int>, SimpleElementRange<std::vector<int>>
+  >;
+
+  manager_t manager;
+  std::vector<int> v = { 3, 1, 4, 1, 5, 9 };
+
+  StridedElementRange range(0, 3, 2);
+  auto elem_range = manager.get_element_range(&v, &range);
+  ASSERT_TRUE(elem_range->is_deep_copy());
+
+  std::aligned_storage_t<sizeof(std::vector<int>)> buffer;
+  elem_range->setup(&buffer);
+  auto& gathered = *reinterpret_cast<std::vector<int>*>(&buffer);
+  ASSERT_THAT(gathered, ElementsAre(3, 4, 5));
+
+  gathered[1] = 42;
+  std::vector<int> v2 = { 0, 0, 0, 0, 0, 0 };
+  manager.set_element_range(&v2, *elem_range, &range);
+  ASSERT_THAT(v2, ElementsAre(3, 0, 42, 0, 5, 0));
+
+  gathered.~vector();
+
+}
+
+TEST(TestIndexDecomposition, vector_view_element_range) {
+
+  using namespace ::testing;
+  using vector_t = std::vector<double>;
+  using manager_t = ArrayConceptManagerForType<
+    vector_t, SimpleElementRange<vector_t>
+  >;
+
+  manager_t manager;
+  vector_t v = { 3, 1, 4, 1, 5, 9 };
+
+  auto elem_range = manager.get_element_range(&v, 1, 3);
+  ASSERT_FALSE(elem_range->is_deep_copy());
+  // The range refers directly to the parent's storage
+  ASSERT_THAT(elem_range->get_contiguous_data(), Eq(v.data() + 1));
+  ASSERT_THAT(elem_range->get_contiguous_data_size(), Eq(3 * sizeof(double)));
+
+  auto const* ser_man = elem_range->get_serialization_manager();
+  std::vector<char> md_buffer(ser_man->get_metadata_size());
+  elem_range->setup(md_buffer.data());
+
+  // Pack straight from the view and unpack as a vector
+  auto size = ser_man->get_packed_data_size(md_buffer.data(), nullptr);
+  ASSERT_THAT(size, Eq(sizeof(size_t) + 3 * sizeof(double)));
+  std::vector<char> buffer(size);
+  ser_man->pack_data(md_buffer.data(), buffer.data(), nullptr);
+
+  std::aligned_storage_t<sizeof(vector_t)> unpacked_buffer;
+  ser_man->unpack_data(&unpacked_buffer, buffer.data(), nullptr);
+  auto& unpacked = *reinterpret_cast<vector_t*>(&unpacked_buffer);
+  ASSERT_THAT(unpacked, ElementsAre(1, 4, 1));
+  ser_man->destroy(&unpacked_buffer);
+
+  // The range's concept manager works on the view, not on a vector
+  auto const* view_manager = elem_range->get_array_concept_manager();
+  ASSERT_THAT(view_manager->n_elements(md_buffer.data()), Eq(3));
+  auto sub_range = view_manager->get_element_range(md_buffer.data(), 1, 2);
+  ASSERT_THAT(sub_range->get_contiguous_data(), Eq(v.data() + 2));
+  ASSERT_THAT(sub_range->get_contiguous_data_size(), Eq(2 * sizeof(double)));
+
+  // Setting from the view copies out of the parent
+  vector_t v2 = { 0, 0, 0, 0, 0, 0 };
+  manager.set_element_range(&v2, *elem_range, 2, 3);
+  ASSERT_THAT(v2, ElementsAre(0, 0, 1, 4, 1, 0));
+
+  // ...and setting the parent from its own view is a no-op
+  manager.set_element_range(&v, *elem_range, 1, 3);
+  ASSERT_THAT(v, ElementsAre(3, 1, 4, 1, 5, 9));
+
+}
+
+TEST(TestIndexDecomposition, vector_string_element_range_copies) {
+
+  using namespace ::testing;
+  using vector_t = std::vector<std::string>;
+  using manager_t = ArrayConceptManagerForType<
+    vector_t, SimpleElementRange<vector_t>
+  >;
+
+  manager_t manager;
+  vector_t v = { "hello", "world", "foo", "bar" };
+
+  auto elem_range = manager.get_element_range(&v, 2, 2);
+  ASSERT_THAT(elem_range->get_contiguous_data(), IsNull());
+
+  std::aligned_storage_t<sizeof(vector_t)> buffer;
+  elem_range->setup(&buffer);
+  ASSERT_TRUE(elem_range->is_deep_copy());
+  auto& copied = *reinterpret_cast<vector_t*>(&buffer);
+  ASSERT_THAT(copied, ElementsAre("foo", "bar"));
+
+  vector_t v2(4);
+  manager.set_element_range(&v2, *elem_range, 0, 2);
+  ASSERT_THAT(v2, ElementsAre("foo", "bar", "", ""));
+
+  copied.~vector();
+
+}
+
 #ifdef OLD_SERIALIZATION_INTERFACE_UPDATE_THIS
 TEST(TestIndexDecomposition, vector_pack) {
 
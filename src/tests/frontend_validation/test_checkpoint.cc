@@ -0,0 +1,195 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                      test_checkpoint.cc
+//                         DARMA
+//              Copyright (C) 2018 Sandia Corporation
+//
+// Under the terms of Contract DE-NA-0003525 with NTESS, LLC,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact darma@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "mock_backend.h"
+#include "test_frontend.h"
+
+#include <darma/serialization/serializers/standard_library/string.h>
+#include <darma/serialization/serializers/standard_library/vector.h>
+
+#include <darma/interface/app/initial_access.h>
+#include <darma/interface/app/create_work.h>
+#include <darma/interface/app/checkpoint.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+class TestCheckpoint
+  : public TestFrontend
+{
+  protected:
+
+    virtual void SetUp() {
+      using namespace ::testing;
+
+      // A fresh file in the temporary directory, removed in TearDown()
+      char const* tmpdir = std::getenv("TMPDIR");
+      checkpoint_path = std::string(tmpdir ? tmpdir : "/tmp")
+        + "/darma_test_checkpoint_XXXXXX";
+      int fd = ::mkstemp(&checkpoint_path[0]);
+      ASSERT_NE(fd, -1);
+      ::close(fd);
+
+      setup_mock_runtime<::testing::NiceMock>();
+      TestFrontend::SetUp();
+      ON_CALL(*mock_runtime, get_running_task())
+        .WillByDefault(Return(top_level_task.get()));
+
+      // Act as a (very) simple backend: give every handle its own
+      // default-constructed data, shared by all of its immediate uses
+      ON_CALL(*mock_runtime, legacy_register_use(_))
+        .WillByDefault(Invoke([this](auto* use) {
+          if(use->immediate_permissions() == darma::frontend::Permissions::None) {
+            return;
+          }
+          auto handle = use->get_handle();
+          auto& entry = data_for_handle_[handle.get()];
+          if(entry.second == nullptr) {
+            auto const* ser_man = handle->get_serialization_manager();
+            entry.first = handle;
+            entry.second = ::operator new(ser_man->get_metadata_size());
+            ser_man->default_construct(entry.second);
+          }
+          use->get_data_pointer_reference() = entry.second;
+        }));
+    }
+
+    virtual void TearDown() {
+      for(auto& pair : data_for_handle_) {
+        pair.second.first->get_serialization_manager()->destroy(
+          pair.second.second
+        );
+        ::operator delete(pair.second.second);
+      }
+      data_for_handle_.clear();
+      std::remove(checkpoint_path.c_str());
+      TestFrontend::TearDown();
+    }
+
+    std::string checkpoint_path;
+
+    std::map<
+      darma::abstract::frontend::Handle const*,
+      std::pair<std::shared_ptr<darma::abstract::frontend::Handle const>, void*>
+    > data_for_handle_;
+
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST_F(TestCheckpoint, round_trip) {
+  using namespace ::testing;
+  using namespace darma;
+  using namespace mock_backend;
+
+  mock_runtime->save_tasks = true;
+
+  std::vector<double> values = { 1.5, -2.25, 3.125, 1e10 };
+  auto const path = checkpoint_path;
+
+  //============================================================================
+  // actual code being tested (checkpoint)
+  {
+    auto i = initial_access<int>("ckpt", "int");
+    auto v = initial_access<std::vector<double>>("ckpt", "vector");
+    auto s = initial_access<std::string>("ckpt", "string");
+
+    create_work([=]{
+      i.set_value(42);
+      v.set_value(values);
+      s.set_value(std::string(100, 'x'));
+      auto size = write_checkpoint(path, i, v, s);
+      EXPECT_THAT(size, Gt(sizeof(int) + values.size() * sizeof(double) + 100));
+    });
+  }
+  //============================================================================
+
+  run_all_tasks();
+
+  //============================================================================
+  // actual code being tested (restart)
+  {
+    Checkpoint ckpt(path);
+
+    EXPECT_THAT(ckpt.size(), Eq(3));
+    EXPECT_TRUE(ckpt.contains(make_key("ckpt", "vector")));
+    EXPECT_FALSE(ckpt.contains(make_key("ckpt", "missing")));
+    // nothing is unpacked until it's asked for
+    EXPECT_THAT(ckpt.n_entries_restored(), Eq(0));
+
+    auto i = initial_access<int>("ckpt", "int");
+    auto v = initial_access<std::vector<double>>("ckpt", "vector");
+    auto s = initial_access<std::string>("ckpt", "string");
+
+    create_work([=, &ckpt]{
+      ckpt.restore(v);
+      EXPECT_THAT(v.get_value(), ContainerEq(values));
+      EXPECT_THAT(ckpt.n_entries_restored(), Eq(1));
+
+      ckpt.restore(i);
+      EXPECT_THAT(i.get_value(), Eq(42));
+      EXPECT_THAT(ckpt.n_entries_restored(), Eq(2));
+
+      // s is never touched, so it is never unpacked
+      EXPECT_THAT(s.get_value(), Eq(""));
+    });
+
+    run_all_tasks();
+
+    EXPECT_THAT(ckpt.n_entries_restored(), Eq(2));
+  }
+  //============================================================================
+}
@@ -326,6 +326,67 @@ INSTANTIATE_TEST_CASE_P(
 
 ////////////////////////////////////////////////////////////////////////////////
 
+// A task that contributes twice with the same tag before the other local task
+// arrives must have its contributions counted towards separate allreduces
+TEST_F(TestCollectives, local_combiner_repeated_tag) {
+  using namespace ::testing;
+  using namespace darma;
+  using namespace darma::detail;
+
+  using combiner_t = LocalAllreduceCombiner;
+
+  struct RecordedContribution : combiner_t::DeferredContribution {
+    std::vector<std::size_t>* submitted;
+    explicit RecordedContribution(std::vector<std::size_t>* s) : submitted(s) { }
+    void submit(std::size_t n_combined) override {
+      submitted->push_back(n_combined);
+    }
+  };
+
+  std::vector<std::size_t> submitted;
+  int n_folds = 0;
+  auto fold = [&](std::shared_ptr<void> partial) {
+    ++n_folds;
+    return partial ? partial : std::make_shared<int>(0);
+  };
+  auto make_deferred = [&] {
+    return combiner_t::deferred_ptr_t(new RecordedContribution(&submitted));
+  };
+
+  combiner_t combiner(2);
+  auto const tag = make_key();
+
+  auto first_0 = combiner.arrive(tag, 0, true, fold, make_deferred);
+  auto second_0 = combiner.arrive(tag, 0, true, fold, make_deferred);
+  EXPECT_FALSE(first_0.is_last);
+  EXPECT_FALSE(second_0.is_last);
+  EXPECT_THAT(n_folds, Eq(2));
+
+  auto first_1 = combiner.arrive(tag, 1, true, fold, make_deferred);
+  ASSERT_TRUE(first_1.is_last);
+  EXPECT_THAT(first_1.n_folded, Eq(2));
+  EXPECT_THAT(first_1.to_submit.size(), Eq(1));
+
+  auto second_1 = combiner.arrive(tag, 1, true, fold, make_deferred);
+  ASSERT_TRUE(second_1.is_last);
+  EXPECT_THAT(second_1.n_folded, Eq(2));
+  EXPECT_THAT(second_1.to_submit.size(), Eq(1));
+
+  // Nothing is handed to the backend by the combiner itself unless a group
+  // falls back
+  EXPECT_THAT(submitted, IsEmpty());
+
+  auto folded_0 = combiner.arrive(tag, 0, true, fold, make_deferred);
+  EXPECT_FALSE(folded_0.is_last);
+  auto unfolded_1 = combiner.arrive(tag, 1, false, fold, make_deferred);
+  EXPECT_TRUE(unfolded_1.is_last);
+  EXPECT_FALSE(unfolded_1.fold);
+  // The held contribution now goes with its own data
+  EXPECT_THAT(submitted, ElementsAre(1));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 //TEST(TestReduceOp, string) {
 //  using namespace darma;
 //  using namespace darma::detail;
@@ -53,6 +53,9 @@ class TestCreateWork_mod_capture_MM_Test;
 #include <darma/interface/app/initial_access.h>
 #include <darma/interface/app/read_access.h>
 #include <darma/interface/app/create_work.h>
+#include <darma/interface/app/moved_capture.h>
+#include <darma/interface/app/task_affinity.h>
+#include <darma/interface/app/task_priority.h>
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -1131,3 +1134,180 @@ TEST_F(TestCreateWork, mod_capture_new_track_same) {
   mock_runtime->registered_tasks.clear();
 
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct CopyCountingSentinel {
+  static int n_copies;
+  static int n_moves;
+  int value = 0;
+  CopyCountingSentinel() = default;
+  explicit CopyCountingSentinel(int v) : value(v) { }
+  CopyCountingSentinel(CopyCountingSentinel const& other)
+    : value(other.value)
+  { ++n_copies; }
+  CopyCountingSentinel(CopyCountingSentinel&& other)
+    : value(other.value)
+  { ++n_moves; }
+};
+int CopyCountingSentinel::n_copies = 0;
+int CopyCountingSentinel::n_moves = 0;
+
+TEST_F(TestCreateWork, moved_capture_copy_count) {
+  using namespace ::testing;
+  using namespace darma;
+  using namespace mock_backend;
+
+  int plain_copies = 0;
+  int value_seen = 0;
+
+  //============================================================================
+  // Actual code being tested
+  {
+    CopyCountingSentinel s(42);
+    CopyCountingSentinel::n_copies = CopyCountingSentinel::n_moves = 0;
+
+    create_work([=, &value_seen]{ value_seen = s.value; });
+
+    plain_copies = CopyCountingSentinel::n_copies;
+
+    run_all_tasks();
+    EXPECT_THAT(value_seen, Eq(42));
+  }
+
+  {
+    value_seen = 0;
+    CopyCountingSentinel s(73);
+    CopyCountingSentinel::n_copies = CopyCountingSentinel::n_moves = 0;
+
+    create_work([&value_seen, s=darma::moved(std::move(s))]{
+      value_seen = s->value;
+    });
+
+    EXPECT_THAT(CopyCountingSentinel::n_copies, Eq(0));
+    EXPECT_THAT(CopyCountingSentinel::n_moves, Gt(0));
+
+    run_all_tasks();
+    EXPECT_THAT(value_seen, Eq(73));
+  }
+
+  {
+    // A named lambda could be invoked again, so it must be copied as usual
+    value_seen = 0;
+    CopyCountingSentinel::n_copies = CopyCountingSentinel::n_moves = 0;
+
+    auto task_body = [&value_seen, s=darma::moved(CopyCountingSentinel(11))]{
+      value_seen = s->value;
+    };
+    create_work(task_body);
+
+    EXPECT_THAT(CopyCountingSentinel::n_copies, Eq(1));
+
+    run_all_tasks();
+    EXPECT_THAT(value_seen, Eq(11));
+  }
+  //============================================================================
+
+  // one copy into the closure and one into the task
+  EXPECT_THAT(plain_copies, Eq(2));
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST_F(TestCreateWork, affinity_hint) {
+  using namespace ::testing;
+  using namespace darma;
+  using namespace darma::keyword_arguments_for_task_creation;
+  using namespace mock_backend;
+
+  using affinity_kind = abstract::frontend::TaskAffinity::Kind;
+
+  // Anything with a get_key() (e.g., an AccessHandle) can be given
+  struct HandleLike {
+    types::key_t key = make_key("hello");
+    types::key_t const& get_key() const { return key; }
+  };
+
+  int n_run = 0;
+
+  //============================================================================
+  // Actual code being tested
+  {
+    create_work([&n_run]{ ++n_run; });
+
+    create_work(affinity=on_socket(2), [&n_run]{ ++n_run; });
+
+    create_work(affinity=same_socket_as(HandleLike{}), [&n_run]{ ++n_run; });
+  }
+  //============================================================================
+
+  ASSERT_THAT(mock_runtime->registered_tasks.size(), Eq(3));
+
+  auto const& no_hint = mock_runtime->registered_tasks[0]->get_affinity();
+  EXPECT_TRUE(no_hint.is_none());
+
+  auto const& socket_hint = mock_runtime->registered_tasks[1]->get_affinity();
+  EXPECT_THAT(socket_hint.kind(), Eq(affinity_kind::Socket));
+  EXPECT_THAT(socket_hint.socket_index(), Eq(2));
+
+  auto const& handle_hint = mock_runtime->registered_tasks[2]->get_affinity();
+  EXPECT_THAT(handle_hint.kind(), Eq(affinity_kind::SameSocketAsHandle));
+  EXPECT_THAT(handle_hint.handle_key(), Eq(make_key("hello")));
+
+  run_all_tasks();
+
+  EXPECT_THAT(n_run, Eq(3));
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST_F(TestCreateWork, priority_hint) {
+  using namespace ::testing;
+  using namespace darma;
+  using namespace darma::keyword_arguments_for_create_work;
+  using namespace mock_backend;
+
+  int n_run = 0;
+
+  //============================================================================
+  // Actual code being tested
+  {
+    create_work([&n_run]{ ++n_run; });
+
+    create_work(priority=5, [&n_run]{
+      ++n_run;
+      // nested tasks can stay ahead of bulk work created elsewhere
+      create_work(priority=inherit_priority(2), [&n_run]{ ++n_run; });
+      create_work(priority=1, [&n_run]{ ++n_run; });
+    });
+  }
+  //============================================================================
+
+  ASSERT_THAT(mock_runtime->registered_tasks.size(), Eq(2));
+
+  EXPECT_THAT(mock_runtime->registered_tasks[0]->get_priority(), Eq(0));
+  EXPECT_THAT(mock_runtime->registered_tasks[1]->get_priority(), Eq(5));
+
+  run_one_task();
+
+  auto* outer = mock_runtime->registered_tasks.front().get();
+  ON_CALL(*mock_runtime, get_running_task())
+    .WillByDefault(Return(outer));
+
+  run_one_task();
+
+  ON_CALL(*mock_runtime, get_running_task())
+    .WillByDefault(Return(top_level_task.get()));
+
+  ASSERT_THAT(mock_runtime->registered_tasks.size(), Eq(2));
+
+  EXPECT_THAT(mock_runtime->registered_tasks[0]->get_priority(), Eq(7));
+  EXPECT_THAT(mock_runtime->registered_tasks[1]->get_priority(), Eq(1));
+
+  run_all_tasks();
+
+  EXPECT_THAT(n_run, Eq(4));
+
+}
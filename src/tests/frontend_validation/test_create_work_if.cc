@@ -49,6 +49,8 @@
 
 #include <darma.h>
 #include <darma/interface/app/create_work_if.h>
+#include <darma/interface/app/task_priority.h>
+#include <darma/interface/app/task_affinity.h>
 #include <darma/impl/top_level.h>
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -239,6 +241,108 @@ TEST_F(TestCreateWorkIf, basic_same_always_true) {
 
 ////////////////////////////////////////////////////////////////////////////////
 
+TEST_F(TestCreateWorkIf, priority_hint) {
+  using namespace darma;
+  using namespace ::testing;
+  using namespace darma::keyword_arguments_for_create_work;
+  using namespace mock_backend;
+
+  mock_runtime->save_tasks = true;
+
+  DECLARE_MOCK_FLOWS(
+    f_init, f_null, f_if_out, f_then_out
+  );
+  use_t* if_use, *then_use, *use_outer_cont, *use_init, *then_cont_use;
+
+  int value = 0;
+
+  EXPECT_INITIAL_ACCESS(f_init, f_null, use_init, make_key("hello"));
+
+  EXPECT_CALL(*mock_runtime, make_next_flow(f_init))
+    .WillOnce(Return(f_if_out));
+
+  EXPECT_REGISTER_USE(use_outer_cont, f_if_out, f_null, Modify, None);
+
+  {
+    InSequence reg_before_release;
+
+    EXPECT_REGISTER_USE_AND_SET_BUFFER(if_use, f_init, f_if_out, Modify, Read, value);
+
+    EXPECT_RELEASE_USE(use_init);
+
+    EXPECT_REGISTER_TASK(if_use);
+  }
+
+  EXPECT_FLOW_ALIAS(f_if_out, f_null);
+
+  EXPECT_RELEASE_USE(use_outer_cont);
+
+  //============================================================================
+  // actual code being tested
+  {
+
+    auto tmp = initial_access<int>("hello");
+
+    create_work_if(priority=5, affinity=on_socket(1), [=]{
+      return tmp.get_value() == 0; // should always be true
+    }).then_(priority=inherit_priority(3), affinity=on_socket(3), [=]{
+      tmp.set_value(73);
+    });
+
+  }
+  //============================================================================
+
+  Mock::VerifyAndClearExpectations(mock_runtime.get());
+
+  ASSERT_THAT(mock_runtime->registered_tasks.size(), Eq(1));
+  EXPECT_THAT(mock_runtime->registered_tasks[0]->get_priority(), Eq(5));
+  EXPECT_THAT(
+    mock_runtime->registered_tasks[0]->get_affinity().socket_index(), Eq(1)
+  );
+
+  {
+    InSequence seq;
+
+    EXPECT_CALL(*mock_runtime, make_next_flow(f_init))
+      .WillOnce(Return(f_then_out));
+
+    EXPECT_REGISTER_USE_AND_SET_BUFFER(then_use, f_init, f_then_out, Modify, Modify, value);
+
+    EXPECT_REGISTER_USE(then_cont_use, f_then_out, f_if_out, Modify, None);
+
+    EXPECT_RELEASE_USE(if_use);
+
+    EXPECT_REGISTER_TASK(then_use);
+
+    EXPECT_FLOW_ALIAS(f_then_out, f_if_out);
+
+    EXPECT_RELEASE_USE(then_cont_use);
+  }
+
+  run_one_task();
+
+  Mock::VerifyAndClearExpectations(mock_runtime.get());
+
+  // the then task is created along with the if task, so it inherits from the
+  // task that called create_work_if (the top-level task, with priority 0)
+  ASSERT_THAT(mock_runtime->registered_tasks.size(), Eq(1));
+  EXPECT_THAT(mock_runtime->registered_tasks[0]->get_priority(), Eq(3));
+  EXPECT_THAT(
+    mock_runtime->registered_tasks[0]->get_affinity().socket_index(), Eq(3)
+  );
+
+  EXPECT_RELEASE_USE(then_use);
+
+  run_one_task();
+
+  Mock::VerifyAndClearExpectations(mock_runtime.get());
+
+  EXPECT_THAT(value, Eq(73));
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 TEST_F(TestCreateWorkIf, basic_same_always_true_functor) {
   using namespace darma;
   using namespace ::testing;
@@ -50,6 +50,8 @@
 #include <darma/impl/create_work/create_work_while.h>
 #include <darma/interface/app/initial_access.h>
 #include <darma/interface/app/create_work_while.h>
+#include <darma/interface/app/task_priority.h>
+#include <darma/interface/app/task_affinity.h>
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -693,6 +695,219 @@ TEST_F_WITH_PARAMS(TestCreateWorkWhile, one_handle_four_iterations,
 
 ////////////////////////////////////////////////////////////////////////////////
 
+TEST_F_WITH_PARAMS(TestCreateWorkWhile, priority_hint_two_iterations,
+  ::testing::Combine(::testing::Bool(), ::testing::Bool()),
+  std::tuple<bool, bool>
+) {
+  using namespace darma;
+  using namespace ::testing;
+  using namespace darma::keyword_arguments_for_create_work;
+  using namespace mock_backend;
+
+  mock_runtime->save_tasks = true;
+
+  bool while_is_functor = std::get<0>(GetParam());
+  bool do_is_functor = std::get<1>(GetParam());
+
+  DECLARE_MOCK_FLOWS(
+    f_init, f_null, f_while_out
+  );
+  MockFlow f_do_out[2];
+  MockFlow f_inner_while_out[2];
+
+  use_t* initial_use = nullptr;
+  use_t* while_use = nullptr;
+  use_t* outer_cont_use = nullptr;
+  use_t* do_use[2];
+  use_t* do_cont_use[2];
+  use_t* inner_while_use[2];
+  use_t* inner_while_cont_use[2];
+
+  int value = 0;
+
+  EXPECT_NEW_INITIAL_ACCESS(f_init, f_null, initial_use, make_key("hello"));
+
+  EXPECT_NEW_REGISTER_USE_AND_SET_BUFFER(while_use,
+    f_init, Same, &f_init,
+    f_while_out, Next, nullptr, true,
+    Modify, Read, true,
+    value
+  );
+
+  EXPECT_NEW_REGISTER_USE(outer_cont_use,
+    f_while_out, Same, &f_while_out,
+    f_null, Same, &f_null, false,
+    Modify, None, false
+  );
+
+  EXPECT_NEW_RELEASE_USE(initial_use, false);
+
+  EXPECT_REGISTER_TASK(while_use);
+
+  EXPECT_NEW_RELEASE_USE(outer_cont_use, true);
+
+  //============================================================================
+  // actual code being tested
+  {
+
+    struct WhileFunctor {
+      bool operator()(ReadAccessHandle<int> tmp_arg) const {
+        return tmp_arg.get_value() < 2;
+      }
+    };
+
+    struct DoFunctor {
+      void operator()(AccessHandle<int> tmp_arg) const {
+        tmp_arg.set_value(tmp_arg.get_value() + 1);
+      }
+    };
+
+    auto tmp = initial_access<int>("hello");
+
+    if(!while_is_functor and !do_is_functor) {
+      create_work_while(priority=5, affinity=on_socket(1), [=]{
+        return WhileFunctor{}(tmp);
+      }).do_(priority=2, affinity=on_socket(3), [=]{
+        DoFunctor{}(tmp);
+      });
+    }
+    else if(!while_is_functor and do_is_functor) {
+      create_work_while(priority=5, affinity=on_socket(1), [=]{
+        return WhileFunctor{}(tmp);
+      }).do_<DoFunctor>(tmp, priority=2, affinity=on_socket(3));
+    }
+    else if(while_is_functor and !do_is_functor) {
+      create_work_while<WhileFunctor>(tmp, priority=5, affinity=on_socket(1))
+        .do_(priority=2, affinity=on_socket(3), [=]{
+          DoFunctor{}(tmp);
+        });
+    }
+    else {
+      assert(while_is_functor and do_is_functor);
+      create_work_while<WhileFunctor>(tmp, priority=5, affinity=on_socket(1))
+        .do_<DoFunctor>(tmp, priority=2, affinity=on_socket(3));
+    }
+
+  }
+  //============================================================================
+
+  ASSERT_THAT(mock_runtime->registered_tasks.size(), Eq(1));
+  EXPECT_THAT(mock_runtime->registered_tasks[0]->get_priority(), Eq(5));
+  EXPECT_THAT(
+    mock_runtime->registered_tasks[0]->get_affinity().socket_index(), Eq(1)
+  );
+
+  for(int i = 0; i < 2; ++i) {
+
+    //------------------------------------------------------------------------------
+    // <editor-fold desc="outer while block"> {{{2
+
+    Mock::VerifyAndClearExpectations(mock_runtime.get());
+
+    {
+      InSequence seq;
+      EXPECT_NEW_REGISTER_USE_AND_SET_BUFFER(do_use[i],
+        (i == 0 ? f_init : f_do_out[i-1]),
+        Same,
+        (i == 0 ? &f_init : &(f_do_out[i-1])),
+        f_do_out[i], Next, nullptr, true,
+        Modify, Modify, true,
+        value
+      );
+      EXPECT_NEW_REGISTER_USE(do_cont_use[i],
+        f_do_out[i], Same, &f_do_out[i],
+        (i == 0 ? f_while_out : f_inner_while_out[i-1]),
+        Same,
+        (i == 0 ? &f_while_out : &f_inner_while_out[i-1]),
+        false,
+        Modify, None, false
+      );
+      EXPECT_NEW_RELEASE_USE(
+        (i == 0 ? while_use : inner_while_use[i-1]),
+        false
+      );
+
+      EXPECT_REGISTER_TASK(do_use[i]);
+    }
+
+    {
+      InSequence seq;
+      EXPECT_NEW_REGISTER_USE_AND_SET_BUFFER(inner_while_use[i],
+        f_do_out[i], Same, &f_do_out[i],
+        f_inner_while_out[i], Next, nullptr, true,
+        Modify, Read, true,
+        value
+      );
+      EXPECT_NEW_REGISTER_USE(inner_while_cont_use[i],
+        f_inner_while_out[i], Same, &f_inner_while_out[i],
+        (i == 0 ? f_while_out : f_inner_while_out[i-1]),
+        Same,
+        (i == 0 ? &f_while_out : &f_inner_while_out[i-1]),
+        false,
+        Modify, None, false
+      );
+      EXPECT_NEW_RELEASE_USE(do_cont_use[i], false);
+
+      EXPECT_REGISTER_TASK(inner_while_use[i]);
+    }
+
+    EXPECT_NEW_RELEASE_USE(inner_while_cont_use[i], true);
+
+    EXPECT_FIRST_TASK_RUNNING();
+
+    run_one_task();
+
+    // every iteration keeps the priorities and affinities given to the first
+    // while and do
+    ASSERT_THAT(mock_runtime->registered_tasks.size(), Eq(2));
+    EXPECT_THAT(mock_runtime->registered_tasks[0]->get_priority(), Eq(2));
+    EXPECT_THAT(mock_runtime->registered_tasks[1]->get_priority(), Eq(5));
+    EXPECT_THAT(
+      mock_runtime->registered_tasks[0]->get_affinity().socket_index(), Eq(3)
+    );
+    EXPECT_THAT(
+      mock_runtime->registered_tasks[1]->get_affinity().socket_index(), Eq(1)
+    );
+
+    // </editor-fold> end outer while block }}}2
+    //------------------------------------------------------------------------------
+
+    //------------------------------------------------------------------------------
+    // <editor-fold desc="do block"> {{{2
+
+    Mock::VerifyAndClearExpectations(mock_runtime.get());
+
+    EXPECT_NEW_RELEASE_USE(do_use[i], false);
+
+    EXPECT_FIRST_TASK_RUNNING();
+
+    run_one_task();
+
+    // </editor-fold> end do block }}}2
+    //------------------------------------------------------------------------------
+
+  }
+
+  //------------------------------------------------------------------------------
+  // <editor-fold desc="last inner while block"> {{{2
+
+  Mock::VerifyAndClearExpectations(mock_runtime.get());
+
+  EXPECT_NEW_RELEASE_USE(inner_while_use[1], true);
+
+  EXPECT_FIRST_TASK_RUNNING();
+
+  run_one_task();
+
+  // </editor-fold> end inner while block }}}2
+  //------------------------------------------------------------------------------
+
+  EXPECT_THAT(value, Eq(2));
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 TEST_F_WITH_PARAMS(TestCreateWorkWhile, two_handles_one_iteration_two_in_while,
   ::testing::Combine(::testing::Bool(), ::testing::Bool()),
   std::tuple<bool, bool>
@@ -42,6 +42,11 @@
 //@HEADER
 */
 
+// The rest of the frontend validation tests are built without DARMA regions
+#include "darma_features.h"
+#undef _darma_has_feature_darma_regions
+#define _darma_has_feature_darma_regions 1
+
 #include <gtest/gtest.h>
 
 #include "mock_backend.h"
@@ -49,6 +54,84 @@
 
 #include <darma/interface/backend/darma_region.h>
 #include <darma/interface/app/darma_region.h>
+#include <darma/interface/app/region_handle.h>
+
+#include <functional>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+// Mock backend for regions: the callable given to with_active_runtime_instance()
+// runs immediately, and an instance only becomes quiescent (running its
+// quiescence callbacks) when a test says so
+
+namespace {
+
+struct MockRegionBackend {
+  std::size_t n_instances_created = 0;
+  std::vector<std::string> activated_instances;
+  std::map<std::string, std::vector<std::function<void()>>>
+    quiescence_callbacks;
+
+  std::size_t
+  n_callbacks(darma::types::runtime_instance_token_t const& instance) const {
+    auto found = quiescence_callbacks.find(instance.name);
+    return found == quiescence_callbacks.end() ? 0 : found->second.size();
+  }
+
+  void
+  make_quiescent(darma::types::runtime_instance_token_t const& instance) {
+    auto found = quiescence_callbacks.find(instance.name);
+    if(found == quiescence_callbacks.end()) return;
+    auto callbacks = std::move(found->second);
+    quiescence_callbacks.erase(found);
+    for(auto& callback : callbacks) callback();
+  }
+};
+
+MockRegionBackend region_backend;
+
+} // end anonymous namespace
+
+namespace darma {
+namespace backend {
+
+void initialize_with_arguments(int&, char**&) { }
+
+void finalize() { }
+
+types::runtime_instance_token_t
+initialize_runtime_instance() {
+  types::runtime_instance_token_t rv;
+  rv.name = "instance_" + std::to_string(++region_backend.n_instances_created);
+  return rv;
+}
+
+void
+register_runtime_instance_quiescence_callback(
+  types::runtime_instance_token_t& token,
+  std::function<void()> callback
+) {
+  region_backend.quiescence_callbacks[token.name].push_back(
+    std::move(callback)
+  );
+}
+
+void
+with_active_runtime_instance(
+  types::runtime_instance_token_t& token,
+  std::function<void()> callback
+) {
+  region_backend.activated_instances.push_back(token.name);
+  callback();
+}
+
+} // end namespace backend
+} // end namespace darma
+
+////////////////////////////////////////////////////////////////////////////////
 
 class TestDARMARegion
   : public TestFrontend
@@ -62,10 +145,243 @@ class TestDARMARegion
       TestFrontend::SetUp();
       ON_CALL(*mock_runtime, get_running_task())
         .WillByDefault(Return(top_level_task.get()));
+      region_backend.activated_instances.clear();
     }
 
     virtual void TearDown() {
+      region_backend.quiescence_callbacks.clear();
       TestFrontend::TearDown();
     }
 
 };
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST_F(TestDARMARegion, region_handle_continuations) {
+  using namespace ::testing;
+  using namespace darma::experimental;
+
+  // Stand-ins for the quiescence of two in-flight regions
+  auto first_region = std::make_shared<_impl::RegionCompletionState>();
+  auto second_region = std::make_shared<_impl::RegionCompletionState>();
+
+  std::vector<int> order;
+
+  //============================================================================
+  // Actual code being tested
+  RegionHandle first(first_region);
+  auto after_first = first.then([&]{ order.push_back(1); });
+  // A continuation that posts the next region
+  auto after_second = after_first.then([&]{
+    order.push_back(2);
+    return RegionHandle(second_region);
+  });
+
+  EXPECT_FALSE(first.is_ready());
+  EXPECT_FALSE(after_second.is_ready());
+  EXPECT_THAT(order, IsEmpty());
+
+  std::thread drain([&]{ first_region->set_done(); });
+  after_first.wait();
+  drain.join();
+
+  EXPECT_TRUE(first.is_ready());
+  EXPECT_THAT(order, ElementsAre(1, 2));
+  // still waiting on the region posted by the continuation
+  EXPECT_FALSE(after_second.is_ready());
+
+  second_region->set_done();
+  EXPECT_TRUE(after_second.is_ready());
+
+  // Continuations on completed regions run immediately
+  auto already_done = after_second.then([&]{ order.push_back(3); });
+  EXPECT_TRUE(already_done.is_ready());
+  //============================================================================
+
+  EXPECT_THAT(order, ElementsAre(1, 2, 3));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST_F(TestDARMARegion, region_epoch_counter) {
+  using namespace ::testing;
+  using namespace darma::experimental;
+
+  _impl::RegionEpochCounter counter;
+
+  EXPECT_TRUE(counter.is_quiescent());
+
+  //============================================================================
+  // Actual code being tested
+  auto first = counter.begin_epoch();
+  auto second = counter.begin_epoch();
+
+  EXPECT_THAT(first, Eq(1));
+  EXPECT_THAT(second, Eq(2));
+  EXPECT_THAT(counter.current_epoch(), Eq(2));
+  EXPECT_FALSE(counter.is_quiescent());
+
+  // Quiescence callbacks may be delivered out of order
+  counter.complete_epoch(second);
+  EXPECT_TRUE(counter.is_complete(first));
+  EXPECT_TRUE(counter.is_quiescent());
+
+  counter.complete_epoch(first);
+  EXPECT_THAT(counter.completed_epoch(), Eq(2));
+
+  auto third = counter.begin_epoch();
+  EXPECT_FALSE(counter.is_complete(third));
+  std::thread drain([&]{ counter.complete_epoch(third); });
+  counter.wait_for_epoch(third);
+  drain.join();
+  //============================================================================
+
+  EXPECT_TRUE(counter.is_quiescent());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST_F(TestDARMARegion, darma_region_async_separate_instances) {
+  using namespace ::testing;
+  using namespace darma::experimental;
+
+  std::vector<std::string> ran;
+
+  //============================================================================
+  // Actual code being tested
+  auto first_instance = make_runtime_instance();
+  auto second_instance = make_runtime_instance();
+  EXPECT_THAT(first_instance, Ne(second_instance));
+
+  auto first = darma_region_async(first_instance, [&]{
+    ran.push_back("first");
+  });
+  auto second = darma_region_async(second_instance, [&]{
+    ran.push_back("second");
+  });
+
+  EXPECT_THAT(ran, ElementsAre("first", "second"));
+  EXPECT_THAT(region_backend.activated_instances,
+    ElementsAre(first_instance.name, second_instance.name)
+  );
+  // both in flight at once
+  EXPECT_FALSE(first.is_ready());
+  EXPECT_FALSE(second.is_ready());
+
+  // each completes with its own instance
+  region_backend.make_quiescent(second_instance);
+  EXPECT_FALSE(first.is_ready());
+  EXPECT_TRUE(second.is_ready());
+
+  region_backend.make_quiescent(first_instance);
+  EXPECT_TRUE(first.is_ready());
+  //============================================================================
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST_F(TestDARMARegion, darma_region_async_temporary_instance) {
+  using namespace ::testing;
+  using namespace darma::experimental;
+
+  bool ran = false;
+  bool continued = false;
+
+  //============================================================================
+  // Actual code being tested
+  auto region = darma_region_async(make_runtime_instance(), [&]{
+    ran = true;
+  }).then([&]{ continued = true; });
+  //============================================================================
+
+  EXPECT_TRUE(ran);
+  EXPECT_FALSE(continued);
+  ASSERT_THAT(region_backend.activated_instances, SizeIs(1));
+
+  darma::types::runtime_instance_token_t instance;
+  instance.name = region_backend.activated_instances.back();
+  EXPECT_THAT(region_backend.n_callbacks(instance), Eq(1));
+  region_backend.make_quiescent(instance);
+
+  EXPECT_TRUE(continued);
+  EXPECT_TRUE(region.is_ready());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST_F(TestDARMARegion, persistent_region_submit) {
+  using namespace ::testing;
+  using namespace darma::experimental;
+
+  auto instance = make_runtime_instance();
+  std::vector<int> ran;
+  std::thread drain;
+
+  //============================================================================
+  // Actual code being tested
+  {
+    PersistentRegion region(instance);
+    EXPECT_TRUE(region.is_quiescent());
+
+    auto first = region.submit([&]{ ran.push_back(1); });
+    auto second = region.submit([&]{ ran.push_back(2); });
+
+    EXPECT_THAT(ran, ElementsAre(1, 2));
+    EXPECT_THAT(first, Eq(1));
+    EXPECT_THAT(second, Eq(2));
+    EXPECT_FALSE(region.is_complete(first));
+    // only one callback is outstanding, however many submissions there are
+    EXPECT_THAT(region_backend.n_callbacks(instance), Eq(1));
+
+    // The outstanding callback was registered for the first submission, so
+    // it only completes that one, and registers another for the second
+    region_backend.make_quiescent(instance);
+    EXPECT_TRUE(region.is_complete(first));
+    EXPECT_FALSE(region.is_complete(second));
+    EXPECT_THAT(region_backend.n_callbacks(instance), Eq(1));
+
+    region_backend.make_quiescent(instance);
+    EXPECT_TRUE(region.is_quiescent());
+    EXPECT_THAT(region.completed_epoch(), Eq(2));
+    EXPECT_THAT(region_backend.n_callbacks(instance), Eq(0));
+
+    // The destructor waits for the last submission to drain
+    auto third = region.submit([&]{ ran.push_back(3); });
+    EXPECT_THAT(third, Eq(3));
+    drain = std::thread([&]{ region_backend.make_quiescent(instance); });
+  }
+  //============================================================================
+
+  drain.join();
+  EXPECT_THAT(ran, ElementsAre(1, 2, 3));
+  EXPECT_THAT(region_backend.n_callbacks(instance), Eq(0));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST_F(TestDARMARegion, persistent_region_quiescent_during_submit) {
+  using namespace ::testing;
+  using namespace darma::experimental;
+
+  PersistentRegion region(make_runtime_instance());
+  darma::types::runtime_instance_token_t instance;
+
+  auto first = region.submit([&]{
+    instance.name = region_backend.activated_instances.back();
+    // the callback is registered before the work is launched
+    EXPECT_THAT(region_backend.n_callbacks(instance), Eq(1));
+  });
+
+  // The first epoch's callback fires while the second submission's work is
+  // being launched, and has to leave a callback registered for it
+  auto second = region.submit([&]{
+    region_backend.make_quiescent(instance);
+  });
+  EXPECT_TRUE(region.is_complete(first));
+  EXPECT_FALSE(region.is_complete(second));
+  EXPECT_THAT(region_backend.n_callbacks(instance), Eq(1));
+
+  region_backend.make_quiescent(instance);
+  EXPECT_TRUE(region.is_quiescent());
+  EXPECT_THAT(region_backend.n_callbacks(instance), Eq(0));
+}
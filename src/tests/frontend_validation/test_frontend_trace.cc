@@ -0,0 +1,231 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                      test_frontend_trace.cc
+//                         DARMA
+//              Copyright (C) 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-NA-0003525 with NTESS, LLC,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact darma@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+*/
+
+// Built with DARMA_TRACE_FRONTEND=1 (see CMakeLists.txt)
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "mock_backend.h"
+#include "test_frontend.h"
+
+#include <darma/interface/app/create_work.h>
+#include <darma/interface/app/initial_access.h>
+
+using namespace darma;
+
+////////////////////////////////////////////////////////////////////////////////
+
+class TestFrontendTrace
+  : public TestFrontend
+{
+  protected:
+
+    virtual void SetUp() {
+      using namespace ::testing;
+
+      setup_mock_runtime<::testing::NiceMock>();
+      TestFrontend::SetUp();
+      ON_CALL(*mock_runtime, get_running_task())
+        .WillByDefault(Return(top_level_task.get()));
+
+      // discard anything left over from other tests
+      std::vector<abstract::frontend::TraceEvent> leftover;
+      frontend::collect_trace_events(leftover);
+    }
+
+    virtual void TearDown() {
+      TestFrontend::TearDown();
+    }
+
+    using event_t = abstract::frontend::TraceEvent;
+    using kind_t = abstract::frontend::TraceEventKind;
+
+    static std::vector<event_t>
+    events_of_kind(std::vector<event_t> const& events, kind_t kind) {
+      std::vector<event_t> rv;
+      std::copy_if(events.begin(), events.end(), std::back_inserter(rv),
+        [&](event_t const& ev) { return ev.kind == kind; }
+      );
+      return rv;
+    }
+
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST_F(TestFrontendTrace, create_work_and_uses) {
+  using namespace ::testing;
+  using namespace darma::keyword_arguments_for_create_work;
+  using namespace mock_backend;
+
+  int n_run = 0;
+
+  //============================================================================
+  // Actual code being tested
+  {
+    auto tmp = initial_access<int>("hello");
+
+    create_work(name("with_handle"), [=]{
+      // This code doesn't run in this example
+      tmp.set_value(5);
+    });
+
+    create_work(name("traced"), [&n_run]{ ++n_run; });
+
+  } // tmp deleted
+  //============================================================================
+
+  ASSERT_THAT(mock_runtime->registered_tasks.size(), Eq(2));
+  auto const* traced_task = mock_runtime->registered_tasks[1].get();
+
+  mock_runtime->registered_tasks[1]->run();
+  EXPECT_THAT(n_run, Eq(1));
+
+  std::vector<event_t> events;
+  auto const n_collected = frontend::collect_trace_events(events);
+  ASSERT_THAT(n_collected, Eq(events.size()));
+  EXPECT_THAT(frontend::n_dropped_trace_events(), Eq(0));
+
+  auto creates = events_of_kind(events, kind_t::CreateWork);
+  ASSERT_THAT(creates.size(), Eq(2));
+  EXPECT_THAT(creates[0].name, Eq(make_key("with_handle")));
+  EXPECT_THAT(creates[1].name, Eq(make_key("traced")));
+  EXPECT_THAT(creates[1].task_id,
+    Eq(reinterpret_cast<std::uintptr_t>(traced_task))
+  );
+
+  auto runs = events_of_kind(events, kind_t::RunTask);
+  ASSERT_THAT(runs.size(), Eq(1));
+  EXPECT_THAT(runs[0].name, Eq(make_key("traced")));
+  EXPECT_THAT(runs[0].task_id, Eq(creates[1].task_id));
+  EXPECT_THAT(runs[0].begin_ns, Ge(creates[1].begin_ns));
+
+  // the initial access, the task's capture, and the continuation
+  auto registers = events_of_kind(events, kind_t::RegisterUse);
+  ASSERT_THAT(registers.size(), Eq(3));
+  for(auto const& ev : registers) {
+    EXPECT_THAT(ev.name, Eq(make_key("hello")));
+  }
+  // the task's capture happens while the task is being created
+  EXPECT_THAT(registers[1].begin_ns, Ge(creates[0].begin_ns));
+  EXPECT_THAT(registers[1].begin_ns + registers[1].duration_ns,
+    Le(creates[0].begin_ns + creates[0].duration_ns)
+  );
+
+  // the initial access and the continuation
+  EXPECT_THAT(events_of_kind(events, kind_t::ReleaseUse).size(), Eq(2));
+
+  EXPECT_THAT(events_of_kind(events, kind_t::MakeFlow).size(), Gt(0));
+
+  mock_runtime->registered_tasks.clear();
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST_F(TestFrontendTrace, chrome_trace_export) {
+  using namespace ::testing;
+
+  std::vector<event_t> events(4);
+
+  events[0].kind = kind_t::RunTask;
+  events[0].begin_ns = 3000;
+  events[0].duration_ns = 1500;
+  events[0].task_id = 0x1234;
+
+  // unnamed, so labeled by where it was created
+  events[1].kind = kind_t::CreateWork;
+  events[1].begin_ns = 1000;
+  events[1].duration_ns = 250;
+  events[1].task_id = 0x1234;
+  events[1].file = "/path/to/my_app.cc";
+  events[1].line = 42;
+  events[1].function = "main";
+
+  events[2].kind = kind_t::MakeFlow;
+  events[2].begin_ns = 1100;
+  events[2].name = make_key("data");
+  events[2].flow_relationship = 8;
+
+  events[3].kind = kind_t::Allreduce;
+  events[3].thread = 1;
+  events[3].begin_ns = 5000;
+  events[3].duration_ns = 10;
+  events[3].name = make_key("sum");
+  events[3].index = 2;
+
+  std::ostringstream sstr;
+  frontend::write_chrome_trace(sstr, events, 3);
+  auto const json = sstr.str();
+
+  EXPECT_THAT(json, StartsWith("{\"traceEvents\":["));
+  EXPECT_THAT(json, EndsWith("],\"displayTimeUnit\":\"ns\"}\n"));
+
+  // sorted by time, so the run comes after its creation
+  auto const create_pos = json.find("\"cat\":\"create_work\"");
+  auto const run_pos = json.find("{\"name\":\"my_app.cc:42\",\"cat\":\"run\"");
+  ASSERT_THAT(create_pos, Ne(std::string::npos));
+  ASSERT_THAT(run_pos, Ne(std::string::npos));
+  EXPECT_THAT(create_pos, Lt(run_pos));
+
+  EXPECT_THAT(json, HasSubstr(
+    "\"ph\":\"X\",\"ts\":3.000,\"pid\":3,\"tid\":0,\"dur\":1.500"
+  ));
+  EXPECT_THAT(json, HasSubstr("\"file\":\"/path/to/my_app.cc\",\"line\":42"));
+  EXPECT_THAT(json, HasSubstr("\"ph\":\"s\""));
+  EXPECT_THAT(json, HasSubstr("\"bp\":\"e\",\"ph\":\"f\""));
+  EXPECT_THAT(json, HasSubstr(
+    "\"cat\":\"make_flow\",\"ph\":\"i\",\"ts\":1.100"
+  ));
+  EXPECT_THAT(json, HasSubstr("\"flow_relationship\":8"));
+  EXPECT_THAT(json, HasSubstr("\"cat\":\"allreduce\""));
+  EXPECT_THAT(json, HasSubstr("\"index\":2"));
+  EXPECT_THAT(json, HasSubstr("\"tid\":1,\"args\":{\"name\":\"darma thread 1\"}"));
+
+}
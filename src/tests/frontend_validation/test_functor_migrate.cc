@@ -42,9 +42,12 @@
 //@HEADER
 */
 
+#include <vector>
+
 #include "test_functor.h"
 
 #include <darma/interface/frontend/unpack_task.h>
+#include <darma/serialization/serializers/standard_library/vector.h>
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -280,3 +283,84 @@ TEST_F_WITH_PARAMS(
 }
 
 ////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+struct CountedPayload {
+  static int n_serialize_calls;
+  std::vector<double> data;
+  template <typename ArchiveT>
+  void serialize(ArchiveT& ar) {
+    ++n_serialize_calls;
+    ar | data;
+  }
+};
+
+int CountedPayload::n_serialize_calls = 0;
+
+} // end anonymous namespace
+
+TEST_F(TestFunctor, migrate_lazy_unpacked_args) {
+  using namespace ::testing;
+  using namespace mock_backend;
+  using darma::serialization::PolymorphicSerializableObject;
+
+  mock_runtime->save_tasks = true;
+
+  static int n_runs = 0;
+  n_runs = 0;
+
+  struct ReadsPayload {
+    void operator()(CountedPayload const& payload, int size) const {
+      EXPECT_THAT(payload.data.size(), Eq(static_cast<size_t>(size)));
+      ++n_runs;
+    }
+  };
+
+  //============================================================================
+  // Code to actually be tested
+  {
+    CountedPayload payload;
+    payload.data.assign(1000, 3.14);
+    create_work<ReadsPayload>(std::move(payload), 1000);
+  }
+  //============================================================================
+
+  auto pack_task = [](auto& task) {
+    std::vector<char> buffer(task->get_packed_size());
+    char* spot = buffer.data();
+    task->pack(spot);
+    return buffer;
+  };
+
+  CountedPayload::n_serialize_calls = 0;
+
+  auto buffer = pack_task(mock_runtime->registered_tasks.front());
+  mock_runtime->registered_tasks.clear();
+  // size and pack
+  EXPECT_THAT(CountedPayload::n_serialize_calls, Eq(2));
+
+  char const* unpack_spot = buffer.data();
+  auto migrated_task = PolymorphicSerializableObject<
+    darma::abstract::frontend::Task
+  >::unpack(unpack_spot);
+  // nothing is deserialized until the task reads the argument
+  EXPECT_THAT(CountedPayload::n_serialize_calls, Eq(2));
+
+  // Migrating again without running just forwards the packed bytes
+  auto buffer_2 = pack_task(migrated_task);
+  migrated_task = nullptr;
+  EXPECT_THAT(CountedPayload::n_serialize_calls, Eq(2));
+  EXPECT_THAT(buffer_2, ContainerEq(buffer));
+
+  unpack_spot = buffer_2.data();
+  migrated_task = PolymorphicSerializableObject<
+    darma::abstract::frontend::Task
+  >::unpack(unpack_spot);
+  migrated_task->run();
+  // unpacked exactly once, on first access
+  EXPECT_THAT(CountedPayload::n_serialize_calls, Eq(3));
+  EXPECT_THAT(n_runs, Eq(1));
+
+  migrated_task = nullptr;
+}
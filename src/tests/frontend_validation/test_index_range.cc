@@ -49,6 +49,9 @@
 #include <darma/impl/index_range/range_1d.h>
 #include <darma/impl/index_range/mapping.h>
 #include <darma/impl/index_range/polymorphic_mapping.h>
+#include <darma/impl/index_range/partition_mappings.h>
+#include <darma/impl/index_range/sparse_range.h>
+#include <darma/impl/index_range/index_range_traits.h>
 
 using namespace darma;
 using namespace darma::detail;
@@ -79,3 +82,136 @@ TEST(TestIndexRange, pack_unpack_contiguous) {
 
 }
 
+
+TEST(TestIndexRange, block_mapping) {
+  using namespace ::testing;
+
+  auto mapping = make_block_mapping(Range1D<int>(10), Range1D<int>(4));
+
+  std::vector<int> tasks;
+  for(int i = 0; i < 10; ++i) {
+    tasks.push_back(mapping.map_forward(Index1D<int>{i, 0, 9}).value);
+  }
+  // the remainder goes to the first tasks, so the chunks are 3, 3, 2, 2
+  EXPECT_THAT(tasks, ElementsAre(0, 0, 0, 1, 1, 1, 2, 2, 3, 3));
+
+  std::vector<int> back;
+  for(int t = 0; t < 4; ++t) {
+    auto chunk = mapping.map_backward(Index1D<int>{t, 0, 3});
+    back.push_back(static_cast<int>(chunk.size()));
+    for(auto&& idx : chunk) {
+      EXPECT_THAT(mapping.map_forward(idx).value, Eq(t));
+    }
+  }
+  EXPECT_THAT(back, ElementsAre(3, 3, 2, 2));
+
+  // 9 over 4 doesn't leave the last task empty
+  auto mapping_9 = make_block_mapping(Range1D<int>(9), Range1D<int>(4));
+  std::vector<int> sizes_9;
+  for(int t = 0; t < 4; ++t) {
+    sizes_9.push_back(static_cast<int>(
+      mapping_9.map_backward(Index1D<int>{t, 0, 3}).size()
+    ));
+  }
+  EXPECT_THAT(sizes_9, ElementsAre(3, 2, 2, 2));
+
+  // Only a handle collection smaller than the task collection leaves tasks
+  // without any handle indices
+  auto mapping_small = make_block_mapping(Range1D<int>(2), Range1D<int>(4));
+  EXPECT_THAT(mapping_small.map_forward(Index1D<int>{1, 0, 1}).value, Eq(1));
+  EXPECT_THAT(mapping_small.map_backward(Index1D<int>{3, 0, 3}).size(), Eq(0));
+
+  EXPECT_TRUE(mapping.is_same(make_block_mapping(Range1D<int>(10), Range1D<int>(4))));
+  EXPECT_FALSE(mapping.is_same(mapping_9));
+
+  PolymorphicMapping<
+    Index1D<int>, Index1D<int>, std::vector<Index1D<int>>, Index1D<int>
+  > const& poly = mapping;
+  EXPECT_FALSE(poly.is_one_to_one());
+  EXPECT_TRUE(poly.is_many_to_one());
+}
+
+TEST(TestIndexRange, cyclic_and_block_cyclic_mapping) {
+  using namespace ::testing;
+
+  auto cyclic = make_cyclic_mapping(Range1D<int>(7), Range1D<int>(3));
+  auto block_cyclic = make_block_cyclic_mapping(
+    Range1D<int>(7), Range1D<int>(2), 2
+  );
+
+  std::vector<int> cyc_tasks, bc_tasks;
+  for(int i = 0; i < 7; ++i) {
+    cyc_tasks.push_back(cyclic.map_forward(Index1D<int>{i, 0, 6}).value);
+    bc_tasks.push_back(block_cyclic.map_forward(Index1D<int>{i, 0, 6}).value);
+  }
+  EXPECT_THAT(cyc_tasks, ElementsAre(0, 1, 2, 0, 1, 2, 0));
+  EXPECT_THAT(bc_tasks, ElementsAre(0, 0, 1, 1, 0, 0, 1));
+
+  std::vector<int> back;
+  for(auto&& idx : block_cyclic.map_backward(Index1D<int>{1, 0, 1})) {
+    back.push_back(idx.value);
+  }
+  EXPECT_THAT(back, ElementsAre(2, 3, 6));
+
+  EXPECT_TRUE(cyclic.is_same(make_cyclic_mapping(Range1D<int>(7), Range1D<int>(3))));
+  EXPECT_FALSE(cyclic.is_same(
+    make_block_cyclic_mapping(Range1D<int>(7), Range1D<int>(3), 3)
+  ));
+}
+
+TEST(TestIndexRange, weighted_partition_mapping) {
+  using namespace ::testing;
+
+  // one very expensive entry up front, followed by cheap ones
+  std::vector<double> costs = { 6.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0 };
+  auto mapping = make_weighted_partition_mapping(
+    Range1D<int>(7, 10), Range1D<int>(2), costs
+  );
+
+  std::vector<int> tasks;
+  for(int i = 10; i < 17; ++i) {
+    tasks.push_back(mapping.map_forward(Index1D<int>{i, 10, 16}).value);
+  }
+  EXPECT_THAT(tasks, ElementsAre(0, 1, 1, 1, 1, 1, 1));
+
+  std::vector<int> back;
+  for(auto&& idx : mapping.map_backward(Index1D<int>{1, 0, 1})) {
+    back.push_back(idx.value);
+  }
+  EXPECT_THAT(back, ElementsAre(11, 12, 13, 14, 15, 16));
+
+  // No task is left empty, even if the costs would suggest otherwise
+  auto skewed = make_weighted_partition_mapping(
+    Range1D<int>(4), Range1D<int>(3), std::vector<double>{ 0.0, 0.0, 0.0, 9.0 }
+  );
+  for(int t = 0; t < 3; ++t) {
+    EXPECT_THAT(skewed.map_backward(Index1D<int>{t, 0, 2}).size(), Ge(1));
+  }
+}
+
+TEST(TestIndexRange, sparse_range_mapping_to_dense) {
+  using namespace ::testing;
+
+  auto range = SparseRange1D<int>{ 100, 3, 42, 17, 42 };
+
+  static_assert(indexing::index_range_traits<SparseRange1D<int>>::is_index_range,
+    "SparseRange1D should satisfy the index range requirements"
+  );
+
+  ASSERT_THAT(range.size(), Eq(4));
+  EXPECT_THAT(std::vector<int>(range.begin(), range.end()), ElementsAre(3, 17, 42, 100));
+  EXPECT_TRUE(range.contains(42));
+  EXPECT_FALSE(range.contains(43));
+
+  auto mapping = get_mapping_to_dense(range);
+  for(std::size_t i = 0; i < range.size(); ++i) {
+    EXPECT_THAT(mapping.map_forward(mapping.map_backward(i)), Eq(i));
+  }
+  EXPECT_THAT(mapping.map_forward(42), Eq(2));
+  EXPECT_THAT(mapping.map_backward(3), Eq(100));
+
+  // copies share the index storage, so they are known to be the same mapping
+  auto range_copy = range;
+  EXPECT_TRUE(mapping.is_same(get_mapping_to_dense(range_copy)));
+  EXPECT_FALSE(mapping.is_same(get_mapping_to_dense(SparseRange1D<int>{ 3, 17 })));
+}
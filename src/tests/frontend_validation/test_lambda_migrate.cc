@@ -44,6 +44,8 @@
 
 #include <gtest/gtest.h>
 
+#include <vector>
+
 #include "mock_backend.h"
 #include "test_frontend.h"
 
@@ -77,6 +79,125 @@ class TestLambdaMigrate
 
 ////////////////////////////////////////////////////////////////////////////////
 
+namespace {
+
+struct CopyCountingValue {
+  static int n_copies;
+  int value = 0;
+  CopyCountingValue() = default;
+  explicit CopyCountingValue(int v) : value(v) { }
+  CopyCountingValue(CopyCountingValue const& other)
+    : value(other.value)
+  { ++n_copies; }
+};
+
+int CopyCountingValue::n_copies = 0;
+
+} // end anonymous namespace
+
+TEST_F(TestLambdaMigrate, pack_without_copying_closure) {
+  using namespace ::testing;
+  using namespace mock_backend;
+  using darma::serialization::PolymorphicSerializableObject;
+
+  mock_runtime->save_tasks = true;
+
+  int value_seen = 0;
+
+  //============================================================================
+  // Code to actually be tested
+  {
+    CopyCountingValue captured(42);
+    create_work([=, &value_seen]{ value_seen = captured.value; });
+  }
+  //============================================================================
+
+  auto& task_to_migrate = mock_runtime->registered_tasks.front();
+
+  CopyCountingValue::n_copies = 0;
+
+  // Sizing and packing shouldn't copy any of the captured values
+  std::vector<char> buffer(task_to_migrate->get_packed_size());
+  EXPECT_THAT(task_to_migrate->get_packed_size(), Eq(buffer.size()));
+  char* spot = buffer.data();
+  task_to_migrate->pack(spot);
+  EXPECT_THAT(CopyCountingValue::n_copies, Eq(0));
+
+  mock_runtime->registered_tasks.clear();
+
+  char const* unpack_spot = buffer.data();
+  auto migrated_task = PolymorphicSerializableObject<
+    darma::abstract::frontend::Task
+  >::unpack(unpack_spot);
+
+  migrated_task->run();
+  EXPECT_THAT(value_seen, Eq(42));
+
+  migrated_task = nullptr;
+}
+
+TEST_F(TestLambdaMigrate, pack_captured_handle_without_copying_closure) {
+  using namespace ::testing;
+  using namespace mock_backend;
+  using darma::serialization::PolymorphicSerializableObject;
+
+  mock_runtime->save_tasks = true;
+
+  int value = 0;
+  int value_seen = 0;
+
+  // The migrated use gets its data from here
+  ON_CALL(*mock_runtime, reregister_migrated_use(_))
+    .WillByDefault(Invoke([&](auto&& rereg_use) {
+      darma::abstract::frontend::use_cast<
+        darma::abstract::frontend::DependencyUse*
+      >(rereg_use)->get_data_pointer_reference() = &value;
+    }));
+
+  //============================================================================
+  // Code to actually be tested
+  {
+    auto h = initial_access<int>("migrated_handle");
+    CopyCountingValue captured(7);
+    create_work([=, &value_seen]{
+      value_seen = captured.value;
+      h.set_value(42);
+    });
+  }
+  //============================================================================
+
+  auto& task_to_migrate = mock_runtime->registered_tasks.front();
+  ASSERT_THAT(task_to_migrate->get_dependencies().size(), Eq(1));
+
+  CopyCountingValue::n_copies = 0;
+
+  // The handle is sized and packed from where it lives in the closure, so
+  // neither it nor the other captured values get copied
+  std::vector<char> buffer(task_to_migrate->get_packed_size());
+  char* spot = buffer.data();
+  task_to_migrate->pack(spot);
+  EXPECT_THAT(CopyCountingValue::n_copies, Eq(0));
+  EXPECT_THAT(size_t(spot - buffer.data()), Eq(buffer.size()));
+
+  mock_runtime->registered_tasks.clear();
+
+  char const* unpack_spot = buffer.data();
+  auto migrated_task = PolymorphicSerializableObject<
+    darma::abstract::frontend::Task
+  >::unpack(unpack_spot);
+
+  // The handle was unpacked and registered again on this side
+  EXPECT_THAT(migrated_task->get_dependencies().size(), Eq(1));
+
+  migrated_task->run();
+  EXPECT_THAT(value_seen, Eq(7));
+  EXPECT_THAT(value, Eq(42));
+
+  migrated_task = nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 #if 0 // TODO finish this!
 
 // Identical to test_functor migrate, but with a lambda instead
@@ -156,3 +156,116 @@ TEST_F(TestMPIInterop, baseline_test) {
 
 }
 
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST_F(TestMPIInterop, piece_span_registration) {
+  using namespace ::testing;
+  using namespace darma;
+  using namespace darma::keyword_arguments_for_mpi_context;
+
+  darma::backend::registered_piece_spans().clear();
+
+  // e.g., the blocks a partitioner assigned to this rank
+  std::vector<double> blocks = { 1.0, 2.0, 3.0, 4.0, 5.0 };
+  std::vector<std::pair<size_t, double*>> local_pieces;
+  for(size_t i = 0; i < blocks.size(); ++i) {
+    local_pieces.emplace_back(2*i, &blocks[i]);
+  }
+
+  //============================================================================
+  // Actual code being tested
+  {
+    auto context = mpi_context(types::MPI_Comm{});
+
+    auto copied = context.piecewise_acquired_collection<double>("copied",
+      size = 10, pieces = local_pieces,
+      copy_callback = [](void const* src, void* dst) {
+        *static_cast<double*>(dst) = *static_cast<double const*>(src);
+      }
+    );
+    auto aliased = context.piecewise_acquired_collection<double>("aliased",
+      index_range = Range1D<int>(10), pieces = local_pieces, zero_copy = true
+    );
+  }
+  //============================================================================
+
+  auto const& spans = darma::backend::registered_piece_spans();
+  // one backend call per collection, regardless of the number of pieces
+  ASSERT_THAT(spans.size(), Eq(2));
+
+  for(auto const& span : spans) {
+    ASSERT_THAT(span.pieces.size(), Eq(local_pieces.size()));
+    for(size_t i = 0; i < local_pieces.size(); ++i) {
+      EXPECT_THAT(span.pieces[i].index, Eq(local_pieces[i].first));
+      EXPECT_THAT(span.pieces[i].data, Eq((void*)local_pieces[i].second));
+    }
+  }
+
+  EXPECT_FALSE(spans[0].zero_copy);
+  EXPECT_TRUE(spans[0].has_callbacks);
+  EXPECT_TRUE(spans[1].zero_copy);
+  EXPECT_FALSE(spans[1].has_callbacks);
+
+  darma::backend::registered_piece_spans().clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST_F(TestMPIInterop, aliased_collections) {
+  using namespace ::testing;
+  using namespace darma;
+  using namespace darma::keyword_arguments_for_mpi_context;
+
+  darma::backend::registered_piece_spans().clear();
+  darma::backend::aliased_persistent_collections().clear();
+
+  std::vector<double> blocks = { 1.0, 2.0, 3.0 };
+  std::vector<std::pair<int, double*>> local_pieces = {
+    { 4, &blocks[0] }, { 5, &blocks[1] }, { 9, &blocks[2] }
+  };
+
+  //============================================================================
+  // Actual code being tested
+  {
+    auto context = mpi_context(types::MPI_Comm{});
+
+    auto persistent = context.persistent_collection<double>("persistent",
+      size = 10, pieces = local_pieces
+    );
+    EXPECT_TRUE(persistent.aliases_mpi_data());
+
+    auto not_aliased = context.persistent_collection<double>("not_aliased",
+      index_range = Range1D<int>(10)
+    );
+    EXPECT_FALSE(not_aliased.aliases_mpi_data());
+
+    auto piecewise = context.piecewise_acquired_collection<double>("piecewise",
+      size = 10
+    );
+    piecewise.acquire_access(blocks[1],
+      darma::keyword_arguments_for_piecewise_handle::index = 5,
+      darma::keyword_arguments_for_piecewise_handle::zero_copy = true
+    );
+  }
+  //============================================================================
+
+  auto const& aliased = darma::backend::aliased_persistent_collections();
+  ASSERT_THAT(aliased.size(), Eq(1));
+  ASSERT_THAT(aliased[0].pieces.size(), Eq(local_pieces.size()));
+  for(size_t i = 0; i < local_pieces.size(); ++i) {
+    EXPECT_THAT(aliased[0].pieces[i].index, Eq(size_t(local_pieces[i].first)));
+    EXPECT_THAT(aliased[0].pieces[i].data, Eq((void*)local_pieces[i].second));
+  }
+
+  auto const& acquired = darma::backend::registered_piece_spans();
+  ASSERT_THAT(acquired.size(), Eq(1));
+  EXPECT_TRUE(acquired[0].zero_copy);
+  EXPECT_FALSE(acquired[0].has_callbacks);
+  ASSERT_THAT(acquired[0].pieces.size(), Eq(1));
+  EXPECT_THAT(acquired[0].pieces[0].index, Eq(5));
+  EXPECT_THAT(acquired[0].pieces[0].data, Eq((void*)&blocks[1]));
+
+  darma::backend::registered_piece_spans().clear();
+  darma::backend::aliased_persistent_collections().clear();
+}
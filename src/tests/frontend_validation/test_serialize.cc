@@ -42,6 +42,12 @@
 //@HEADER
 */
 
+#include <cmath>
+#include <cstring>
+#include <deque>
+#include <numeric>
+#include <type_traits>
+#include <utility>
 #include <vector>
 #include <map>
 #include <unordered_map>
@@ -51,6 +57,8 @@
 
 #include <darma/serialization/nonintrusive.h>
 #include <darma/impl/handle.h>
+#include <darma/impl/serialization/manager.h>
+#include <darma/impl/serialization/compression.h>
 
 #include "mock_backend.h"
 
@@ -428,3 +436,372 @@ class TestSerialize
 //  ASSERT_THAT(*(out2-5), Eq(out[0]));
 //
 //}
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+// Simulates a backend that passes contiguous payloads by reference (e.g., by
+// registering them for RDMA) rather than copying them into the pack buffer
+struct ZeroCopyCountingPolicy
+  : darma::abstract::backend::SerializationPolicy
+{
+  mutable std::deque<std::pair<void const*, std::size_t>> blobs;
+  mutable std::size_t bytes_not_copied = 0;
+
+  std::size_t
+  packed_size_contribution_for_blob(
+    void const* data_begin, std::size_t n_bytes
+  ) const override {
+    return 0;
+  }
+
+  void
+  pack_blob(
+    void*& indirect_pack_buffer, void const* data_begin, std::size_t n_bytes
+  ) const override {
+    blobs.emplace_back(data_begin, n_bytes);
+    bytes_not_copied += n_bytes;
+  }
+
+  void
+  unpack_blob(
+    void*& indirect_packed_buffer, void* dest, std::size_t n_bytes
+  ) const override {
+    EXPECT_EQ(blobs.front().second, n_bytes);
+    std::memcpy(dest, blobs.front().first, n_bytes);
+    blobs.pop_front();
+  }
+};
+
+} // end anonymous namespace
+
+TEST_F(TestSerialize, policy_blob_vector) {
+  using namespace ::testing;
+  using darma::serialization::detail::SerializationManagerForType;
+  using vector_t = std::vector<double>;
+
+  vector_t value(1000);
+  std::iota(value.begin(), value.end(), 0.5);
+
+  SerializationManagerForType<vector_t> manager;
+  std::aligned_storage_t<sizeof(vector_t), alignof(vector_t)> unpacked;
+
+  {
+    // The default policy still copies
+    darma::abstract::backend::SerializationPolicy default_policy;
+    auto size = manager.get_packed_data_size(&value, &default_policy);
+    ASSERT_THAT(size, Eq(sizeof(std::size_t) + 1000*sizeof(double)));
+
+    std::vector<char> buffer(size);
+    manager.pack_data(&value, buffer.data(), &default_policy);
+    manager.unpack_data(&unpacked, buffer.data(), &default_policy);
+
+    auto* value2 = reinterpret_cast<vector_t*>(&unpacked);
+    EXPECT_THAT(*value2, ContainerEq(value));
+    manager.destroy(value2);
+  }
+
+  {
+    ZeroCopyCountingPolicy zero_copy;
+    auto size = manager.get_packed_data_size(&value, &zero_copy);
+    // Only the element count goes in the buffer
+    ASSERT_THAT(size, Eq(sizeof(std::size_t)));
+
+    std::vector<char> buffer(size);
+    manager.pack_data(&value, buffer.data(), &zero_copy);
+    EXPECT_THAT(zero_copy.bytes_not_copied, Eq(1000*sizeof(double)));
+
+    manager.unpack_data(&unpacked, buffer.data(), &zero_copy);
+
+    auto* value2 = reinterpret_cast<vector_t*>(&unpacked);
+    EXPECT_THAT(*value2, ContainerEq(value));
+    EXPECT_THAT(zero_copy.blobs, IsEmpty());
+    manager.destroy(value2);
+  }
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+template <typename Tag>
+struct CountedTable {
+  static int n_serialize_calls;
+  std::map<int, std::vector<double>> rows;
+  template <typename ArchiveT>
+  void serialize(ArchiveT& ar) {
+    ++n_serialize_calls;
+    ar | rows;
+  }
+};
+
+template <typename Tag>
+int CountedTable<Tag>::n_serialize_calls = 0;
+
+struct invariant_tag { };
+struct variable_tag { };
+
+using InvariantTable = CountedTable<invariant_tag>;
+using VariableTable = CountedTable<variable_tag>;
+
+struct VectorPackBufferAllocator
+  : darma::abstract::backend::PackBufferAllocator
+{
+  std::vector<char> buffer;
+  int n_allocations = 0;
+  void* allocate(std::size_t n_bytes) override {
+    ++n_allocations;
+    buffer.resize(n_bytes);
+    return buffer.data();
+  }
+};
+
+} // end anonymous namespace
+
+namespace darma {
+namespace serialization {
+
+template <>
+struct packed_size_is_invariant<InvariantTable> : std::true_type { };
+
+} // end namespace serialization
+} // end namespace darma
+
+TEST_F(TestSerialize, pack_with_allocator_cached_size) {
+  using namespace ::testing;
+  using darma::serialization::detail::SerializationManagerForType;
+
+  auto fill = [](auto& table) {
+    for(int i = 0; i < 10; ++i) table.rows[i].assign(i + 1, 0.5 * i);
+  };
+
+  InvariantTable invariant;
+  fill(invariant);
+  VariableTable variable;
+  fill(variable);
+
+  SerializationManagerForType<InvariantTable> invariant_manager;
+  SerializationManagerForType<VariableTable> variable_manager;
+
+  EXPECT_TRUE(invariant_manager.packed_size_is_invariant());
+  EXPECT_FALSE(variable_manager.packed_size_is_invariant());
+
+  // The backend keeps the size from the first pack of the invariant object
+  VectorPackBufferAllocator alloc_1, alloc_2;
+  auto size_1 = invariant_manager.pack_data_with_allocator(
+    &invariant, alloc_1, nullptr, 0
+  );
+  auto size_2 = invariant_manager.pack_data_with_allocator(
+    &invariant, alloc_2, nullptr, size_1
+  );
+  variable_manager.pack_data_with_allocator(&variable, alloc_1, nullptr, 0);
+  variable_manager.pack_data_with_allocator(&variable, alloc_2, nullptr, 0);
+
+  EXPECT_THAT(size_1, Eq(size_2));
+  EXPECT_THAT(size_1, Eq(invariant_manager.get_packed_data_size(
+    &invariant, nullptr
+  )));
+  EXPECT_THAT(alloc_1.buffer.size(), Eq(size_1));
+  EXPECT_THAT(alloc_1.n_allocations, Eq(2));
+  // size once, then pack twice (plus the get_packed_data_size() above)
+  EXPECT_THAT(InvariantTable::n_serialize_calls, Eq(4));
+  // size and pack, twice
+  EXPECT_THAT(VariableTable::n_serialize_calls, Eq(4));
+
+  std::aligned_storage_t<sizeof(InvariantTable), alignof(InvariantTable)>
+    unpacked;
+  invariant_manager.unpack_data(&unpacked, alloc_2.buffer.data(), nullptr);
+  auto* invariant2 = reinterpret_cast<InvariantTable*>(&unpacked);
+  EXPECT_THAT(invariant2->rows, ContainerEq(invariant.rows));
+  invariant_manager.destroy(invariant2);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace darma {
+namespace serialization {
+
+template <>
+struct compressed_packing_mode<std::vector<float>>
+  : std::integral_constant<CompressionMode, CompressionMode::FloatDeltaLZ>
+{ };
+
+} // end namespace serialization
+} // end namespace darma
+
+TEST_F(TestSerialize, lz_codec_round_trip) {
+  using namespace ::testing;
+  using namespace darma::serialization::detail;
+
+  std::vector<char> repetitive;
+  for(int i = 0; i < 2000; ++i) repetitive.push_back("abcabcabd"[i % 9]);
+  std::vector<char> noisy(1500);
+  unsigned state = 12345;
+  for(auto& c : noisy) { state = state * 1103515245u + 12345u; c = char(state >> 16); }
+
+  for(auto const* input : { &repetitive, &noisy }) {
+    for(size_t n : { size_t(0), size_t(3), size_t(17), input->size() }) {
+      std::vector<char> compressed;
+      lz_compress(input->data(), n, compressed);
+      std::vector<char> output(n);
+      lz_decompress(compressed.data(), compressed.size(), output.data(), n);
+      EXPECT_TRUE(std::equal(output.begin(), output.end(), input->begin()));
+    }
+  }
+
+  std::vector<char> compressed;
+  lz_compress(repetitive.data(), repetitive.size(), compressed);
+  EXPECT_THAT(compressed.size(), Lt(repetitive.size() / 10));
+}
+
+TEST_F(TestSerialize, compressing_policy_vector) {
+  using namespace ::testing;
+  using darma::serialization::detail::SerializationManagerForType;
+  using darma::serialization::CompressingSerializationPolicy;
+  using darma::serialization::CompressionMode;
+  using vector_t = std::vector<double>;
+
+  // A smooth field
+  vector_t value(4096);
+  for(size_t i = 0; i < value.size(); ++i) value[i] = std::sin(1e-3 * i);
+
+  SerializationManagerForType<vector_t> manager;
+  std::aligned_storage_t<sizeof(vector_t), alignof(vector_t)> unpacked;
+
+  for(auto mode : { CompressionMode::LZ, CompressionMode::DoubleDeltaLZ }) {
+    CompressingSerializationPolicy policy(mode);
+    auto size = manager.get_packed_data_size(&value, &policy);
+    // only the compression done for packing is timed
+    EXPECT_THAT(policy.stats().compress_seconds, Eq(0.0));
+    std::vector<char> buffer(size);
+    manager.pack_data(&value, buffer.data(), &policy);
+    manager.unpack_data(&unpacked, buffer.data(), &policy);
+
+    auto* value2 = reinterpret_cast<vector_t*>(&unpacked);
+    EXPECT_THAT(*value2, ContainerEq(value));
+    manager.destroy(value2);
+
+    auto stats = policy.stats();
+    EXPECT_THAT(stats.n_blobs_packed, Eq(1));
+    EXPECT_THAT(stats.n_blobs_unpacked, Eq(1));
+    EXPECT_THAT(stats.bytes_in, Eq(value.size() * sizeof(double)));
+    EXPECT_THAT(stats.bytes_out + sizeof(size_t), Eq(size));
+    if(mode == CompressionMode::DoubleDeltaLZ) {
+      EXPECT_THAT(stats.ratio(), Gt(1.0));
+    }
+  }
+}
+
+TEST_F(TestSerialize, compressed_packing_mode_trait) {
+  using namespace ::testing;
+  using darma::serialization::detail::SerializationManagerForType;
+  using vector_t = std::vector<float>;
+
+  vector_t value(4096);
+  for(size_t i = 0; i < value.size(); ++i) value[i] = float(i) * 0.25f;
+
+  SerializationManagerForType<vector_t> manager;
+  std::aligned_storage_t<sizeof(vector_t), alignof(vector_t)> unpacked;
+
+  auto const& policy = manager.default_compression_policy();
+
+  // No policy from the backend, so the type's policy is used
+  auto size = manager.get_packed_data_size(&value, nullptr);
+  EXPECT_THAT(size, Lt(value.size() * sizeof(float)));
+  std::vector<char> buffer(size);
+  manager.pack_data(&value, buffer.data(), nullptr);
+  manager.unpack_data(&unpacked, buffer.data(), nullptr);
+
+  auto* value2 = reinterpret_cast<vector_t*>(&unpacked);
+  EXPECT_THAT(*value2, ContainerEq(value));
+  manager.destroy(value2);
+
+  EXPECT_THAT(policy.stats().n_blobs_packed, Eq(1));
+  EXPECT_THAT(policy.stats().ratio(), Gt(1.0));
+
+  // Packing with an allocator compresses once and matches the two-call result
+  VectorPackBufferAllocator allocator;
+  EXPECT_THAT(
+    manager.pack_data_with_allocator(&value, allocator, nullptr, 0), Eq(size)
+  );
+  EXPECT_THAT(allocator.buffer, ContainerEq(buffer));
+  EXPECT_THAT(policy.stats().n_blobs_packed, Eq(2));
+
+  // Sizing alone leaves nothing behind, so a changed value packs correctly
+  manager.get_packed_data_size(&value, nullptr);
+  value[0] = 42.0f;
+  size = manager.get_packed_data_size(&value, nullptr);
+  buffer.assign(size, 0);
+  manager.pack_data(&value, buffer.data(), nullptr);
+  manager.unpack_data(&unpacked, buffer.data(), nullptr);
+  value2 = reinterpret_cast<vector_t*>(&unpacked);
+  EXPECT_THAT(*value2, ContainerEq(value));
+  manager.destroy(value2);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+struct ArenaMessage {
+  template <typename T>
+  using arena_vector = std::vector<T, darma::serialization::ArenaAllocator<T>>;
+
+  arena_vector<double> values;
+  arena_vector<int> indices;
+
+  template <typename ArchiveT>
+  void serialize(ArchiveT& ar) { ar | values | indices; }
+};
+
+struct CountingUnpackArena
+  : darma::serialization::MonotonicUnpackArena
+{
+  using MonotonicUnpackArena::MonotonicUnpackArena;
+
+  void* allocate(size_t n_bytes, size_t alignment) override {
+    ++n_allocations;
+    return MonotonicUnpackArena::allocate(n_bytes, alignment);
+  }
+
+  size_t n_allocations = 0;
+};
+
+} // end anonymous namespace
+
+TEST_F(TestSerialize, unpack_into_arena) {
+  using namespace ::testing;
+  using darma::serialization::detail::SerializationManagerForType;
+
+  ArenaMessage message;
+  message.values.assign(100, 1.5);
+  for(int i = 0; i < 50; ++i) message.indices.push_back(i * i);
+  // outside of an unpack, the heap is used
+  EXPECT_THAT(message.values.get_allocator().arena(), IsNull());
+
+  SerializationManagerForType<ArenaMessage> manager;
+  std::vector<char> buffer(manager.get_packed_data_size(&message, nullptr));
+  manager.pack_data(&message, buffer.data(), nullptr);
+
+  CountingUnpackArena arena(1 << 16);
+  std::aligned_storage_t<sizeof(ArenaMessage), alignof(ArenaMessage)> unpacked;
+  manager.unpack_data_into_arena(&unpacked, buffer.data(), nullptr, arena);
+  auto* message2 = reinterpret_cast<ArenaMessage*>(&unpacked);
+
+  EXPECT_THAT(message2->values, ContainerEq(message.values));
+  EXPECT_THAT(message2->indices, ContainerEq(message.indices));
+  EXPECT_THAT(message2->values.get_allocator().arena(), Eq(&arena));
+  EXPECT_THAT(message2->indices.get_allocator().arena(), Eq(&arena));
+  // all of the container storage came from one chunk of the arena
+  EXPECT_THAT(arena.n_allocations, Ge(2));
+  EXPECT_THAT(arena.n_chunks(), Eq(1));
+
+  // copies don't stay tied to the arena
+  auto values_copy = message2->values;
+  EXPECT_THAT(values_copy.get_allocator().arena(), IsNull());
+  EXPECT_THAT(values_copy, ContainerEq(message.values));
+
+  manager.destroy(message2);
+}
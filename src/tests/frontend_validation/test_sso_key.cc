@@ -104,6 +104,39 @@ TEST_F(TestSSOKey, sso_int) {
   ASSERT_EQ(k.component(2).as<int>(), 8);
 }
 
+TEST_F(TestSSOKey, sso_int_fast_path) {
+  using namespace darma::detail;
+  using attorney = darma::detail::_impl::SSOKeyAttorney;
+  auto maker = typename key_traits<sso_key_t>::maker{};
+
+  static_assert(
+    _impl::use_integer_key_fast_path<int, long, short const&, size_t>::value
+      == _impl::integer_key_fast_path_enabled,
+    "all-integer keys should use the fast path when it's available"
+  );
+
+  sso_key_t k = maker(2, -300L, short(-7), size_t(1ull << 40));
+  ASSERT_EQ(k.component<0>().as<int>(), 2);
+  ASSERT_EQ(k.component<1>().as<long>(), -300);
+  ASSERT_EQ(k.component<2>().as<int>(), -7);
+  ASSERT_EQ(k.component<3>().as<size_t>(), 1ull << 40);
+
+  long long values[4];
+  k.integer_components(values);
+  ASSERT_THAT(values, ::testing::ElementsAre(2, -300, -7, 1ll << 40));
+
+  // count, then (size, metadata, value) for 1, 2, 1, and 8 byte values
+  ASSERT_EQ(attorney::get_data_size(k), 1 + 4 * 2 + (1 + 2 + 1 + 8));
+
+  // The encoding is identical to the general (mixed component) path
+  sso_key_t k_mixed = maker(2, -300L, short(-7), size_t(1ull << 40), "A");
+  ASSERT_EQ(0, ::memcmp(
+    attorney::get_data_pointer(k) + 1,
+    attorney::get_data_pointer(k_mixed) + 1,
+    attorney::get_data_size(k) - 1
+  ));
+}
+
 TEST_F(TestSSOKey, simple_string) {
   using namespace darma::detail;
   auto maker = typename key_traits<sso_key_t>::maker{};
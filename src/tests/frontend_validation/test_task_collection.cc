@@ -59,7 +59,10 @@
 #include <darma/impl/task_collection/access_handle_collection.h>
 #include <darma/impl/index_range/mapping.h>
 #include <darma/impl/array/index_range.h>
+#include <darma/impl/index_range/sparse_range.h>
+#include <darma/impl/index_range/partition_mappings.h>
 #include <darma/impl/task_collection/create_concurrent_work.h>
+#include <darma/interface/app/task_affinity.h>
 
 #include <darma/impl/access_handle/access_handle_collection.impl.h>
 
@@ -233,6 +236,245 @@ TEST_F_WITH_PARAMS(TestCreateConcurrentWork, simple, ::testing::Bool(), bool) {
 
 ////////////////////////////////////////////////////////////////////////////////
 
+TEST_F(TestCreateConcurrentWork, simple_sparse_range) {
+
+  using namespace ::testing;
+  using namespace darma;
+  using namespace darma::keyword_arguments_for_task_creation;
+  using namespace darma::keyword_arguments_for_access_handle_collection;
+  using namespace mock_backend;
+
+  mock_runtime->save_tasks = true;
+
+  DECLARE_MOCK_FLOWS(finit, fnull, fout_coll);
+  MockFlow f_in_idx[3], f_out_idx[3];
+  use_t* use_idx[3];
+  use_t* use_init = nullptr;
+  use_t* use_coll = nullptr, *use_coll_cont = nullptr;
+  int values[3];
+  int const occupied[3] = { 7, 512, 90000 };
+
+  EXPECT_INITIAL_ACCESS_COLLECTION(finit, fnull, use_init, make_key("hello"), 3);
+
+  EXPECT_CALL(*mock_runtime, make_next_flow_collection(finit))
+    .WillOnce(Return(fout_coll));
+
+  EXPECT_REGISTER_USE_COLLECTION(use_coll, finit, fout_coll, Modify, Modify, 3);
+  EXPECT_REGISTER_USE_COLLECTION(use_coll_cont, fout_coll, fnull, Modify, None, 3);
+
+  EXPECT_RELEASE_USE(use_init);
+  EXPECT_RELEASE_USE(use_coll_cont);
+  EXPECT_FLOW_ALIAS(fout_coll, fnull);
+
+  //============================================================================
+  // actual code being tested
+  {
+
+    auto blocks = SparseRange1D<int>{ 90000, 7, 512 };
+
+    auto tmp_c = initial_access_collection<int>("hello", index_range=blocks);
+
+    struct Foo {
+      void operator()(int index,
+        AccessHandleCollection<int, SparseRange1D<int>> coll
+      ) const {
+        coll[index].local_access().set_value(index);
+      }
+    };
+
+    create_concurrent_work<Foo>(tmp_c, index_range=blocks);
+
+  }
+  //============================================================================
+
+  Mock::VerifyAndClearExpectations(mock_runtime.get());
+
+  ASSERT_THAT(mock_runtime->task_collections.front()->size(), Eq(3));
+
+  for(int i = 0; i < 3; ++i) {
+    values[i] = 0;
+
+    EXPECT_CALL(*mock_runtime, make_indexed_local_flow(finit, i))
+      .WillOnce(Return(f_in_idx[i]));
+    EXPECT_CALL(*mock_runtime, make_indexed_local_flow(fout_coll, i))
+      .WillOnce(Return(f_out_idx[i]));
+    EXPECT_REGISTER_USE_AND_SET_BUFFER(use_idx[i], f_in_idx[i], f_out_idx[i],
+      Modify, Modify, values[i]);
+
+    auto created_task = mock_runtime->task_collections.front()->create_task_for_index(i);
+
+    EXPECT_THAT(created_task.get(), UseInGetDependencies(use_idx[i]));
+
+    created_task->run();
+
+    EXPECT_RELEASE_USE(use_idx[i]);
+
+    created_task = nullptr;
+
+    Mock::VerifyAndClearExpectations(mock_runtime.get());
+
+    EXPECT_THAT(values[i], Eq(occupied[i]));
+
+  }
+
+  EXPECT_RELEASE_USE(use_coll);
+
+  mock_runtime->task_collections.front().reset(nullptr);
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST_F(TestCreateConcurrentWork, context_shares_collection_range) {
+
+  using namespace ::testing;
+  using namespace darma;
+  using namespace darma::keyword_arguments_for_task_creation;
+  using namespace darma::keyword_arguments_for_access_handle_collection;
+  using namespace mock_backend;
+
+  mock_runtime->save_tasks = true;
+
+  DECLARE_MOCK_FLOWS(finit, fnull, fout_coll);
+  MockFlow f_in_idx[4], f_out_idx[4];
+  use_t* use_idx[4];
+  use_t* use_init = nullptr;
+  use_t* use_coll = nullptr, *use_coll_cont = nullptr;
+  int values[4];
+
+  EXPECT_INITIAL_ACCESS_COLLECTION(finit, fnull, use_init, make_key("hello"), 4);
+
+  EXPECT_CALL(*mock_runtime, make_next_flow_collection(finit))
+    .WillOnce(Return(fout_coll));
+
+  EXPECT_REGISTER_USE_COLLECTION(use_coll, finit, fout_coll, Modify, Modify, 4);
+  EXPECT_REGISTER_USE_COLLECTION(use_coll_cont, fout_coll, fnull, Modify, None, 4);
+
+  EXPECT_RELEASE_USE(use_init);
+  EXPECT_RELEASE_USE(use_coll_cont);
+  EXPECT_FLOW_ALIAS(fout_coll, fnull);
+
+  //============================================================================
+  // actual code being tested
+  {
+
+    auto tmp_c = initial_access_collection<int>("hello",
+      index_range=Range1D<int>(4)
+    );
+
+    struct Foo {
+      void operator()(ConcurrentContext<Range1D<int>> context,
+        AccessHandleCollection<int, Range1D<int>> coll
+      ) const {
+        ASSERT_THAT(context.index_range().size(), Eq(4));
+        ASSERT_THAT(context.index_count(), Eq(4));
+        coll[context.index()].local_access().set_value(
+          context.index().value + 10
+        );
+      }
+    };
+
+    create_concurrent_work<Foo>(tmp_c, index_range=Range1D<int>(4));
+
+  }
+  //============================================================================
+
+  Mock::VerifyAndClearExpectations(mock_runtime.get());
+
+  std::unique_ptr<darma::types::task_collection_task_t> created_tasks[4];
+
+  for(int i = 0; i < 4; ++i) {
+    values[i] = 0;
+
+    EXPECT_CALL(*mock_runtime, make_indexed_local_flow(finit, i))
+      .WillOnce(Return(f_in_idx[i]));
+    EXPECT_CALL(*mock_runtime, make_indexed_local_flow(fout_coll, i))
+      .WillOnce(Return(f_out_idx[i]));
+    EXPECT_REGISTER_USE_AND_SET_BUFFER(use_idx[i], f_in_idx[i], f_out_idx[i],
+      Modify, Modify, values[i]);
+
+    created_tasks[i] = mock_runtime->task_collections.front()->create_task_for_index(i);
+  }
+
+  Mock::VerifyAndClearExpectations(mock_runtime.get());
+
+  // The tasks share the collection's range and mapping, so they must still be
+  // runnable after the backend has destroyed the collection
+  EXPECT_RELEASE_USE(use_coll);
+
+  mock_runtime->task_collections.front().reset(nullptr);
+
+  Mock::VerifyAndClearExpectations(mock_runtime.get());
+
+  for(int i = 0; i < 4; ++i) {
+    EXPECT_RELEASE_USE(use_idx[i]);
+
+    created_tasks[i]->run();
+    created_tasks[i] = nullptr;
+
+    Mock::VerifyAndClearExpectations(mock_runtime.get());
+
+    EXPECT_THAT(values[i], Eq(i + 10));
+  }
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST_F(TestCreateConcurrentWork, affinity_hint) {
+
+  using namespace ::testing;
+  using namespace darma;
+  using namespace darma::keyword_arguments_for_create_concurrent_work;
+  using namespace mock_backend;
+
+  mock_runtime->save_tasks = true;
+
+  static int n_run = 0;
+  n_run = 0;
+
+  //============================================================================
+  // actual code being tested
+  {
+    struct Foo {
+      void operator()(ConcurrentContext<Range1D<int>> context) const {
+        ++n_run;
+      }
+    };
+
+    create_concurrent_work<Foo>(
+      index_range=Range1D<int>(4), affinity=on_socket(1)
+    );
+  }
+  //============================================================================
+
+  ASSERT_THAT(mock_runtime->task_collections.size(), Eq(1));
+
+  auto& coll = mock_runtime->task_collections.front();
+  EXPECT_THAT(coll->get_affinity().kind(),
+    Eq(abstract::frontend::TaskAffinity::Kind::Socket)
+  );
+  EXPECT_THAT(coll->get_affinity().socket_index(), Eq(1));
+
+  for(int i = 0; i < 4; ++i) {
+    auto task = coll->create_task_for_index(i);
+    // every task in the collection carries the collection's hint
+    EXPECT_THAT(task->get_affinity().kind(),
+      Eq(abstract::frontend::TaskAffinity::Kind::Socket)
+    );
+    EXPECT_THAT(task->get_affinity().socket_index(), Eq(1));
+    task->run();
+  }
+
+  EXPECT_THAT(n_run, Eq(4));
+
+  mock_runtime->task_collections.front().reset(nullptr);
+  mock_runtime->task_collections.pop_front();
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 TEST_F(TestCreateConcurrentWork, simple_all_reduce) {
 
   using namespace ::testing;
@@ -366,6 +608,149 @@ TEST_F(TestCreateConcurrentWork, simple_all_reduce) {
 
 ////////////////////////////////////////////////////////////////////////////////
 
+TEST_F(TestCreateConcurrentWork, all_reduce_local_combining) {
+
+  using namespace ::testing;
+  using namespace darma;
+  using namespace darma::keyword_arguments_for_publication;
+  using namespace darma::keyword_arguments_for_task_creation;
+  using namespace darma::keyword_arguments_for_access_handle_collection;
+  using namespace mock_backend;
+  using darma::frontend::Permissions;
+
+  mock_runtime->save_tasks = true;
+
+  DECLARE_MOCK_FLOWS(finit, fnull, fout_coll);
+  MockFlow f_in_idx[4], f_out_idx[4];
+  MockFlow f_fwd_allred[4] = { "f_fwd_allred[0]", "f_fwd_allred[1]", "f_fwd_allred[2]", "f_fwd_allred[3]"};
+  MockFlow f_allred_out[4] = { "f_allred_out[0]", "f_allred_out[1]", "f_allred_out[2]", "f_allred_out[3]"};
+  use_t* use_idx[4] = {nullptr, nullptr, nullptr, nullptr};
+  use_t* use_allred[4] = {nullptr, nullptr, nullptr, nullptr};
+  use_t* use_allred_cont[4] = {nullptr, nullptr, nullptr, nullptr};
+  use_t* use_coll = nullptr;
+  use_t* use_cont = nullptr;
+  use_t* use_init = nullptr;
+  int values[4];
+
+  EXPECT_INITIAL_ACCESS_COLLECTION(finit, fnull, use_init, make_key("hello"), 4);
+
+  EXPECT_CALL(*mock_runtime, make_next_flow_collection(finit))
+    .WillOnce(Return(fout_coll));
+
+  EXPECT_REGISTER_USE_COLLECTION(use_coll, finit, fout_coll, Modify, Modify, 4);
+  EXPECT_REGISTER_USE_COLLECTION(use_cont, fout_coll, fnull, Modify, None, 4);
+  EXPECT_RELEASE_USE(use_init);
+
+  EXPECT_CALL(*mock_runtime, register_task_collection_gmock_proxy(_));
+
+  EXPECT_FLOW_ALIAS(fout_coll, fnull);
+  EXPECT_RELEASE_USE(use_cont);
+
+  //============================================================================
+  // actual code being tested
+  {
+
+    auto tmp_c = initial_access_collection<int>("hello", index_range=Range1D<int>(4));
+
+
+    struct Foo {
+      void operator()(
+        ConcurrentContext<Index1D<int>> context,
+        AccessHandleCollection<int, Range1D<int>> coll
+      ) const {
+        ASSERT_THAT(context.index().value, Lt(4));
+        ASSERT_THAT(context.index().value, Ge(0));
+        auto mine = coll[context.index()].local_access();
+        mine.set_value(42);
+        context.allreduce(mine);
+      }
+    };
+
+    create_concurrent_work<Foo>(tmp_c,
+      index_range=Range1D<int>(4)
+    );
+
+  }
+  //============================================================================
+
+  Mock::VerifyAndClearExpectations(mock_runtime.get());
+
+  // Pretend all four tasks will run in this process
+  mock_runtime->task_collections.front()->set_local_task_count(4);
+
+#if _darma_has_feature(task_collection_token)
+  mock_runtime->task_collections.front()->set_task_collection_token(MockTaskCollectionToken("my_token_2"));
+#endif // _darma_has_feature(task_collection_token)
+
+  auto const n_owned_before = mock_runtime->backend_owned_uses.size();
+
+  for(int i = 0; i < 4; ++i) {
+    values[i] = 0;
+
+    EXPECT_CALL(*mock_runtime, make_indexed_local_flow(finit, i))
+      .WillOnce(Return(f_in_idx[i]));
+    EXPECT_CALL(*mock_runtime, make_indexed_local_flow(fout_coll, i))
+      .WillOnce(Return(f_out_idx[i]));
+
+    EXPECT_REGISTER_USE_AND_SET_BUFFER(use_idx[i], f_in_idx[i], f_out_idx[i], Modify, Modify, values[i]);
+
+    auto created_task = mock_runtime->task_collections.front()->create_task_for_index(i);
+
+    EXPECT_THAT(created_task.get(), UseInGetDependencies(use_idx[i]));
+
+    EXPECT_CALL(*mock_runtime, make_forwarding_flow(f_in_idx[i]))
+      .WillOnce(Return(f_fwd_allred[i]));
+    EXPECT_CALL(*mock_runtime, make_next_flow(f_fwd_allred[i]))
+      .WillOnce(Return(f_allred_out[i]));
+    EXPECT_REGISTER_USE(use_allred[i], f_fwd_allred[i], f_allred_out[i], None, Modify);
+    EXPECT_REGISTER_USE(use_allred_cont[i], f_allred_out[i], f_out_idx[i], Modify, None);
+
+    EXPECT_RELEASE_USE(use_idx[i]);
+
+    EXPECT_CALL(*mock_runtime, allreduce_use_gmock_proxy(
+      // Can't just use Eq(ByRef(use_allred[i])), since address is allowed to change
+      // upon transfer of ownership.
+      IsUseWithFlows(f_fwd_allred[i], f_allred_out[i], Permissions::None, Permissions::Modify),
+      Truly([i](auto const* details) {
+        // Only the last local contribution carries data (for all four pieces)
+        return details->n_combined_contributions() == (i == 3 ? 4 : 0)
+#if _darma_has_feature(task_collection_token)
+          and details->get_task_collection_token().name == "my_token_2"
+#endif // _darma_has_feature(task_collection_token)
+          ;
+      }),
+      _
+    ));
+
+    EXPECT_FLOW_ALIAS(f_allred_out[i], f_out_idx[i]);
+    EXPECT_RELEASE_USE(use_allred_cont[i]);
+
+    created_task->run();
+
+    if(i < 3) {
+      // Held by the combiner until the last local task contributes
+      EXPECT_THAT(mock_runtime->backend_owned_uses.size(), Eq(n_owned_before));
+    }
+
+  }
+
+  // Each task contributed 42, and the three earlier values were folded into
+  // the last one's data before it went to the backend
+  EXPECT_THAT(values[0], Eq(42));
+  EXPECT_THAT(values[1], Eq(42));
+  EXPECT_THAT(values[2], Eq(42));
+  EXPECT_THAT(values[3], Eq(4*42));
+
+  EXPECT_RELEASE_USE(use_coll);
+
+
+  mock_runtime->task_collections.front().reset(nullptr);
+  mock_runtime->backend_owned_uses.clear();
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 TEST_F(TestCreateConcurrentWork, fetch) {
 
   using namespace ::testing;
@@ -810,6 +1195,20 @@ TEST_F(TestCreateConcurrentWork, many_to_one) {
   EXPECT_THAT(abstract::frontend::use_cast<abstract::frontend::CollectionManagingUse*>(*mock_runtime->task_collections.front()->get_dependencies().begin()
     )->get_managed_collection()->task_index_for(3), Eq(1));
 
+  {
+    auto* managed_coll = abstract::frontend::use_cast<abstract::frontend::CollectionManagingUse*>(
+      *mock_runtime->task_collections.front()->get_dependencies().begin()
+    )->get_managed_collection();
+    std::vector<std::pair<std::size_t, std::size_t>> intervals;
+    managed_coll->for_each_local_index_interval(1,
+      [&](std::size_t begin, std::size_t end) {
+        intervals.emplace_back(begin, end);
+      }
+    );
+    EXPECT_THAT(intervals, ElementsAre(Pair(1, 2), Pair(3, 4)));
+    EXPECT_THAT(managed_coll->local_indices_for(1), ElementsAre(1, 3));
+  }
+
   for(int i = 0; i < 2; ++i) {
     values[i] = 0;
     values[i+2] = 0;
@@ -850,6 +1249,126 @@ TEST_F(TestCreateConcurrentWork, many_to_one) {
 
 ////////////////////////////////////////////////////////////////////////////////
 
+TEST_F(TestCreateConcurrentWork, many_to_one_block_mapping) {
+
+  using namespace ::testing;
+  using namespace darma;
+  using namespace darma::keyword_arguments_for_task_creation;
+  using namespace darma::keyword_arguments_for_access_handle_collection;
+  using namespace mock_backend;
+
+  mock_runtime->save_tasks = true;
+
+  DECLARE_MOCK_FLOWS(finit, fnull, fout_coll);
+  MockFlow f_in_idx[6], f_out_idx[6];
+  use_t* use_idx[6];
+  use_t* use_init = nullptr;
+  use_t* use_coll = nullptr, *use_coll_cont = nullptr;
+  int values[6];
+  // 6 handle indices over 4 tasks: the first 6 % 4 tasks get an extra index
+  std::vector<std::vector<int>> const chunks = { {0, 1}, {2, 3}, {4}, {5} };
+
+  EXPECT_INITIAL_ACCESS_COLLECTION(finit, fnull, use_init, make_key("hello"), 6);
+
+  EXPECT_CALL(*mock_runtime, make_next_flow_collection(finit))
+    .WillOnce(Return(fout_coll));
+
+  EXPECT_REGISTER_USE_COLLECTION(use_coll, finit, fout_coll, Modify, Modify, 6);
+  EXPECT_REGISTER_USE_COLLECTION(use_coll_cont, fout_coll, fnull, Modify, None, 6);
+
+  EXPECT_RELEASE_USE(use_init);
+  EXPECT_RELEASE_USE(use_coll_cont);
+  EXPECT_FLOW_ALIAS(fout_coll, fnull);
+
+  //============================================================================
+  // actual code being tested
+  {
+
+    auto tmp_c = initial_access_collection<int>("hello",
+      index_range=Range1D<int>(6)
+    );
+
+    struct Foo {
+      void operator()(Index1D<int> index,
+        AccessHandleCollection<int, Range1D<int>> coll
+      ) const {
+        int const begin = index.value * 2 - std::max(index.value - 2, 0);
+        int const end = begin + (index.value < 2 ? 2 : 1);
+        for(int i = begin; i < end; ++i) {
+          coll[i].local_access().set_value(10 * index.value + i);
+        }
+      }
+    };
+
+    create_concurrent_work<Foo>(
+      tmp_c.mapped_with(BlockMapping<int>(Range1D<int>(6), Range1D<int>(4))),
+      index_range=Range1D<int>(4)
+    );
+
+  }
+  //============================================================================
+
+  Mock::VerifyAndClearExpectations(mock_runtime.get());
+
+  auto* managed_coll = abstract::frontend::use_cast<
+    abstract::frontend::CollectionManagingUse*
+  >(
+    *mock_runtime->task_collections.front()->get_dependencies().begin()
+  )->get_managed_collection();
+
+  for(int task = 0; task < 4; ++task) {
+    for(int i : chunks[task]) {
+      EXPECT_THAT(managed_coll->task_index_for(i), Eq(task));
+    }
+    EXPECT_THAT(managed_coll->local_indices_for(task),
+      ElementsAreArray(chunks[task].begin(), chunks[task].end())
+    );
+  }
+
+  for(int task = 0; task < 4; ++task) {
+
+    // The backend should be asked for exactly the indices in the task's chunk
+    for(int i : chunks[task]) {
+      values[i] = 0;
+      EXPECT_CALL(*mock_runtime, make_indexed_local_flow(finit, i))
+        .WillOnce(Return(f_in_idx[i]));
+      EXPECT_CALL(*mock_runtime, make_indexed_local_flow(fout_coll, i))
+        .WillOnce(Return(f_out_idx[i]));
+      EXPECT_REGISTER_USE_AND_SET_BUFFER(use_idx[i], f_in_idx[i], f_out_idx[i],
+        Modify, Modify, values[i]);
+    }
+
+    auto created_task =
+      mock_runtime->task_collections.front()->create_task_for_index(task);
+
+    for(int i : chunks[task]) {
+      EXPECT_THAT(created_task.get(), UseInGetDependencies(use_idx[i]));
+    }
+
+    created_task->run();
+
+    for(int i : chunks[task]) {
+      EXPECT_RELEASE_USE(use_idx[i]);
+    }
+
+    created_task = nullptr;
+
+    Mock::VerifyAndClearExpectations(mock_runtime.get());
+
+    for(int i : chunks[task]) {
+      EXPECT_THAT(values[i], Eq(10 * task + i));
+    }
+
+  }
+
+  EXPECT_RELEASE_USE(use_coll);
+
+  mock_runtime->task_collections.front().reset(nullptr);
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 TEST_F(TestCreateConcurrentWork, simple_sq_brkt_same) {
 
   using namespace ::testing;
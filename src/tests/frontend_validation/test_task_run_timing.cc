@@ -0,0 +1,183 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                      test_task_run_timing.cc
+//                         DARMA
+//              Copyright (C) 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-NA-0003525 with NTESS, LLC,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact darma@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+*/
+
+// Built with DARMA_MEASURE_TASK_RUN_TIME=1 (see CMakeLists.txt)
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "mock_backend.h"
+#include "test_frontend.h"
+
+#include <darma/interface/app/create_work.h>
+#include <darma/impl/array/index_range.h>
+#include <darma/impl/task_collection/create_concurrent_work.h>
+
+using namespace darma;
+
+////////////////////////////////////////////////////////////////////////////////
+
+class TestTaskRunTiming
+  : public TestFrontend
+{
+  protected:
+
+    virtual void SetUp() {
+      using namespace ::testing;
+
+      setup_mock_runtime<::testing::NiceMock>();
+      TestFrontend::SetUp();
+      ON_CALL(*mock_runtime, get_running_task())
+        .WillByDefault(Return(top_level_task.get()));
+
+      // discard anything left over from other tests
+      std::vector<abstract::frontend::TaskRunTiming> leftover;
+      frontend::collect_task_run_timings(leftover);
+    }
+
+    virtual void TearDown() {
+      TestFrontend::TearDown();
+    }
+
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST_F(TestTaskRunTiming, create_work_cost) {
+  using namespace ::testing;
+  using namespace darma::keyword_arguments_for_create_work;
+  using namespace mock_backend;
+
+  int n_run = 0;
+
+  //============================================================================
+  // Actual code being tested
+  {
+    create_work(name("costly"), cost=2.5, [&n_run]{ ++n_run; });
+    create_work([&n_run]{ ++n_run; });
+  }
+  //============================================================================
+
+  ASSERT_THAT(mock_runtime->registered_tasks.size(), Eq(2));
+  EXPECT_THAT(mock_runtime->registered_tasks[0]->get_cost_estimate(), Eq(2.5));
+  EXPECT_THAT(mock_runtime->registered_tasks[1]->get_cost_estimate(), Eq(0.0));
+
+  std::vector<abstract::frontend::TaskRunTiming> timings;
+  EXPECT_THAT(frontend::collect_task_run_timings(timings), Eq(0));
+
+  run_all_tasks();
+
+  EXPECT_THAT(n_run, Eq(2));
+
+  ASSERT_THAT(frontend::collect_task_run_timings(timings), Eq(2));
+  ASSERT_THAT(timings.size(), Eq(2));
+
+  EXPECT_THAT(timings[0].name, Eq(make_key("costly")));
+  EXPECT_THAT(timings[0].cost_estimate, Eq(2.5));
+  EXPECT_THAT(timings[0].collection_index,
+    Eq(abstract::frontend::TaskRunTiming::not_a_collection_task)
+  );
+  EXPECT_THAT(timings[0].wall_time, Ge(0.0));
+  EXPECT_THAT(timings[1].cost_estimate, Eq(0.0));
+
+  // Already collected
+  EXPECT_THAT(frontend::collect_task_run_timings(timings), Eq(0));
+  EXPECT_THAT(frontend::n_dropped_task_run_timings(), Eq(0));
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST_F(TestTaskRunTiming, collection_index_timings) {
+  using namespace ::testing;
+  using namespace darma::keyword_arguments_for_create_concurrent_work;
+  using namespace mock_backend;
+
+  mock_runtime->save_tasks = true;
+
+  static int n_run = 0;
+  n_run = 0;
+
+  //============================================================================
+  // Actual code being tested
+  {
+    struct Foo {
+      void operator()(ConcurrentContext<Range1D<int>> context) const {
+        ++n_run;
+      }
+    };
+
+    create_concurrent_work<Foo>(
+      index_range=Range1D<int>(3), name("sweep"), cost=4.0
+    );
+  }
+  //============================================================================
+
+  ASSERT_THAT(mock_runtime->task_collections.size(), Eq(1));
+  auto& coll = mock_runtime->task_collections.front();
+  EXPECT_THAT(coll->get_cost_estimate(), Eq(4.0));
+
+  for(int i = 2; i >= 0; --i) {
+    auto task = coll->create_task_for_index(i);
+    EXPECT_THAT(task->get_cost_estimate(), Eq(4.0));
+    task->run();
+  }
+
+  EXPECT_THAT(n_run, Eq(3));
+
+  std::vector<abstract::frontend::TaskRunTiming> timings;
+  ASSERT_THAT(frontend::collect_task_run_timings(timings), Eq(3));
+
+  for(int i = 0; i < 3; ++i) {
+    // recorded in the order the tasks ran
+    EXPECT_THAT(timings[i].collection_index, Eq(static_cast<std::size_t>(2 - i)));
+    EXPECT_THAT(timings[i].name, Eq(make_key("sweep")));
+    EXPECT_THAT(timings[i].cost_estimate, Eq(4.0));
+  }
+
+  mock_runtime->task_collections.front().reset(nullptr);
+  mock_runtime->task_collections.pop_front();
+
+}